@@ -275,6 +275,13 @@ struct xcptcontext
 #ifdef CONFIG_ARCH_FPU
   uint64_t *fpu_regs;
   uint64_t *saved_fpu_regs;
+#  ifdef CONFIG_ARM64_LAZY_FPU
+  /* The FPU context of the thread, only written when the registers are
+   * taken by another thread.  fpu_regs points here.
+   */
+
+  uint64_t fpu_area[FPU_CONTEXT_REGS];
+#  endif
 #endif
 
   /* Extra fault address register saved for common paging logic.  In the
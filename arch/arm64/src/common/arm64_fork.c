@@ -181,7 +181,9 @@ pid_t arm64_fork(const struct fork_s *context)
   /* make the fork stack frame */
 
 #ifdef CONFIG_ARCH_FPU
+#  ifndef CONFIG_ARM64_LAZY_FPU
   child->cmn.xcp.fpu_regs = (void *)(newsp - FPU_CONTEXT_SIZE);
+#  endif
   memcpy(child->cmn.xcp.fpu_regs, context->fpu, FPU_CONTEXT_SIZE);
 #endif
 
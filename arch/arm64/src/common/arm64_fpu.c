@@ -78,9 +78,11 @@ struct arm64_fpu_procfs_file_s
  * Private Data
  ***************************************************************************/
 
-#ifdef CONFIG_FS_PROCFS_REGISTER
-
+#if defined(CONFIG_FS_PROCFS_REGISTER) || defined(CONFIG_ARM64_LAZY_FPU)
 static struct arm64_cpu_fpu_context g_cpu_fpu_ctx[CONFIG_SMP_NCPUS];
+#endif
+
+#ifdef CONFIG_FS_PROCFS_REGISTER
 
 /* procfs methods */
 
@@ -130,6 +132,11 @@ static void arm64_fpu_access_trap_enable(void)
   uint64_t cpacr;
 
   cpacr = read_sysreg(cpacr_el1);
+  if ((cpacr & CPACR_EL1_FPEN_NOTRAP) == 0)
+    {
+      return;
+    }
+
   cpacr &= ~CPACR_EL1_FPEN_NOTRAP;
   write_sysreg(cpacr, cpacr_el1);
 
@@ -143,12 +150,35 @@ static void arm64_fpu_access_trap_disable(void)
   uint64_t cpacr;
 
   cpacr = read_sysreg(cpacr_el1);
+  if ((cpacr & CPACR_EL1_FPEN_NOTRAP) == CPACR_EL1_FPEN_NOTRAP)
+    {
+      return;
+    }
+
   cpacr |= CPACR_EL1_FPEN_NOTRAP;
   write_sysreg(cpacr, cpacr_el1);
 
   UP_ISB();
 }
 
+#ifdef CONFIG_ARM64_LAZY_FPU
+
+/* The FPU is accessed by an exception handler rather than by a thread:  an
+ * interrupt or fatal handler, or code on the interrupt stack (the context
+ * switch syscalls).  The user syscalls run on the thread stack, as the
+ * thread.
+ */
+
+static bool arm64_fpu_in_handler(uint64_t *regs)
+{
+  uintptr_t base = up_get_intstackbase(this_cpu());
+
+  return up_interrupt_context() ||
+         ((uintptr_t)regs >= base &&
+          (uintptr_t)regs < base + INTSTACK_SIZE);
+}
+#endif
+
 #ifdef CONFIG_FS_PROCFS_REGISTER
 
 static int arm64_fpu_procfs_open(struct file *filep, const char *relpath,
@@ -278,6 +308,186 @@ void arm64_fpu_disable(void)
   up_irq_restore(flags);
 }
 
+#ifdef CONFIG_ARM64_LAZY_FPU
+
+/* The lazy FPU hooks below run with the FPU access trap enabled and must
+ * not use the FPU registers themselves.
+ */
+
+/***************************************************************************
+ * Name: arm64_init_fpu
+ *
+ * Description:
+ *   Set up the FPU save area of a new thread.  A TCB that is reused must
+ *   not be left as the owner of the registers of some CPU.
+ *
+ ***************************************************************************/
+
+void arm64_init_fpu(struct tcb_s *tcb)
+{
+  arm64_destory_fpu(tcb);
+  tcb->xcp.fpu_regs = tcb->xcp.fpu_area;
+}
+
+/***************************************************************************
+ * Name: arm64_destory_fpu
+ *
+ * Description:
+ *   Discard the FPU registers that a thread has live on any CPU, when the
+ *   thread exits or when its save area has been written directly.
+ *
+ ***************************************************************************/
+
+void arm64_destory_fpu(struct tcb_s *tcb)
+{
+  irqstate_t flags = up_irq_save();
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (g_cpu_fpu_ctx[i].fpu_owner == tcb)
+        {
+          g_cpu_fpu_ctx[i].fpu_owner = NULL;
+        }
+    }
+
+  up_irq_restore(flags);
+}
+
+/***************************************************************************
+ * Name: arm64_fpu_flush
+ *
+ * Description:
+ *   Write the FPU registers of the running thread back to its save area if
+ *   they are live.  The thread keeps the FPU.
+ *
+ ***************************************************************************/
+
+void arm64_fpu_flush(struct tcb_s *tcb)
+{
+  irqstate_t flags = up_irq_save();
+  struct arm64_cpu_fpu_context *ctx = &g_cpu_fpu_ctx[this_cpu()];
+
+  if (ctx->fpu_owner == tcb)
+    {
+      arm64_fpu_save(tcb->xcp.fpu_regs);
+      ctx->save_count++;
+    }
+
+  up_irq_restore(flags);
+}
+
+/***************************************************************************
+ * Name: arm64_fpu_enter_exception
+ *
+ * Description:
+ *   Called on every exception entry.  If the registers of the interrupted
+ *   thread are live, trap any FPU access of the handler, which would
+ *   corrupt them.  This file is built with -mgeneral-regs-only, so the
+ *   hooks themselves never touch the FP/SIMD registers.
+ *
+ ***************************************************************************/
+
+void arm64_fpu_enter_exception(void)
+{
+  struct tcb_s *owner = g_cpu_fpu_ctx[this_cpu()].fpu_owner;
+
+  if (owner != NULL && owner == running_task())
+    {
+      arm64_fpu_access_trap_enable();
+    }
+}
+
+/***************************************************************************
+ * Name: arm64_fpu_exit_exception
+ *
+ * Description:
+ *   Called when returning to a thread:  the FPU is accessible only if the
+ *   thread owns its registers.
+ *
+ ***************************************************************************/
+
+void arm64_fpu_exit_exception(void)
+{
+  struct arm64_cpu_fpu_context *ctx = &g_cpu_fpu_ctx[this_cpu()];
+  struct tcb_s *tcb = running_task();
+
+#ifdef CONFIG_SMP
+  /* The previous owner may resume on another CPU, save its registers now.
+   * Only the restore is deferred to the first FPU access.
+   */
+
+  if (ctx->fpu_owner != NULL && ctx->fpu_owner != tcb)
+    {
+      arm64_fpu_access_trap_disable();
+      arm64_fpu_save(ctx->fpu_owner->xcp.fpu_regs);
+      ctx->fpu_owner = NULL;
+      ctx->save_count++;
+    }
+#endif
+
+  if (ctx->fpu_owner != NULL && ctx->fpu_owner == tcb)
+    {
+      arm64_fpu_access_trap_disable();
+    }
+  else
+    {
+      arm64_fpu_access_trap_enable();
+    }
+}
+
+/***************************************************************************
+ * Name: arm64_fpu_trap
+ *
+ * Description:
+ *   FP/SIMD access trap.  The registers of the owner are saved, then a
+ *   thread gets its own registers back, while an exception handler gets
+ *   scratch registers until it returns.
+ *
+ * Input Parameters:
+ *   regs - The context of the trapped instruction
+ *
+ ***************************************************************************/
+
+void arm64_fpu_trap(uint64_t *regs)
+{
+  struct arm64_cpu_fpu_context *ctx = &g_cpu_fpu_ctx[this_cpu()];
+  struct tcb_s *owner = ctx->fpu_owner;
+  struct tcb_s *tcb = NULL;
+
+  arm64_fpu_access_trap_disable();
+
+  if (arm64_fpu_in_handler(regs))
+    {
+      ctx->exe_depth_count++;
+    }
+  else
+    {
+      tcb = running_task();
+    }
+
+  if (owner == tcb)
+    {
+      return;
+    }
+
+  if (owner != NULL)
+    {
+      arm64_fpu_save(owner->xcp.fpu_regs);
+      ctx->save_count++;
+    }
+
+  if (tcb != NULL)
+    {
+      arm64_fpu_restore(tcb->xcp.fpu_regs);
+      ctx->restore_count++;
+    }
+
+  ctx->fpu_owner = tcb;
+  ctx->switch_count++;
+}
+#endif /* CONFIG_ARM64_LAZY_FPU */
+
 /***************************************************************************
  * Name: up_fpucmp
  *
@@ -63,6 +63,13 @@ struct arm64_cpu_fpu_context
 void arm64_init_fpu(struct tcb_s *tcb);
 void arm64_destory_fpu(struct tcb_s *tcb);
 
+#ifdef CONFIG_ARM64_LAZY_FPU
+void arm64_fpu_flush(struct tcb_s *tcb);
+void arm64_fpu_enter_exception(void);
+void arm64_fpu_exit_exception(void);
+void arm64_fpu_trap(uint64_t *regs);
+#endif
+
 #ifdef CONFIG_FS_PROCFS_REGISTER
 int  arm64_fpu_procfs_register(void);
 #endif
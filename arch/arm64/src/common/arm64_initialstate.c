@@ -47,6 +47,10 @@
 #include "chip.h"
 #include "arm64_fatal.h"
 
+#ifdef CONFIG_ARM64_LAZY_FPU
+#include "arm64_fpu.h"
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -128,6 +132,10 @@ void up_initial_state(struct tcb_s *tcb)
   xcp->kstack = kstack;
 #endif
 
+#ifdef CONFIG_ARM64_LAZY_FPU
+  arm64_init_fpu(tcb);
+#endif
+
   if (tcb->pid == IDLE_PROCESS_ID)
     {
       /* Initialize the idle thread stack */
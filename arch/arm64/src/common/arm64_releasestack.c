@@ -36,6 +36,10 @@
 #include "arm64_internal.h"
 #include "arm64_fatal.h"
 
+#ifdef CONFIG_ARM64_LAZY_FPU
+#include "arm64_fpu.h"
+#endif
+
 /****************************************************************************
  * Pre-processor Macros
  ****************************************************************************/
@@ -85,6 +89,12 @@
 
 void up_release_stack(struct tcb_s *dtcb, uint8_t ttype)
 {
+#ifdef CONFIG_ARM64_LAZY_FPU
+  /* The TCB is going away, it must not stay the owner of the FPU */
+
+  arm64_destory_fpu(dtcb);
+#endif
+
   /* Is there a stack allocated? */
 
   if (dtcb->stack_alloc_ptr && (dtcb->flags & TCB_FLAG_FREE_STACK))
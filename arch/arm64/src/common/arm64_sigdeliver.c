@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <string.h>
 #include <sched.h>
 #include <assert.h>
 #include <debug.h>
@@ -38,6 +39,10 @@
 #include "irq/irq.h"
 #include "arm64_fatal.h"
 
+#ifdef CONFIG_ARM64_LAZY_FPU
+#include "arm64_fpu.h"
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -55,6 +60,9 @@
 void arm64_sigdeliver(void)
 {
   struct tcb_s *rtcb = this_task();
+#ifdef CONFIG_ARM64_LAZY_FPU
+  uint64_t fpu_regs[FPU_CONTEXT_REGS];
+#endif
 
 #ifdef CONFIG_SMP
   /* In the SMP case, we must terminate the critical section while the signal
@@ -71,6 +79,15 @@ void arm64_sigdeliver(void)
         rtcb, rtcb->sigdeliver, rtcb->sigpendactionq.head);
   DEBUGASSERT(rtcb->sigdeliver != NULL);
 
+#ifdef CONFIG_ARM64_LAZY_FPU
+  /* The FPU registers of the interrupted context are not in the saved
+   * exception frame, keep them aside while the signal handler runs.
+   */
+
+  arm64_fpu_flush(rtcb);
+  memcpy(fpu_regs, rtcb->xcp.fpu_regs, FPU_CONTEXT_SIZE);
+#endif
+
 retry:
 #ifdef CONFIG_SMP
   /* In the SMP case, up_schedule_sigaction(0) will have incremented
@@ -151,6 +168,15 @@ retry:
   rtcb->sigdeliver = NULL;  /* Allows next handler to be scheduled */
   rtcb->xcp.regs = rtcb->xcp.saved_reg;
 
+#ifdef CONFIG_ARM64_LAZY_FPU
+  /* Put back the FPU registers of the interrupted context and drop those
+   * of the signal handler, the next FPU access reloads them.
+   */
+
+  memcpy(rtcb->xcp.fpu_regs, fpu_regs, FPU_CONTEXT_SIZE);
+  arm64_destory_fpu(rtcb);
+#endif
+
   /* Then restore the correct state for this thread of execution. */
 
 #ifdef CONFIG_SMP
@@ -183,6 +183,7 @@
 #define X86_64_CPUID_VENDOR           0x00
 #define X86_64_CPUID_CAP              0x01
 #  define X86_64_CPUID_01_SSE3        (1 << 0)
+#  define X86_64_CPUID_01_PCLMUL      (1 << 1)
 #  define X86_64_CPUID_01_SSSE3       (1 << 9)
 #  define X86_64_CPUID_01_FMA         (1 << 12)
 #  define X86_64_CPUID_01_PCID        (1 << 17)
@@ -66,6 +66,12 @@ void x86_64_check_and_enable_capability(void)
   require |= X86_64_CPUID_01_SSE3;
 #endif
 
+  /* Check carry-less multiplication (PCLMULQDQ) availability */
+
+#ifdef CONFIG_ARCH_X86_64_PCLMUL
+  require |= X86_64_CPUID_01_PCLMUL;
+#endif
+
   /* Check Suplement SSE3 instructions availability */
 
 #ifdef CONFIG_ARCH_X86_64_SSEE3
@@ -58,6 +58,7 @@
 #include <nuttx/drivers/optee.h>
 
 #ifdef CONFIG_SCHED_PERF_EVENTS
+#  include <nuttx/perf.h>
 #  include <perf/pmu.h>
 #endif
 #ifdef CONFIG_DRIVERS_BINDER
@@ -207,7 +208,12 @@ void drivers_initialize(void)
 #endif
 
 #ifdef CONFIG_SCHED_PERF_EVENTS
+  /* Register the software events, then the hardware PMU if there is one */
+
+  perf_event_init();
+#  if defined(CONFIG_ARCH_ARM) || defined(CONFIG_ARCH_ARM64)
   pmu_initialize();
+#  endif
 #endif
 
 #if defined(CONFIG_CRYPTO)
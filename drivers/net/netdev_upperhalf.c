@@ -36,6 +36,7 @@
 #include <nuttx/kthread.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/can.h>
+#include <nuttx/net/ethernet.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev_lowerhalf.h>
 #include <nuttx/net/pkt.h>
@@ -66,6 +67,17 @@
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_NETDEV_RPS
+/* The packets steered to the work thread of a CPU */
+
+struct netdev_rps_backlog_s
+{
+  FAR netpkt_t *pkts[CONFIG_NETDEV_RPS_BACKLOG];
+  uint16_t      head;  /* Index of the oldest packet */
+  uint16_t      count; /* Number of the packets in the backlog */
+};
+#endif
+
 /* This structure describes the state of the upper half driver */
 
 struct netdev_upperhalf_s
@@ -82,6 +94,16 @@ struct netdev_upperhalf_s
   struct work_s work;
 #endif
 
+  /* Receive packet steering, protected by the network lock */
+
+#ifdef CONFIG_NETDEV_RPS
+  struct netdev_rps_backlog_s backlog[NETDEV_THREAD_COUNT];
+
+  /* CPU + 1 that consumes the flows of a hash, 0 if not known */
+
+  uint8_t flow[CONFIG_NETDEV_RPS_FLOW_ENTRIES];
+#endif
+
   /* TX queue for re-queueing replies */
 
 #if CONFIG_IOB_NCHAINS > 0
@@ -584,80 +606,376 @@ static void ip_input(FAR struct net_driver_s *dev)
 #endif
 
 /****************************************************************************
- * Function: netdev_upper_rxpoll_work
+ * Name: netdev_upper_notify
  *
  * Description:
- *   Try to receive packets from device and pass packets into IP
- *   stack and send packets which is from IP stack if necessary.
+ *   Wake up the work thread of a CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_WORK_THREAD
+static void netdev_upper_notify(FAR struct netdev_upperhalf_s *upper,
+                                int cpu)
+{
+  int semcount;
+
+  if (nxsem_get_value(&upper->sem[cpu], &semcount) == OK &&
+      semcount <= 0)
+    {
+      nxsem_post(&upper->sem[cpu]);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Function: netdev_upper_input
+ *
+ * Description:
+ *   Pass a received packet into the network stack.
  *
  * Input Parameters:
  *   upper - Reference to the upper half driver structure
+ *   pkt   - The received packet
  *
  * Assumptions:
  *   Called with the network locked.
  *
  ****************************************************************************/
 
-static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
+static void netdev_upper_input(FAR struct netdev_upperhalf_s *upper,
+                               FAR netpkt_t *pkt)
 {
   FAR struct netdev_lowerhalf_s *lower = upper->lower;
   FAR struct net_driver_s       *dev   = &lower->netdev;
-  FAR netpkt_t                  *pkt;
-
-  /* Loop while receive() successfully retrieves valid Ethernet frames. */
 
-  while ((pkt = lower->ops->receive(lower)) != NULL)
+  if (!IFF_IS_UP(dev->d_flags))
     {
-      if (!IFF_IS_UP(dev->d_flags))
-        {
-          /* Interface down, drop frame */
+      /* Interface down, drop frame */
 
-          NETDEV_RXDROPPED(dev);
-          netpkt_free(lower, pkt, NETPKT_RX);
-          continue;
-        }
+      NETDEV_RXDROPPED(dev);
+      netpkt_free(lower, pkt, NETPKT_RX);
+      return;
+    }
 
-      netpkt_put(dev, pkt, NETPKT_RX);
-      NETDEV_RXPACKETS(dev);
+  netpkt_put(dev, pkt, NETPKT_RX);
+  NETDEV_RXPACKETS(dev);
 
 #ifdef CONFIG_NET_PKT
-      /* When packet sockets are enabled, feed the frame into the tap */
+  /* When packet sockets are enabled, feed the frame into the tap */
 
-      pkt_input(dev);
+  pkt_input(dev);
 #endif
 
-      switch (dev->d_lltype)
-        {
+  switch (dev->d_lltype)
+    {
 #ifdef CONFIG_NET_LOOPBACK
-        case NET_LL_LOOPBACK:
+    case NET_LL_LOOPBACK:
 #endif
 #ifdef CONFIG_NET_ETHERNET
-        case NET_LL_ETHERNET:
+    case NET_LL_ETHERNET:
 #endif
 #ifdef CONFIG_DRIVERS_IEEE80211
-        case NET_LL_IEEE80211:
+    case NET_LL_IEEE80211:
 #endif
 #if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
     defined(CONFIG_DRIVERS_IEEE80211)
-          eth_input(dev);
-          break;
+      eth_input(dev);
+      break;
 #endif
 #ifdef CONFIG_NET_MBIM
-        case NET_LL_MBIM:
-          ip_input(dev);
-          break;
+    case NET_LL_MBIM:
+      ip_input(dev);
+      break;
 #endif
 #ifdef CONFIG_NET_CAN
-        case NET_LL_CAN:
-          ninfo("CAN frame");
-          can_input(dev);
-          break;
+    case NET_LL_CAN:
+      ninfo("CAN frame");
+      can_input(dev);
+      break;
 #endif
-        default:
-          nerr("Unknown link type %d\n", dev->d_lltype);
-          break;
+    default:
+      nerr("Unknown link type %d\n", dev->d_lltype);
+      break;
+    }
+}
+
+/****************************************************************************
+ * Function: netdev_upper_rps_hash
+ *
+ * Description:
+ *   Calculate the flow hash of a received packet, the same one that
+ *   netdev_notify_recvcpu() calculates for the socket of the flow.
+ *
+ * Input Parameters:
+ *   dev    - Reference to the NuttX driver state structure
+ *   pkt    - The received packet
+ *   domain - The location to return the domain of an IP packet
+ *   lport  - The location to return the local port of a TCP/UDP packet,
+ *            zero if it has none
+ *
+ * Returned Value:
+ *   The flow hash.  The Ethernet frames that are not IP hash their MAC
+ *   addresses, the other packets that are not IP hash to zero.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RPS
+static uint32_t netdev_upper_rps_hash(FAR struct net_driver_s *dev,
+                                      FAR netpkt_t *pkt,
+                                      FAR uint8_t *domain,
+                                      FAR uint16_t *lport)
+{
+  FAR const uint8_t *ip = IOB_DATA(pkt);
+  unsigned int len = pkt->io_len;
+  unsigned int hdrlen;
+  uint32_t laddr[4];
+  uint32_t raddr[4];
+  uint16_t rport = 0;
+  uint8_t proto;
+
+  *lport = 0;
+
+  /* The packets that have no flow are all kept in order on the same CPU */
+
+#ifdef CONFIG_NET_CAN
+  if (dev->d_lltype == NET_LL_CAN)
+    {
+      return 0;
+    }
+#endif
+
+  if (NET_LL_HDRLEN(dev) == ETH_HDRLEN)
+    {
+      uint16_t type;
+
+      memcpy(&type, ip - sizeof(type), sizeof(type));
+      if (type != HTONS(ETHTYPE_IP) && type != HTONS(ETHTYPE_IP6))
+        {
+          FAR const uint8_t *mac = ip - ETH_HDRLEN;
+          uint32_t hash = 2166136261u;
+          int i;
+
+          /* Spread the other protocols (ARP...) by the pairs of stations
+           * with FNV-1a over the destination and source MAC addresses.
+           */
+
+          for (i = 0; i < 2 * ETHER_ADDR_LEN; i++)
+            {
+              hash = (hash ^ mac[i]) * 16777619u;
+            }
+
+          return hash;
+        }
+    }
+
+#ifdef CONFIG_NET_IPv4
+  if (len >= IPv4_HDRLEN && (ip[0] >> 4) == 4)
+    {
+      FAR const struct ipv4_hdr_s *ipv4 = (FAR const void *)ip;
+
+      *domain = PF_INET;
+      proto   = ipv4->proto;
+      hdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
+      memcpy(raddr, ipv4->srcipaddr, sizeof(in_addr_t));
+      memcpy(laddr, ipv4->destipaddr, sizeof(in_addr_t));
+
+      /* Only the first fragment has the ports */
+
+      if ((ipv4->ipoffset[0] & 0x3f) != 0 || ipv4->ipoffset[1] != 0)
+        {
+          proto = 0;
         }
     }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if (len >= IPv6_HDRLEN && (ip[0] >> 4) == 6)
+    {
+      FAR const struct ipv6_hdr_s *ipv6 = (FAR const void *)ip;
+
+      *domain = PF_INET6;
+      proto   = ipv6->proto;
+      hdrlen = IPv6_HDRLEN;
+      memcpy(raddr, ipv6->srcipaddr, sizeof(net_ipv6addr_t));
+      memcpy(laddr, ipv6->destipaddr, sizeof(net_ipv6addr_t));
+    }
+  else
+#endif
+    {
+      return 0;
+    }
+
+  if ((proto == IP_PROTO_TCP || proto == IP_PROTO_UDP) &&
+      len >= hdrlen + 2 * sizeof(uint16_t))
+    {
+      memcpy(&rport, ip + hdrlen, sizeof(uint16_t));
+      memcpy(lport, ip + hdrlen + sizeof(uint16_t), sizeof(uint16_t));
+    }
+
+  return netdev_rss_hash(*domain, laddr, *lport, raddr, rport);
+}
+
+/****************************************************************************
+ * Function: netdev_upper_rps_steer
+ *
+ * Description:
+ *   Queue a received packet to the backlog of the CPU that processes its
+ *   flow: the CPU the socket of the flow, or else the socket bound to any
+ *   address on its local port, receives on if it is known (RFS), a CPU
+ *   selected by the flow hash otherwise (RPS).
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   pkt   - The received packet
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_rps_steer(FAR struct netdev_upperhalf_s *upper,
+                                   FAR netpkt_t *pkt)
+{
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+  FAR struct net_driver_s       *dev   = &lower->netdev;
+  FAR struct netdev_rps_backlog_s *backlog;
+  uint16_t lport;
+  uint32_t hash;
+  uint8_t domain;
+  int cpu;
+
+  hash = netdev_upper_rps_hash(dev, pkt, &domain, &lport);
+  cpu  = upper->flow[hash % CONFIG_NETDEV_RPS_FLOW_ENTRIES] - 1;
+  if (cpu < 0 && lport != 0)
+    {
+      cpu = upper->flow[netdev_rss_porthash(domain, lport) %
+                        CONFIG_NETDEV_RPS_FLOW_ENTRIES] - 1;
+    }
+
+  if (cpu >= 0 && cpu < NETDEV_THREAD_COUNT)
+    {
+      NETDEV_RPS_FLOW(dev, cpu);
+    }
+  else
+    {
+      cpu = hash % NETDEV_THREAD_COUNT;
+    }
+
+  backlog = &upper->backlog[cpu];
+  if (backlog->count >= CONFIG_NETDEV_RPS_BACKLOG)
+    {
+      NETDEV_RPS_DROPPED(dev, cpu);
+      NETDEV_RXDROPPED(dev);
+      netpkt_free(lower, pkt, NETPKT_RX);
+      return;
+    }
+
+  backlog->pkts[(backlog->head + backlog->count) %
+                CONFIG_NETDEV_RPS_BACKLOG] = pkt;
+  backlog->count++;
+  NETDEV_RPS_QUEUED(dev, cpu);
+
+  if (cpu != this_cpu())
+    {
+      netdev_upper_notify(upper, cpu);
+    }
+}
+
+/****************************************************************************
+ * Function: netdev_upper_rps_input
+ *
+ * Description:
+ *   Pass the packets steered to a CPU into the network stack.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   cpu   - The CPU of the calling work thread
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_rps_input(FAR struct netdev_upperhalf_s *upper,
+                                   int cpu)
+{
+  FAR struct netdev_rps_backlog_s *backlog = &upper->backlog[cpu];
+  FAR netpkt_t *pkt;
+
+  while (backlog->count > 0)
+    {
+      pkt = backlog->pkts[backlog->head];
+      backlog->head = (backlog->head + 1) % CONFIG_NETDEV_RPS_BACKLOG;
+      backlog->count--;
+
+      NETDEV_RPS_PROCESSED(&upper->lower->netdev, cpu);
+      netdev_upper_input(upper, pkt);
+    }
+}
+
+/****************************************************************************
+ * Function: netdev_upper_rps_flush
+ *
+ * Description:
+ *   Free the packets left in the backlogs.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_rps_flush(FAR struct netdev_upperhalf_s *upper)
+{
+  FAR struct netdev_rps_backlog_s *backlog;
+  int cpu;
+
+  for (cpu = 0; cpu < NETDEV_THREAD_COUNT; cpu++)
+    {
+      backlog = &upper->backlog[cpu];
+      while (backlog->count > 0)
+        {
+          netpkt_free(upper->lower, backlog->pkts[backlog->head],
+                      NETPKT_RX);
+          backlog->head = (backlog->head + 1) % CONFIG_NETDEV_RPS_BACKLOG;
+          backlog->count--;
+        }
+    }
+}
+#endif /* CONFIG_NETDEV_RPS */
+
+/****************************************************************************
+ * Function: netdev_upper_rxpoll_work
+ *
+ * Description:
+ *   Try to receive packets from device and pass packets into IP
+ *   stack and send packets which is from IP stack if necessary.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
+{
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+  FAR netpkt_t                  *pkt;
+
+  /* Loop while receive() successfully retrieves valid Ethernet frames. */
+
+  while ((pkt = lower->ops->receive(lower)) != NULL)
+    {
+#ifdef CONFIG_NETDEV_RPS
+      netdev_upper_rps_steer(upper, pkt);
+#else
+      netdev_upper_input(upper, pkt);
+#endif
+    }
+
+#ifdef CONFIG_NETDEV_RPS
+  /* The thread is bound to its CPU, process what was steered to it */
+
+  netdev_upper_rps_input(upper, this_cpu());
+#endif
 }
 
 /****************************************************************************
@@ -755,17 +1073,10 @@ static inline void netdev_upper_queue_work(FAR struct net_driver_s *dev)
 
 #ifdef CONFIG_NETDEV_WORK_THREAD
 #  ifdef CONFIG_NETDEV_RSS
-  int cpu = this_cpu();
+  netdev_upper_notify(upper, this_cpu());
 #  else
-  const int cpu = 0;
+  netdev_upper_notify(upper, 0);
 #  endif
-  int semcount;
-
-  if (nxsem_get_value(&upper->sem[cpu], &semcount) == OK &&
-      semcount <= 0)
-    {
-      nxsem_post(&upper->sem[cpu]);
-    }
 #else
   if (work_available(&upper->work))
     {
@@ -1145,6 +1456,30 @@ static int netdev_upper_ioctl(FAR struct net_driver_s *dev, int cmd,
   FAR struct netdev_upperhalf_s *upper = dev->d_private;
   FAR struct netdev_lowerhalf_s *lower = upper->lower;
 
+#ifdef CONFIG_NETDEV_RPS
+  if (cmd == SIOCNOTIFYRECVCPU)
+    {
+      FAR struct netdev_rss_s *rss =
+        (FAR struct netdev_rss_s *)((uintptr_t)arg);
+
+      /* Steer the flow to the CPU that receives it (RFS), then let the
+       * hardware know too if it supports RSS.
+       */
+
+      upper->flow[rss->hash % CONFIG_NETDEV_RPS_FLOW_ENTRIES] = rss->cpu + 1;
+      if (lower->ops->ioctl)
+        {
+          int ret = lower->ops->ioctl(lower, cmd, arg);
+          if (ret != -ENOTTY)
+            {
+              return ret;
+            }
+        }
+
+      return OK;
+    }
+#endif
+
 #ifdef CONFIG_NETDEV_WIRELESS_HANDLER
   if (lower->iw_ops)
     {
@@ -1288,6 +1623,10 @@ int netdev_lower_unregister(FAR struct netdev_lowerhalf_s *dev)
     }
 #endif
 
+#ifdef CONFIG_NETDEV_RPS
+  netdev_upper_rps_flush(upper);
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
   iob_free_queue(&upper->txq);
 #endif
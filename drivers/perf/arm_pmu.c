@@ -181,6 +181,7 @@ static int armpmu_start(FAR struct perf_event_s *event, int flags)
   FAR struct hw_perf_event_s *hwc = &event->hw;
 
   hwc->state = 0;
+  armpmu_event_set_period(event);
   armpmu->enable(event);
 
   return 0;
@@ -393,13 +394,37 @@ uint64_t armpmu_event_update(FAR struct perf_event_s *event)
 
   new_raw_count = armpmu->read_counter(event);
 
-  delta = (new_raw_count) & max_period;
+  delta = (new_raw_count - event->hw.prev_count) & max_period;
+  event->hw.prev_count = new_raw_count;
 
   atomic_fetch_add(&event->count, delta);
 
   return new_raw_count;
 }
 
+void armpmu_event_set_period(FAR struct perf_event_s *event)
+{
+  FAR struct arm_pmu_s *armpmu = to_arm_pmu(event->pmu);
+  uint64_t max_period = armpmu_event_max_period(event);
+  uint64_t period = 0;
+
+  /* A sampling event overflows after sample_period events, a counting
+   * event only when the counter wraps.
+   */
+
+  if (!event->attr.freq && event->attr.sample_period != 0)
+    {
+      period = event->attr.sample_period;
+      if (period > max_period)
+        {
+          period = max_period;
+        }
+    }
+
+  event->hw.prev_count = (0 - period) & max_period;
+  armpmu->write_counter(event, event->hw.prev_count);
+}
+
 int armpmu_driver_init(FAR void *fn)
 {
   FAR armpmu_init_fn init_fn = (armpmu_init_fn)fn;
@@ -369,9 +369,10 @@ static int pmuv3_handle_irq(FAR struct arm_pmu_s *cpu_pmu)
           continue;
         }
 
-      /* Update data */
+      /* Update data and reload the sampling period */
 
       armpmu_event_update(event);
+      armpmu_event_set_period(event);
 
       if (perf_event_overflow(event))
         {
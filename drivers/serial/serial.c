@@ -1358,9 +1358,9 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
         }
 #endif
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave(&dev->lock);
       ret = uart_irqwrite(dev, buffer, buflen);
-      leave_critical_section(flags);
+      spin_unlock_irqrestore(&dev->lock, flags);
 
       return ret;
     }
@@ -2040,6 +2040,7 @@ int uart_register(FAR const char *path, FAR uart_dev_t *dev)
   nxmutex_init(&dev->xmit.lock);
   nxmutex_init(&dev->recv.lock);
   nxmutex_init(&dev->closelock);
+  spin_lock_init(&dev->lock);
   nxsem_init(&dev->xmitsem, 0, 0);
   nxsem_init(&dev->recvsem, 0, 0);
 
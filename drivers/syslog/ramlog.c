@@ -100,6 +100,15 @@ struct ramlog_dev_s
 
   uint32_t                   rl_bufsize; /* Size of the Circular RAM buffer */
   struct list_node           rl_list;    /* The head of ramlog_user_s list */
+
+  /* rl_lock protects the circular buffer and the read/write indexes.  The
+   * list of readers is still protected by the critical section, which is
+   * only taken to notify them, so that logging with no reader does not
+   * take the global lock.  The critical section is never entered while
+   * holding rl_lock.
+   */
+
+  spinlock_t                 rl_lock;
 };
 
 /****************************************************************************
@@ -164,7 +173,8 @@ static struct ramlog_dev_s g_sysdev =
 {
   (FAR struct ramlog_header_s *)g_sysbuffer,            /* rl_buffer */
   sizeof(g_sysbuffer) - sizeof(struct ramlog_header_s), /* rl_bufsize */
-  LIST_INITIAL_VALUE(g_sysdev.rl_list)                  /* rl_list */
+  LIST_INITIAL_VALUE(g_sysdev.rl_list),                 /* rl_list */
+  SP_UNLOCKED                                           /* rl_lock */
 };
 
 #endif
@@ -201,8 +211,12 @@ static void ramlog_readnotify(FAR struct ramlog_dev_s *priv)
         {
           int semcount = 0;
 
+          /* Leave one count if nobody waits:  the reader may be about to
+           * wait, it has released rl_lock but not called nxsem_wait() yet.
+           */
+
           nxsem_get_value(&upriv->rl_waitsem, &semcount);
-          if (semcount >= 0)
+          if (semcount > 0)
             {
               break;
             }
@@ -243,12 +257,24 @@ static void ramlog_pollnotify(FAR struct ramlog_dev_s *priv)
 static void ramlog_bufferflush(FAR struct ramlog_dev_s *priv)
 {
   FAR struct ramlog_user_s *upriv;
+  irqstate_t flags;
+  irqstate_t lock;
+
+  /* rl_list is changed by open and close within a critical section, the
+   * indexes under rl_lock.
+   */
+
+  flags = enter_critical_section();
+  lock  = spin_lock_irqsave_wo_note(&priv->rl_lock);
 
   priv->rl_header->rl_head = 0;
   list_for_every_entry(&priv->rl_list, upriv, struct ramlog_user_s, rl_node)
     {
       upriv->rl_tail = 0;
     }
+
+  spin_unlock_irqrestore_wo_note(&priv->rl_lock, lock);
+  leave_critical_section(flags);
 }
 
 /****************************************************************************
@@ -297,9 +323,11 @@ static ssize_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
   size_t buflen = len;
   irqstate_t flags;
 
-  /* Disable interrupts (in case we are NOT called from interrupt handler) */
+  /* Disable interrupts (in case we are NOT called from interrupt handler).
+   * No trace note:  the note drivers may log to the RAMLOG.
+   */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_wo_note(&priv->rl_lock);
 
 #ifdef CONFIG_RAMLOG_SYSLOG
   if (header->rl_magic != RAMLOG_MAGIC_NUMBER && priv == &g_sysdev)
@@ -316,11 +344,14 @@ static ssize_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
     }
 
   ramlog_copybuf(priv, buffer, buflen);
+  spin_unlock_irqrestore_wo_note(&priv->rl_lock, flags);
 
-  /* Was anything written? */
+  /* Was anything written?  Is there anybody to notify? */
 
-  if (len > 0)
+  if (len > 0 && !list_is_empty(&priv->rl_list))
     {
+      flags = enter_critical_section();
+
       /* Lock the scheduler do NOT switch out */
 
       if (!up_interrupt_context())
@@ -343,6 +374,8 @@ static ssize_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
         {
           sched_unlock();
         }
+
+      leave_critical_section(flags);
     }
 
   /* We always have to return the number of bytes requested and NOT the
@@ -350,7 +383,6 @@ static ssize_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
    * probably retry, causing same error condition again.
    */
 
-  leave_critical_section(flags);
   return len;
 }
 
@@ -379,7 +411,7 @@ static ssize_t ramlog_file_read(FAR struct file *filep, FAR char *buffer,
 
   /* Get exclusive access to the rl_tail index */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_wo_note(&priv->rl_lock);
 
   /* Loop until something is read */
 
@@ -417,12 +449,13 @@ static ssize_t ramlog_file_read(FAR struct file *filep, FAR char *buffer,
               break;
             }
 
-          /* We may now be pre-empted!  But that should be okay because we
-           * have already incremented nwaiters.  Pre-emptions is disabled
-           * but will be re-enabled while we are waiting.
+          /* Release the lock while waiting.  A write in between leaves a
+           * count on rl_waitsem, so the wakeup is not lost.
            */
 
+          spin_unlock_irqrestore_wo_note(&priv->rl_lock, flags);
           ret = nxsem_wait(&upriv->rl_waitsem);
+          flags = spin_lock_irqsave_wo_note(&priv->rl_lock);
 
           /* Did we successfully get the rl_waitsem? */
 
@@ -434,6 +467,7 @@ static ssize_t ramlog_file_read(FAR struct file *filep, FAR char *buffer,
                * anything already before waiting.
                */
 
+              spin_unlock_irqrestore_wo_note(&priv->rl_lock, flags);
               return ret;
             }
 #endif /* CONFIG_RAMLOG_NONBLOCKING */
@@ -475,7 +509,7 @@ static ssize_t ramlog_file_read(FAR struct file *filep, FAR char *buffer,
         }
     }
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_wo_note(&priv->rl_lock, flags);
 
   /* Return the number of characters actually read */
 
@@ -599,6 +633,7 @@ static int ramlog_file_open(FAR struct file *filep)
   FAR struct ramlog_header_s *header = priv->rl_header;
   FAR struct ramlog_user_s *upriv;
   irqstate_t flags;
+  irqstate_t lock;
 
   /* Get exclusive access to the rl_tail index */
 
@@ -614,9 +649,11 @@ static int ramlog_file_open(FAR struct file *filep)
 #endif
 
   flags = enter_critical_section();
+  lock  = spin_lock_irqsave_wo_note(&priv->rl_lock);
   list_add_tail(&priv->rl_list, &upriv->rl_node);
   upriv->rl_tail = header->rl_head > priv->rl_bufsize ?
                    header->rl_head - priv->rl_bufsize : 0;
+  spin_unlock_irqrestore_wo_note(&priv->rl_lock, lock);
   leave_critical_section(flags);
 
   filep->f_priv = upriv;
@@ -674,6 +711,7 @@ int ramlog_register(FAR const char *devpath, FAR char *buffer, size_t buflen)
       /* Initialize the non-zero values in the RAM logging device structure */
 
       list_initialize(&priv->rl_list);
+      spin_lock_init(&priv->rl_lock);
       priv->rl_bufsize = buflen - sizeof(struct ramlog_header_s);
       priv->rl_header = (FAR struct ramlog_header_s *)buffer;
 
@@ -107,6 +107,26 @@ FAR syslog_channel_t *syslog_dev_initialize(FAR const char *devpath,
 
 void syslog_dev_uninitialize(FAR syslog_channel_t *channel);
 
+/****************************************************************************
+ * Name: syslog_dev_compress
+ *
+ * Description:
+ *   Compress the output of a device/file channel as LZ4 frames.  The
+ *   output is buffered until a block is full or syslog_flush() is called.
+ *
+ * Input Parameters:
+ *   channel    - Handle to syslog channel to be used.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_FILE_LZ4
+int syslog_dev_compress(FAR syslog_channel_t *channel);
+#endif
+
 /****************************************************************************
  * Name: syslog_dev_channel
  *
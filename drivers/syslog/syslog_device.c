@@ -41,6 +41,8 @@
 #include <nuttx/lib/lib.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/mutex.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/streams.h>
 #include <nuttx/syslog/syslog.h>
 #include <nuttx/compiler.h>
 
@@ -84,6 +86,10 @@ struct syslog_dev_s
   rmutex_t     sl_lock;     /* Enforces mutually exclusive access */
   struct file  sl_file;     /* The syslog file structure */
   FAR char    *sl_devpath;  /* Full path to the character device */
+#ifdef CONFIG_SYSLOG_FILE_LZ4
+  FAR struct lib_lz4outstream_s *sl_lz4; /* Compression of the output */
+  struct lib_outstream_s sl_stream;      /* sl_file, the backend of sl_lz4 */
+#endif
 };
 
 /****************************************************************************
@@ -156,6 +162,84 @@ static inline void syslog_dev_unlock(FAR struct syslog_dev_s *syslog_dev)
   nxrmutex_unlock(&syslog_dev->sl_lock);
 }
 
+/****************************************************************************
+ * Name: syslog_dev_output
+ *
+ * Description:
+ *   Write to the device or file, through the compression if any.
+ *
+ ****************************************************************************/
+
+static ssize_t syslog_dev_output(FAR struct syslog_dev_s *syslog_dev,
+                                 FAR const void *buffer, size_t buflen)
+{
+#ifdef CONFIG_SYSLOG_FILE_LZ4
+  if (syslog_dev->sl_lz4 != NULL)
+    {
+      return lib_stream_puts(syslog_dev->sl_lz4, buffer, buflen);
+    }
+#endif
+
+  return file_write(&syslog_dev->sl_file, buffer, buflen);
+}
+
+/****************************************************************************
+ * Name: syslog_dev_sync
+ *
+ * Description:
+ *   Synchronize the file at the end of a line.  A compressed file is only
+ *   written a whole block at a time or by syslog_flush():  a frame per
+ *   line would take more room than the line.
+ *
+ ****************************************************************************/
+
+static void syslog_dev_sync(FAR struct syslog_dev_s *syslog_dev)
+{
+#ifdef CONFIG_SYSLOG_FILE_LZ4
+  if (syslog_dev->sl_lz4 != NULL)
+    {
+      return;
+    }
+#endif
+
+  syslog_dev_flush(&syslog_dev->channel);
+}
+
+#ifdef CONFIG_SYSLOG_FILE_LZ4
+
+/****************************************************************************
+ * Name: syslog_dev_streamputs
+ ****************************************************************************/
+
+static ssize_t syslog_dev_streamputs(FAR struct lib_outstream_s *self,
+                                     FAR const void *buf, size_t len)
+{
+  FAR struct syslog_dev_s *syslog_dev =
+    container_of(self, struct syslog_dev_s, sl_stream);
+  ssize_t ret;
+
+  ret = file_write(&syslog_dev->sl_file, buf, len);
+  if (ret > 0)
+    {
+      self->nput += ret;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: syslog_dev_streamflush
+ ****************************************************************************/
+
+static int syslog_dev_streamflush(FAR struct lib_outstream_s *self)
+{
+  /* The file is synchronized by syslog_dev_flush() */
+
+  UNUSED(self);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: syslog_dev_open
  *
@@ -322,6 +406,17 @@ static int syslog_dev_outputready(FAR struct syslog_dev_s *syslog_dev)
           file_close(&syslog_dev->sl_file);
           nxrmutex_destroy(&syslog_dev->sl_lock);
 
+#ifdef CONFIG_SYSLOG_FILE_LZ4
+          /* Drop the data of the frame left unfinished, the file goes on
+           * with a new frame.
+           */
+
+          if (syslog_dev->sl_lz4 != NULL)
+            {
+              lib_lz4outstream(syslog_dev->sl_lz4, &syslog_dev->sl_stream);
+            }
+#endif
+
           syslog_dev->sl_state = SYSLOG_REOPEN;
         }
 
@@ -427,8 +522,7 @@ static ssize_t syslog_dev_write(FAR syslog_channel_t *channel,
           writelen = (size_t)((uintptr_t)endptr - (uintptr_t)buffer);
           if (writelen > 0)
             {
-              nwritten = file_write(&syslog_dev->sl_file,
-                                    buffer, writelen);
+              nwritten = syslog_dev_output(syslog_dev, buffer, writelen);
               if (nwritten < 0)
                 {
                   ret = (int)nwritten;
@@ -460,8 +554,7 @@ static ssize_t syslog_dev_write(FAR syslog_channel_t *channel,
 
           if (writelen > 0)
             {
-              nwritten = file_write(&syslog_dev->sl_file,
-                                    g_syscrlf, writelen);
+              nwritten = syslog_dev_output(syslog_dev, g_syscrlf, writelen);
 
               /* Synchronize the file when each CR-LF is encountered
                * (i.e., implements line buffering always).
@@ -469,7 +562,7 @@ static ssize_t syslog_dev_write(FAR syslog_channel_t *channel,
 
               if (nwritten > 0)
                 {
-                  syslog_dev_flush(channel);
+                  syslog_dev_sync(syslog_dev);
                 }
 
               if (nwritten < 0)
@@ -494,7 +587,7 @@ static ssize_t syslog_dev_write(FAR syslog_channel_t *channel,
   writelen = (size_t)((uintptr_t)endptr - (uintptr_t)buffer);
   if (writelen > 0)
     {
-      nwritten = file_write(&syslog_dev->sl_file, buffer, writelen);
+      nwritten = syslog_dev_output(syslog_dev, buffer, writelen);
       if (nwritten < 0)
         {
           ret = (int)nwritten;
@@ -572,7 +665,7 @@ static int syslog_dev_putc(FAR syslog_channel_t *channel, int ch)
     {
       /* Write the CR-LF sequence */
 
-      nbytes = file_write(&syslog_dev->sl_file, g_syscrlf, 2);
+      nbytes = syslog_dev_output(syslog_dev, g_syscrlf, 2);
 
       /* Synchronize the file when each CR-LF is encountered (i.e.,
        * implements line buffering always).
@@ -580,7 +673,7 @@ static int syslog_dev_putc(FAR syslog_channel_t *channel, int ch)
 
       if (nbytes > 0)
         {
-          syslog_dev_flush(channel);
+          syslog_dev_sync(syslog_dev);
         }
     }
   else
@@ -588,7 +681,7 @@ static int syslog_dev_putc(FAR syslog_channel_t *channel, int ch)
       /* Write the non-newline character (and don't flush) */
 
       uch = (uint8_t)ch;
-      nbytes = file_write(&syslog_dev->sl_file, &uch, 1);
+      nbytes = syslog_dev_output(syslog_dev, &uch, 1);
     }
 
   syslog_dev_unlock(syslog_dev);
@@ -646,6 +739,24 @@ static int syslog_dev_flush(FAR syslog_channel_t *channel)
 #if defined(CONFIG_SYSLOG_FILE) && !defined(CONFIG_DISABLE_MOUNTPOINT)
   FAR struct syslog_dev_s *syslog_dev = (FAR struct syslog_dev_s *)channel;
 
+#  ifdef CONFIG_SYSLOG_FILE_LZ4
+  /* End the frame:  the file can be decompressed up to here.  Not from
+   * where the lock cannot be taken, the pending data are kept then.
+   */
+
+  if (syslog_dev->sl_lz4 != NULL && syslog_dev->sl_state == SYSLOG_OPENED &&
+      !up_interrupt_context() && !sched_idletask() &&
+      syslog_dev_lock(syslog_dev) >= 0)
+    {
+      if (lib_stream_flush(syslog_dev->sl_lz4) < 0)
+        {
+          syslog_dev->sl_state = SYSLOG_FAILURE;
+        }
+
+      syslog_dev_unlock(syslog_dev);
+    }
+#  endif
+
   /* Ignore return value, always return success.  file_fsync() could fail
    * because the file is not open, the inode is not a mountpoint, or the
    * mountpoint does not support the sync() method.
@@ -708,6 +819,40 @@ FAR syslog_channel_t *syslog_dev_initialize(FAR const char *devpath,
   return (FAR syslog_channel_t *)syslog_dev;
 }
 
+/****************************************************************************
+ * Name: syslog_dev_compress
+ *
+ * Description:
+ *   Compress the output of a device/file channel as LZ4 frames.  The
+ *   output is buffered until a block is full or syslog_flush() is called.
+ *
+ * Input Parameters:
+ *   channel    - Handle to syslog channel to be used.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_FILE_LZ4
+int syslog_dev_compress(FAR syslog_channel_t *channel)
+{
+  FAR struct syslog_dev_s *syslog_dev = (FAR struct syslog_dev_s *)channel;
+
+  syslog_dev->sl_lz4 = kmm_malloc(sizeof(struct lib_lz4outstream_s));
+  if (syslog_dev->sl_lz4 == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  syslog_dev->sl_stream.puts  = syslog_dev_streamputs;
+  syslog_dev->sl_stream.flush = syslog_dev_streamflush;
+  lib_lz4outstream(syslog_dev->sl_lz4, &syslog_dev->sl_stream);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: syslog_dev_uninitialize
  *
@@ -776,6 +921,13 @@ void syslog_dev_uninitialize(FAR syslog_channel_t *channel)
       lib_free(syslog_dev->sl_devpath);
     }
 
+#ifdef CONFIG_SYSLOG_FILE_LZ4
+  if (syslog_dev->sl_lz4 != NULL)
+    {
+      kmm_free(syslog_dev->sl_lz4);
+    }
+#endif
+
   /* Free the channel structure */
 
   kmm_free(syslog_dev);
@@ -202,6 +202,17 @@ FAR syslog_channel_t *syslog_file_channel(FAR const char *devpath)
       goto errout_with_lock;
     }
 
+#ifdef CONFIG_SYSLOG_FILE_LZ4
+  /* Compress the file as LZ4 frames, never mixed with plain text */
+
+  if (syslog_dev_compress(file_channel) < 0)
+    {
+      syslog_dev_uninitialize(file_channel);
+      file_channel = NULL;
+      goto errout_with_lock;
+    }
+#endif
+
   /* Use the file as the SYSLOG channel. If this fails we are pretty much
    * screwed.
    */
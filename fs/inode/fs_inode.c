@@ -41,7 +41,7 @@
  * Private Data
  ****************************************************************************/
 
-static rw_semaphore_t g_inode_lock = RWSEM_INITIALIZER;
+static rw_semaphore_t g_inode_lock = RWSEM_ADAPTIVE_INITIALIZER;
 
 /****************************************************************************
  * Public Functions
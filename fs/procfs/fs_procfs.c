@@ -60,7 +60,9 @@ extern const struct procfs_operations g_clk_operations;
 extern const struct procfs_operations g_cpuinfo_operations;
 extern const struct procfs_operations g_cpuload_operations;
 extern const struct procfs_operations g_cpufreq_operations;
+extern const struct procfs_operations g_cputime_operations;
 extern const struct procfs_operations g_critmon_operations;
+extern const struct procfs_operations g_csection_operations;
 extern const struct procfs_operations g_fdt_operations;
 extern const struct procfs_operations g_iobinfo_operations;
 extern const struct procfs_operations g_irq_operations;
@@ -68,8 +70,10 @@ extern const struct procfs_operations g_meminfo_operations;
 extern const struct procfs_operations g_memdump_operations;
 extern const struct procfs_operations g_mempool_operations;
 extern const struct procfs_operations g_module_operations;
+extern const struct procfs_operations g_mutex_operations;
 extern const struct procfs_operations g_pm_operations;
 extern const struct procfs_operations g_proc_operations;
+extern const struct procfs_operations g_runqueue_operations;
 extern const struct procfs_operations g_tcbinfo_operations;
 extern const struct procfs_operations g_thermal_operations;
 extern const struct procfs_operations g_uptime_operations;
@@ -122,8 +126,15 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "cpufreq",      &g_cpufreq_operations,  PROCFS_FILE_TYPE   },
 #endif
 
+#if CONFIG_SCHED_CRITMONITOR_MAXTIME_THREAD >= 0
+  { "cputime",      &g_cputime_operations,  PROCFS_FILE_TYPE   },
+#endif
+
 #ifdef CONFIG_SCHED_CRITMONITOR
   { "critmon",      &g_critmon_operations,  PROCFS_FILE_TYPE   },
+#  if CONFIG_SCHED_CRITMONITOR_CSECTION_SITES > 0
+  { "csection",     &g_csection_operations, PROCFS_FILE_TYPE   },
+#  endif
 #endif
 
 #if defined(CONFIG_DEVICE_TREE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_FDT)
@@ -169,6 +180,11 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "modules",      &g_module_operations,   PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_LIBC_MUTEX_ADAPTIVE) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_MUTEX)
+  { "mutex",        &g_mutex_operations,    PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_NET) && !defined(CONFIG_FS_PROCFS_EXCLUDE_NET)
   { "net",          &g_net_operations,      PROCFS_DIR_TYPE    },
 #  if defined(CONFIG_NET_ROUTE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_ROUTE)
@@ -192,6 +208,11 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "pressure/**",  &g_pressure_operations, PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_SCHED_PERCPU_RUNQUEUE) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_RUNQUEUE)
+  { "runqueue",     &g_runqueue_operations, PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_PROCESS
   { "self",         &g_proc_operations,     PROCFS_DIR_TYPE    },
   { "self/**",      &g_proc_operations,     PROCFS_UNKOWN_TYPE },
@@ -31,6 +31,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
@@ -59,7 +60,21 @@
  * to handle the longest line generated by this logic.
  */
 
-#define CRITMON_LINELEN 64
+#define CRITMON_LINELEN 80
+
+/* The number of critical section call sites reported in "csection" */
+
+#define CSECTION_NREPORT 16
+
+/* Room left in the "cputime" snapshot for the threads created between
+ * counting the threads and taking the snapshot.
+ */
+
+#define CPUTIME_NSPARE   4
+
+#define SIZEOF_CPUTIME_FILE(n) \
+  (sizeof(struct cputime_file_s) + \
+   ((n) - 1) * sizeof(struct critmon_cputime_s))
 
 /****************************************************************************
  * Private Types
@@ -74,6 +89,20 @@ struct critmon_file_s
   char line[CRITMON_LINELEN];   /* Pre-allocated buffer for formatted lines */
 };
 
+/* An open "cputime" file holds the snapshot taken when it was opened */
+
+#if CONFIG_SCHED_CRITMONITOR_MAXTIME_THREAD >= 0
+struct cputime_file_s
+{
+  struct procfs_file_s  base;   /* Base open file structure */
+  char line[CRITMON_LINELEN];   /* Pre-allocated buffer for formatted lines */
+  clock_t now;                  /* Time of the snapshot */
+  int nalloc;                   /* Number of entries allocated in snap[] */
+  int nthreads;                 /* Number of valid entries in snap[] */
+  struct critmon_cputime_s snap[1];
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -87,6 +116,18 @@ static ssize_t critmon_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
 static int     critmon_dup(FAR const struct file *oldp,
                  FAR struct file *newp);
+#if CONFIG_SCHED_CRITMONITOR_CSECTION_SITES > 0
+static ssize_t csection_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+#endif
+#if CONFIG_SCHED_CRITMONITOR_MAXTIME_THREAD >= 0
+static int     cputime_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static ssize_t cputime_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     cputime_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+#endif
 static int     critmon_stat(FAR const char *relpath, FAR struct stat *buf);
 
 /****************************************************************************
@@ -116,6 +157,46 @@ const struct procfs_operations g_critmon_operations =
   critmon_stat        /* stat */
 };
 
+#if CONFIG_SCHED_CRITMONITOR_CSECTION_SITES > 0
+const struct procfs_operations g_csection_operations =
+{
+  critmon_open,       /* open */
+  critmon_close,      /* close */
+  csection_read,      /* read */
+  NULL,               /* write */
+  NULL,               /* poll */
+
+  critmon_dup,        /* dup */
+
+  NULL,              /* opendir */
+  NULL,              /* closedir */
+  NULL,              /* readdir */
+  NULL,              /* rewinddir */
+
+  critmon_stat        /* stat */
+};
+#endif
+
+#if CONFIG_SCHED_CRITMONITOR_MAXTIME_THREAD >= 0
+const struct procfs_operations g_cputime_operations =
+{
+  cputime_open,       /* open */
+  critmon_close,      /* close */
+  cputime_read,       /* read */
+  NULL,               /* write */
+  NULL,               /* poll */
+
+  cputime_dup,        /* dup */
+
+  NULL,              /* opendir */
+  NULL,              /* closedir */
+  NULL,              /* readdir */
+  NULL,              /* rewinddir */
+
+  critmon_stat        /* stat */
+};
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -331,6 +412,222 @@ static ssize_t critmon_read(FAR struct file *filep, FAR char *buffer,
   return ret;
 }
 
+/****************************************************************************
+ * Name: csection_read
+ *
+ * Description:
+ *   Report the call sites of enter_critical_section() ranked by the total
+ *   time spent in the critical section.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_CRITMONITOR_CSECTION_SITES > 0
+static ssize_t csection_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct critmon_file_s *attr;
+  struct critmon_site_s sites[CSECTION_NREPORT];
+  struct timespec total;
+  struct timespec max;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int nsites;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct critmon_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  totalsize = 0;
+  offset    = filep->f_pos;
+
+  nsites = nxsched_critmon_sites(sites, CSECTION_NREPORT);
+
+  linesize = procfs_snprintf(attr->line, CRITMON_LINELEN,
+                             "%-18s %10s %20s %20s\n",
+                             "CALLER", "COUNT", "TOTAL", "MAX");
+  copysize = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+
+  totalsize += copysize;
+  buffer    += copysize;
+  buflen    -= copysize;
+
+  for (i = 0; i < nsites && buflen > 0; i++)
+    {
+      perf_convert(sites[i].total, &total);
+      perf_convert(sites[i].max, &max);
+
+      linesize = procfs_snprintf(attr->line, CRITMON_LINELEN,
+                                 "%-18p %10" PRIu32 " %10lu.%09lu "
+                                 "%10lu.%09lu\n",
+                                 sites[i].caller, sites[i].count,
+                                 (unsigned long)total.tv_sec,
+                                 (unsigned long)total.tv_nsec,
+                                 (unsigned long)max.tv_sec,
+                                 (unsigned long)max.tv_nsec);
+      copysize = procfs_memcpy(attr->line, linesize, buffer, buflen,
+                               &offset);
+
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+    }
+
+  if (g_crit_sites_dropped > 0 && buflen > 0)
+    {
+      linesize = procfs_snprintf(attr->line, CRITMON_LINELEN,
+                                 "%-18s %10" PRIu32 "\n", "(dropped)",
+                                 g_crit_sites_dropped);
+      copysize = procfs_memcpy(attr->line, linesize, buffer, buflen,
+                               &offset);
+
+      totalsize += copysize;
+    }
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+#endif
+
+/****************************************************************************
+ * Name: cputime_open
+ *
+ * Description:
+ *   Open "cputime" and take the snapshot of the time run by all threads.
+ *   The file reads the same until it is opened again, so that a top-like
+ *   tool may read it in pieces and compute the load from two snapshots.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_CRITMONITOR_MAXTIME_THREAD >= 0
+static int cputime_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct cputime_file_s *attr;
+  int nalloc;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  nalloc = nxsched_critmon_cputime(NULL, 0, NULL) + CPUTIME_NSPARE;
+
+  attr = fs_heap_zalloc(SIZEOF_CPUTIME_FILE(nalloc));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  attr->nalloc   = nalloc;
+  attr->nthreads = nxsched_critmon_cputime(attr->snap, nalloc, &attr->now);
+  if (attr->nthreads > nalloc)
+    {
+      attr->nthreads = nalloc;
+    }
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cputime_read
+ ****************************************************************************/
+
+static ssize_t cputime_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct cputime_file_s *attr;
+  struct timespec ts;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct cputime_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  totalsize = 0;
+  offset    = filep->f_pos;
+
+  /* The time of the snapshot, then the time run by each thread */
+
+  perf_convert(attr->now, &ts);
+  linesize = procfs_snprintf(attr->line, CRITMON_LINELEN,
+                             "%-5s %10lu.%09lu\n", "TIME",
+                             (unsigned long)ts.tv_sec,
+                             (unsigned long)ts.tv_nsec);
+  copysize = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+
+  totalsize += copysize;
+  buffer    += copysize;
+  buflen    -= copysize;
+
+  for (i = 0; i < attr->nthreads && buflen > 0; i++)
+    {
+      perf_convert(attr->snap[i].runtime, &ts);
+      linesize = procfs_snprintf(attr->line, CRITMON_LINELEN,
+                                 "%5d %10lu.%09lu\n", attr->snap[i].pid,
+                                 (unsigned long)ts.tv_sec,
+                                 (unsigned long)ts.tv_nsec);
+      copysize = procfs_memcpy(attr->line, linesize, buffer, buflen,
+                               &offset);
+
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+    }
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: cputime_dup
+ ****************************************************************************/
+
+static int cputime_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct cputime_file_s *oldattr;
+  FAR struct cputime_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  oldattr = (FAR struct cputime_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  newattr = fs_heap_malloc(SIZEOF_CPUTIME_FILE(oldattr->nalloc));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  memcpy(newattr, oldattr, SIZEOF_CPUTIME_FILE(oldattr->nalloc));
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: critmon_dup
  *
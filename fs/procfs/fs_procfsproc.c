@@ -163,7 +163,7 @@ struct proc_envinfo_s
 
 static FAR const char * const g_policy[4] =
 {
-  "SCHED_FIFO", "SCHED_RR", "SCHED_SPORADIC"
+  "SCHED_FIFO", "SCHED_RR", "SCHED_SPORADIC", "SCHED_DEADLINE"
 };
 
 /****************************************************************************
@@ -468,7 +468,10 @@ static FAR const struct proc_node_s *proc_findnode(FAR const char *relpath)
  *                                   MQ full}
  *   Flags:      xxx                N,P,X
  *   Priority:   nnn                Decimal, 0-255
- *   Scheduler:  xxxxxxxxxxxxxx     {SCHED_FIFO, SCHED_RR, SCHED_SPORADIC}
+ *   Scheduler:  xxxxxxxxxxxxxx     {SCHED_FIFO, SCHED_RR, SCHED_SPORADIC,
+ *                                   SCHED_DEADLINE}
+ *   Deadline:   nnn nnn            Missed deadlines, throttled periods
+ *                                  (SCHED_DEADLINE only)
  *   Sigmask:    nnnnnnnn           Hexadecimal, 32-bit
  *
  ****************************************************************************/
@@ -639,6 +642,43 @@ static ssize_t proc_status(FAR struct proc_file_s *procfile,
       return totalsize;
     }
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Show the deadline statistics */
+
+  if (tcb->deadline != NULL)
+    {
+      uint32_t misses = 0;
+      uint32_t throttled = 0;
+      irqstate_t flags;
+
+      /* The thread may leave the policy meanwhile */
+
+      flags = enter_critical_section();
+      if (tcb->deadline != NULL)
+        {
+          misses    = tcb->deadline->misses;
+          throttled = tcb->deadline->throttled;
+        }
+
+      leave_critical_section(flags);
+
+      linesize   = procfs_snprintf(procfile->line, STATUS_LINELEN,
+                                   "%-12s%" PRIu32 " %" PRIu32 "\n",
+                                   "Deadline:", misses, throttled);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                 remaining, &offset);
+
+      totalsize += copysize;
+      buffer    += copysize;
+      remaining -= copysize;
+
+      if (totalsize >= buflen)
+        {
+          return totalsize;
+        }
+    }
+#endif
+
   /* Show the signal mask. Note: sigset_t is uint32_t on NuttX. */
 
   linesize = procfs_snprintf(procfile->line, STATUS_LINELEN,
@@ -763,6 +803,10 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
 {
   struct timespec maxtime;
   struct timespec runtime;
+#if CONFIG_SCHED_CRITMONITOR_MAXTIME_THREAD >= 0
+  irqstate_t flags;
+  clock_t elapsed;
+#endif
   size_t remaining;
   size_t linesize;
   size_t copysize;
@@ -858,7 +902,12 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
   /* Reset the maximum */
 
   tcb->run_max = 0;
-  perf_convert(tcb->run_time, &runtime);
+
+  flags = enter_critical_section();
+  elapsed = nxsched_critmon_runtime(tcb);
+  leave_critical_section(flags);
+
+  perf_convert(elapsed, &runtime);
 
   /* Output the maximum time the thread has run and
    * the total time the thread has run
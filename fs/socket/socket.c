@@ -174,6 +174,30 @@ int sockfd_allocate(FAR struct socket *psock, int oflags)
   return file_allocate(&g_sock_inode, oflags, 0, psock, 0, true);
 }
 
+/****************************************************************************
+ * Name: sockfd_allocate_from_tcb
+ *
+ * Description:
+ *   Allocate a socket descriptor in the file list of another task, e.g.
+ *   for a socket accepted on a worker thread.
+ *
+ * Input Parameters:
+ *   tcb      The task that will own the descriptor.
+ *   psock    A pointer to socket structure.
+ *   oflags   Open mode flags.
+ *
+ * Returned Value:
+ *   Returns the file descriptor == index into the files array of the task.
+ *
+ ****************************************************************************/
+
+int sockfd_allocate_from_tcb(FAR struct tcb_s *tcb,
+                             FAR struct socket *psock, int oflags)
+{
+  return file_allocate_from_tcb(tcb, &g_sock_inode, oflags, 0, psock, 0,
+                                true);
+}
+
 /****************************************************************************
  * Name: sockfd_socket
  *
@@ -0,0 +1,1168 @@
+/****************************************************************************
+ * fs/vfs/fs_uring.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/io_uring.h>
+#include <sys/param.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <string.h>
+#include <poll.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/queue.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/net/net.h>
+
+#include "inode/inode.h"
+#include "fs_heap.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Life cycle of a request once it has been submitted */
+
+#define URING_STATE_IDLE   0  /* Owned by the submitter or the worker */
+#define URING_STATE_READY  1  /* On the ready list, to be run by the worker */
+#define URING_STATE_ARMED  2  /* Waiting for a poll event */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct uring_s;
+
+/* One submitted operation.  The SQE is copied at submission so that the
+ * application may reuse its slot right away.
+ */
+
+struct uring_req_s
+{
+  dq_entry_t node;                  /* Free, ready or armed list */
+  FAR struct uring_s *ring;         /* The ring the request belongs to */
+  FAR struct file *filep;           /* Reference taken at submission */
+  struct io_uring_sqe sqe;          /* Private copy of the submission */
+  struct pollfd pfd;                /* Used to wait for readiness */
+  uint8_t state;                    /* See URING_STATE_* */
+  bool armed;                       /* pfd is set up on filep */
+  bool fired;                       /* The readiness poll has fired */
+};
+
+/* This structure describes the internal state of one ring.  The rings
+ * are in the user heap and may be written by the application at any time:
+ * only the SQ tail and the CQ head are read from them, everything else
+ * the kernel relies on is kept here.
+ */
+
+struct uring_s
+{
+  FAR struct io_uring_sq *sq;       /* Submission ring, in the user heap */
+  FAR struct io_uring_cq *cq;       /* Completion ring, in the user heap */
+  FAR struct io_uring_sqe *sqes;    /* Submission entries, sq->sqes */
+  FAR struct io_uring_cqe *cqes;    /* Completion entries, cq->cqes */
+  uint32_t   sq_entries;            /* Number of sqes, a power of two */
+  uint32_t   cq_entries;            /* Number of cqes, a power of two */
+  uint32_t   sq_head;               /* Next SQE to consume */
+  uint32_t   cq_tail;               /* Next CQE to post */
+  dq_queue_t freeq;                 /* Unused requests */
+  dq_queue_t readyq;                /* Requests to be run by the worker */
+  dq_queue_t armedq;                /* Requests waiting for a poll event */
+  uint32_t   inflight;              /* Submitted but not completed */
+  uint16_t   nwaiters;              /* Threads waiting for completions */
+  pid_t      pid;                   /* Owner, receives accepted sockets */
+  bool       closing;               /* The ring is being torn down */
+  uint8_t    crefs;                 /* References counts on the ring */
+  mutex_t    lock;                  /* Serializes submission and close */
+  sem_t      waitsem;               /* Wakes up waiters of completions */
+  spinlock_t splock;                /* Protects the lists and the CQ tail */
+  struct work_s work;               /* Runs the ready requests */
+  FAR struct pollfd *fds[CONFIG_IO_URING_NPOLLWAITERS];
+  struct uring_req_s reqs[1];       /* cq_entries requests */
+};
+
+#define SIZEOF_URING_S(n) \
+  (sizeof(struct uring_s) + ((n) - 1) * sizeof(struct uring_req_s))
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void uring_worker(FAR void *arg);
+static int uring_file_open(FAR struct file *filep);
+static int uring_file_close(FAR struct file *filep);
+static int uring_file_poll(FAR struct file *filep,
+                           FAR struct pollfd *fds, bool setup);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_uring_fileops =
+{
+  uring_file_open,      /* open */
+  uring_file_close,     /* close */
+  NULL,                 /* read */
+  NULL,                 /* write */
+  NULL,                 /* seek */
+  NULL,                 /* ioctl */
+  NULL,                 /* mmap */
+  NULL,                 /* truncate */
+  uring_file_poll       /* poll */
+};
+
+static struct inode g_uring_inode =
+{
+  NULL,                   /* i_parent */
+  NULL,                   /* i_peer */
+  NULL,                   /* i_child */
+  1,                      /* i_crefs */
+  FSNODEFLAG_TYPE_DRIVER, /* i_flags */
+  {
+    &g_uring_fileops      /* u */
+  }
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: uring_roundup
+ *
+ * Description:
+ *   Round the number of entries of a ring up to a power of two.
+ *
+ ****************************************************************************/
+
+static uint32_t uring_roundup(uint32_t entries)
+{
+  uint32_t n = 1;
+
+  while (n < entries)
+    {
+      n <<= 1;
+    }
+
+  return n;
+}
+
+/****************************************************************************
+ * Name: uring_kick
+ *
+ * Description:
+ *   Schedule the worker of the ring.  Several kicks before the worker runs
+ *   are merged, so a batch of submissions costs a single work item.
+ *
+ ****************************************************************************/
+
+static void uring_kick(FAR struct uring_s *ring)
+{
+  if (work_available(&ring->work))
+    {
+      work_queue(LPWORK, &ring->work, uring_worker, ring, 0);
+    }
+}
+
+/****************************************************************************
+ * Name: uring_cqready
+ *
+ * Description:
+ *   Return the number of completions not reaped yet.  The CQ head is
+ *   written by the application, a bogus one counts as a full ring.
+ *
+ ****************************************************************************/
+
+static uint32_t uring_cqready(FAR struct uring_s *ring)
+{
+  uint32_t ready = ring->cq_tail - ring->cq->head;
+
+  return MIN(ready, ring->cq_entries);
+}
+
+/****************************************************************************
+ * Name: uring_complete
+ *
+ * Description:
+ *   Post the completion of a request to the completion ring and return the
+ *   request to the free list.  The ring cannot overflow because no more
+ *   requests than free CQ entries are accepted at submission.
+ *
+ ****************************************************************************/
+
+static void uring_complete(FAR struct uring_req_s *req, int res)
+{
+  FAR struct uring_s *ring = req->ring;
+  FAR struct io_uring_cqe *cqe;
+  irqstate_t flags;
+  uint16_t nwaiters;
+  uint32_t tail;
+
+  if (req->filep != NULL)
+    {
+      fs_putfilep(req->filep);
+      req->filep = NULL;
+    }
+
+  flags = spin_lock_irqsave(&ring->splock);
+
+  tail = ring->cq_tail;
+  cqe  = &ring->cqes[tail & (ring->cq_entries - 1)];
+  cqe->user_data = req->sqe.user_data;
+  cqe->res       = res;
+  cqe->flags     = 0;
+
+  /* The entry must be visible before the new tail */
+
+  UP_DMB();
+  ring->cq_tail  = tail + 1;
+  ring->cq->tail = tail + 1;
+
+  ring->inflight--;
+  req->state = URING_STATE_IDLE;
+  req->fired = false;
+  dq_addlast(&req->node, &ring->freeq);
+
+  nwaiters = ring->nwaiters;
+  ring->nwaiters = 0;
+
+  spin_unlock_irqrestore(&ring->splock, flags);
+
+  while (nwaiters-- > 0)
+    {
+      nxsem_post(&ring->waitsem);
+    }
+
+  poll_notify(ring->fds, CONFIG_IO_URING_NPOLLWAITERS, POLLIN);
+}
+
+/****************************************************************************
+ * Name: uring_pollcb
+ *
+ * Description:
+ *   Poll callback of an armed request.  It may run in interrupt context, it
+ *   only moves the request to the ready list and kicks the worker.  All is
+ *   done under splock, so that close can wait for a running callback by
+ *   taking it.
+ *
+ ****************************************************************************/
+
+static void uring_pollcb(FAR struct pollfd *fds)
+{
+  FAR struct uring_req_s *req = fds->arg;
+  FAR struct uring_s *ring = req->ring;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&ring->splock);
+  if (req->state == URING_STATE_ARMED)
+    {
+      dq_rem(&req->node, &ring->armedq);
+      dq_addlast(&req->node, &ring->readyq);
+      req->state = URING_STATE_READY;
+      req->fired = true;
+      if (!ring->closing)
+        {
+          uring_kick(ring);
+        }
+    }
+
+  spin_unlock_irqrestore(&ring->splock, flags);
+}
+
+/****************************************************************************
+ * Name: uring_arm
+ *
+ * Description:
+ *   Wait for the file of a request to become ready instead of blocking the
+ *   worker.  The request is run again once the poll event fires.
+ *
+ ****************************************************************************/
+
+static int uring_arm(FAR struct uring_req_s *req, pollevent_t events)
+{
+  FAR struct uring_s *ring = req->ring;
+  irqstate_t flags;
+  int ret;
+
+  req->pfd.fd      = req->sqe.fd;
+  req->pfd.events  = events;
+  req->pfd.revents = 0;
+  req->pfd.arg     = req;
+  req->pfd.cb      = uring_pollcb;
+  req->armed       = true;
+
+  flags = spin_lock_irqsave(&ring->splock);
+  req->state = URING_STATE_ARMED;
+  dq_addlast(&req->node, &ring->armedq);
+  spin_unlock_irqrestore(&ring->splock, flags);
+
+  /* The callback may fire before file_poll() returns */
+
+  ret = file_poll(req->filep, &req->pfd, true);
+  if (ret < 0)
+    {
+      flags = spin_lock_irqsave(&ring->splock);
+      dq_rem(&req->node, req->state == URING_STATE_ARMED ?
+                         &ring->armedq : &ring->readyq);
+      req->state = URING_STATE_IDLE;
+      spin_unlock_irqrestore(&ring->splock, flags);
+      req->armed = false;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: uring_isregular
+ *
+ * Description:
+ *   Regular files and block devices never block on readiness, they are
+ *   accessed right away by the worker.
+ *
+ ****************************************************************************/
+
+static bool uring_isregular(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+
+  return INODE_IS_MOUNTPT(inode) || INODE_IS_BLOCK(inode) ||
+         INODE_IS_MTD(inode);
+}
+
+/****************************************************************************
+ * Name: uring_accept
+ *
+ * Description:
+ *   Accept a connection and install the new socket in the file list of the
+ *   owner of the ring.  The accept never blocks the worker, -EAGAIN is
+ *   returned if no connection is pending, the connection may have been
+ *   taken by another thread since the poll fired.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET
+static int uring_accept(FAR struct uring_req_s *req)
+{
+  FAR struct io_uring_sqe *sqe = &req->sqe;
+  FAR struct socket *newsock;
+  FAR struct tcb_s *tcb;
+  int oflags = O_RDWR;
+  int ret;
+
+  newsock = fs_heap_zalloc(sizeof(*newsock));
+  if (newsock == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ret = psock_accept(file_socket(req->filep),
+                     (FAR struct sockaddr *)(uintptr_t)sqe->addr,
+                     (FAR socklen_t *)(uintptr_t)sqe->addr2,
+                     newsock, sqe->op_flags | SOCK_ACCEPT_DONTWAIT);
+  if (ret < 0)
+    {
+      fs_heap_free(newsock);
+      return ret;
+    }
+
+  if (sqe->op_flags & SOCK_CLOEXEC)
+    {
+      oflags |= O_CLOEXEC;
+    }
+
+  if (sqe->op_flags & SOCK_NONBLOCK)
+    {
+      oflags |= O_NONBLOCK;
+    }
+
+  tcb = nxsched_get_tcb(req->ring->pid);
+  ret = tcb != NULL ? sockfd_allocate_from_tcb(tcb, newsock, oflags) :
+                      -ESRCH;
+  if (ret < 0)
+    {
+      psock_close(newsock);
+      fs_heap_free(newsock);
+    }
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: uring_execute
+ *
+ * Description:
+ *   Run one request on the worker.  Operations that could block the worker
+ *   are first armed on poll, and run when their file becomes ready.
+ *
+ ****************************************************************************/
+
+static void uring_execute(FAR struct uring_req_s *req)
+{
+  FAR struct io_uring_sqe *sqe = &req->sqe;
+  FAR void *buf = (FAR void *)(uintptr_t)sqe->addr;
+  pollevent_t events = 0;
+  ssize_t ret = OK;
+
+  switch (sqe->opcode)
+    {
+      case IORING_OP_NOP:
+        ret = OK;
+        break;
+
+      case IORING_OP_READ:
+      case IORING_OP_WRITE:
+        if (!req->fired && !uring_isregular(req->filep))
+          {
+            events = sqe->opcode == IORING_OP_READ ? POLLIN : POLLOUT;
+            break;
+          }
+
+        if (sqe->off == IORING_OFF_CURRENT)
+          {
+            ret = sqe->opcode == IORING_OP_READ ?
+                  file_read(req->filep, buf, sqe->len) :
+                  file_write(req->filep, buf, sqe->len);
+          }
+        else
+          {
+            ret = sqe->opcode == IORING_OP_READ ?
+                  file_pread(req->filep, buf, sqe->len, sqe->off) :
+                  file_pwrite(req->filep, buf, sqe->len, sqe->off);
+          }
+        break;
+
+#ifdef CONFIG_NET
+      case IORING_OP_SEND:
+      case IORING_OP_RECV:
+        if (sqe->opcode == IORING_OP_SEND)
+          {
+            ret = psock_send(file_socket(req->filep), buf, sqe->len,
+                             sqe->op_flags | MSG_DONTWAIT);
+            events = POLLOUT;
+          }
+        else
+          {
+            ret = psock_recv(file_socket(req->filep), buf, sqe->len,
+                             sqe->op_flags | MSG_DONTWAIT);
+            events = POLLIN;
+          }
+
+        if (ret != -EAGAIN || (sqe->op_flags & MSG_DONTWAIT) != 0)
+          {
+            events = 0;
+          }
+        break;
+
+      case IORING_OP_ACCEPT:
+        ret = uring_accept(req);
+        if (ret == -EAGAIN)
+          {
+            events = POLLIN;
+          }
+        break;
+#endif
+
+      case IORING_OP_FSYNC:
+        ret = file_fsync(req->filep);
+        break;
+
+      case IORING_OP_POLL_ADD:
+        if (!req->fired)
+          {
+            events = sqe->op_flags;
+            break;
+          }
+
+        ret = req->pfd.revents;
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  if (events != 0)
+    {
+      ret = uring_arm(req, events);
+      if (ret >= 0)
+        {
+          return;
+        }
+    }
+
+  uring_complete(req, ret);
+}
+
+/****************************************************************************
+ * Name: uring_worker
+ *
+ * Description:
+ *   Run all the ready requests of a ring.
+ *
+ ****************************************************************************/
+
+static void uring_worker(FAR void *arg)
+{
+  FAR struct uring_s *ring = arg;
+  FAR struct uring_req_s *req;
+  irqstate_t flags;
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&ring->splock);
+      req = (FAR struct uring_req_s *)dq_remfirst(&ring->readyq);
+      if (req != NULL)
+        {
+          req->state = URING_STATE_IDLE;
+        }
+
+      spin_unlock_irqrestore(&ring->splock, flags);
+
+      if (req == NULL)
+        {
+          break;
+        }
+
+      /* The poll is one-shot, tear it down before running the request */
+
+      if (req->armed)
+        {
+          file_poll(req->filep, &req->pfd, false);
+          req->armed = false;
+        }
+
+      uring_execute(req);
+    }
+}
+
+/****************************************************************************
+ * Name: uring_prepare
+ *
+ * Description:
+ *   Validate a submission and take a reference on its file.  This runs in
+ *   the context of the submitter, whose file list the fd belongs to.
+ *
+ ****************************************************************************/
+
+static int uring_prepare(FAR struct uring_req_s *req)
+{
+  FAR struct io_uring_sqe *sqe = &req->sqe;
+  int ret;
+
+  if (sqe->flags != 0 || sqe->ioprio != 0)
+    {
+      return -EINVAL;
+    }
+
+  switch (sqe->opcode)
+    {
+      case IORING_OP_NOP:
+        return OK;
+
+      case IORING_OP_READ:
+      case IORING_OP_WRITE:
+      case IORING_OP_FSYNC:
+      case IORING_OP_POLL_ADD:
+        break;
+
+#ifdef CONFIG_NET
+      case IORING_OP_ACCEPT:
+        if (sqe->op_flags & ~(SOCK_NONBLOCK | SOCK_CLOEXEC))
+          {
+            return -EINVAL;
+          }
+
+        /* Fall through */
+
+      case IORING_OP_SEND:
+      case IORING_OP_RECV:
+        break;
+#endif
+
+      default:
+        return -EINVAL;
+    }
+
+  ret = fs_getfilep(sqe->fd, &req->filep);
+  if (ret < 0)
+    {
+      req->filep = NULL;
+      return ret;
+    }
+
+  /* A ring polling itself would never see its own completion */
+
+  if (sqe->opcode == IORING_OP_POLL_ADD &&
+      req->filep->f_inode == &g_uring_inode &&
+      req->filep->f_priv == req->ring)
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_NET
+  if ((sqe->opcode == IORING_OP_ACCEPT || sqe->opcode == IORING_OP_SEND ||
+       sqe->opcode == IORING_OP_RECV) && file_socket(req->filep) == NULL)
+    {
+      return -ENOTSOCK;
+    }
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: uring_submit
+ *
+ * Description:
+ *   Consume up to to_submit entries of the submission ring and hand them
+ *   to the worker in a single batch.
+ *
+ * Returned Value:
+ *   The number of entries consumed, or -EBUSY if none could be because
+ *   the completion ring would overflow.
+ *
+ ****************************************************************************/
+
+static int uring_submit(FAR struct uring_s *ring, unsigned int to_submit)
+{
+  FAR struct uring_req_s *req;
+  unsigned int count = 0;
+  irqstate_t flags;
+  uint32_t head = ring->sq_head;
+  uint32_t tail = ring->sq->tail;
+  int ret;
+
+  /* The SQ tail is written by the application, never consume more than
+   * one ring of entries.
+   */
+
+  if (tail - head > ring->sq_entries)
+    {
+      tail = head + ring->sq_entries;
+    }
+
+  /* Read the entries only after the tail that published them */
+
+  UP_DMB();
+
+  while (count < to_submit && head != tail)
+    {
+      flags = spin_lock_irqsave(&ring->splock);
+      if (ring->inflight + uring_cqready(ring) >= ring->cq_entries)
+        {
+          spin_unlock_irqrestore(&ring->splock, flags);
+          break;
+        }
+
+      req = (FAR struct uring_req_s *)dq_remfirst(&ring->freeq);
+      DEBUGASSERT(req != NULL);
+      ring->inflight++;
+      spin_unlock_irqrestore(&ring->splock, flags);
+
+      memcpy(&req->sqe, &ring->sqes[head & (ring->sq_entries - 1)],
+             sizeof(req->sqe));
+      ring->sq_head  = ++head;
+      ring->sq->head = head;
+      count++;
+
+      ret = uring_prepare(req);
+      if (ret < 0)
+        {
+          uring_complete(req, ret);
+          continue;
+        }
+
+      flags = spin_lock_irqsave(&ring->splock);
+      req->state = URING_STATE_READY;
+      dq_addlast(&req->node, &ring->readyq);
+      spin_unlock_irqrestore(&ring->splock, flags);
+    }
+
+  if (count > 0)
+    {
+      uring_kick(ring);
+    }
+  else if (head != tail)
+    {
+      return -EBUSY;
+    }
+
+  return count;
+}
+
+/****************************************************************************
+ * Name: uring_wait
+ *
+ * Description:
+ *   Wait until min_complete entries are available in the completion ring,
+ *   or until nothing is left in flight.
+ *
+ ****************************************************************************/
+
+static int uring_wait(FAR struct uring_s *ring, unsigned int min_complete)
+{
+  irqstate_t flags;
+  int ret;
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&ring->splock);
+      if (uring_cqready(ring) >= min_complete || ring->inflight == 0)
+        {
+          spin_unlock_irqrestore(&ring->splock, flags);
+          return OK;
+        }
+
+      ring->nwaiters++;
+      spin_unlock_irqrestore(&ring->splock, flags);
+
+      ret = nxsem_wait(&ring->waitsem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: uring_release
+ *
+ * Description:
+ *   Drop a request that never completed, the ring is being closed.
+ *
+ ****************************************************************************/
+
+static void uring_release(FAR struct uring_req_s *req)
+{
+  if (req->armed)
+    {
+      file_poll(req->filep, &req->pfd, false);
+      req->armed = false;
+    }
+
+  if (req->filep != NULL)
+    {
+      fs_putfilep(req->filep);
+      req->filep = NULL;
+    }
+}
+
+static int uring_file_open(FAR struct file *filep)
+{
+  FAR struct uring_s *ring = filep->f_priv;
+  int ret;
+
+  nxmutex_lock(&ring->lock);
+  if (ring->crefs >= 255)
+    {
+      ret = -EMFILE;
+    }
+  else
+    {
+      ring->crefs += 1;
+      ret = OK;
+    }
+
+  nxmutex_unlock(&ring->lock);
+  return ret;
+}
+
+static int uring_file_close(FAR struct file *filep)
+{
+  FAR struct uring_s *ring = filep->f_priv;
+  FAR struct uring_req_s *req;
+  irqstate_t flags;
+  int i;
+
+  nxmutex_lock(&ring->lock);
+  if (ring->crefs > 1)
+    {
+      ring->crefs--;
+      nxmutex_unlock(&ring->lock);
+      return OK;
+    }
+
+  /* Stop the poll callbacks from kicking the worker, then wait for it */
+
+  flags = spin_lock_irqsave(&ring->splock);
+  ring->closing = true;
+  spin_unlock_irqrestore(&ring->splock, flags);
+
+  work_cancel_sync(LPWORK, &ring->work);
+
+  /* Drop the requests still waiting for a poll event or for the worker */
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&ring->splock);
+      req = (FAR struct uring_req_s *)dq_remfirst(&ring->armedq);
+      if (req == NULL)
+        {
+          req = (FAR struct uring_req_s *)dq_remfirst(&ring->readyq);
+        }
+
+      spin_unlock_irqrestore(&ring->splock, flags);
+
+      if (req == NULL)
+        {
+          break;
+        }
+
+      uring_release(req);
+    }
+
+  /* No poll callback can fire any more, wait for one still running on
+   * another CPU:  they run under splock.
+   */
+
+  flags = spin_lock_irqsave(&ring->splock);
+  spin_unlock_irqrestore(&ring->splock, flags);
+
+  /* Detach the threads still polling the ring */
+
+  poll_notify(ring->fds, CONFIG_IO_URING_NPOLLWAITERS, POLLHUP);
+  for (i = 0; i < CONFIG_IO_URING_NPOLLWAITERS; i++)
+    {
+      if (ring->fds[i] != NULL)
+        {
+          ring->fds[i]->priv = NULL;
+          ring->fds[i]       = NULL;
+        }
+    }
+
+  nxmutex_unlock(&ring->lock);
+  nxmutex_destroy(&ring->lock);
+  nxsem_destroy(&ring->waitsem);
+
+  kumm_free(ring->sqes);
+  kumm_free(ring->cqes);
+  kumm_free(ring->sq);
+  fs_heap_free(ring);
+  return OK;
+}
+
+static int uring_file_poll(FAR struct file *filep,
+                           FAR struct pollfd *fds, bool setup)
+{
+  FAR struct uring_s *ring = filep->f_priv;
+  int ret = OK;
+  int i;
+
+  nxmutex_lock(&ring->lock);
+  if (!setup)
+    {
+      /* This is a request to tear down the poll. */
+
+      FAR struct pollfd **slot = (FAR struct pollfd **)fds->priv;
+
+      /* Remove all memory of the poll setup */
+
+      if (slot != NULL)
+        {
+          *slot = NULL;
+        }
+
+      fds->priv = NULL;
+      goto out;
+    }
+
+  /* This is a request to set up the poll. Find an available
+   * slot for the poll structure reference
+   */
+
+  for (i = 0; i < CONFIG_IO_URING_NPOLLWAITERS; i++)
+    {
+      /* Find an available slot */
+
+      if (ring->fds[i] == NULL)
+        {
+          /* Bind the poll structure and this slot */
+
+          ring->fds[i] = fds;
+          fds->priv    = &ring->fds[i];
+          break;
+        }
+    }
+
+  if (i >= CONFIG_IO_URING_NPOLLWAITERS)
+    {
+      ret = -EBUSY;
+      goto out;
+    }
+
+  /* Notify the POLLIN event if completions are pending */
+
+  if (uring_cqready(ring) != 0)
+    {
+      poll_notify(&fds, 1, POLLIN);
+    }
+
+out:
+  nxmutex_unlock(&ring->lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: io_uring_setup
+ *
+ * Description:
+ *   Create a submission ring of at least 'entries' entries and a completion
+ *   ring (twice as large unless IORING_SETUP_CQSIZE is given), and return
+ *   a file descriptor referring to them.
+ *
+ *   The application fills in struct io_uring_sqe entries at the tail of
+ *   the submission ring and hands them to the kernel with io_uring_enter().
+ *   The operations run on the low priority work queue, those that could
+ *   block are first armed on poll, so that a single worker serves all the
+ *   pending operations of the ring.  Completions are posted to the
+ *   completion ring, which the application reaps without any system call.
+ *
+ *   NuttX has no mmap() of kernel memory, so the rings are allocated from
+ *   the user heap and their addresses returned in p->sq and p->cq.  They
+ *   remain valid until the file descriptor is closed.
+ *
+ * Input Parameters:
+ *   entries - The requested number of submission entries
+ *   p       - The setup parameters, see struct io_uring_params
+ *
+ * Returned Value:
+ *   The file descriptor of the ring on success.  On error, -1 is returned
+ *   and errno is set to indicate the error.
+ *
+ ****************************************************************************/
+
+int io_uring_setup(unsigned int entries, FAR struct io_uring_params *p)
+{
+  FAR struct uring_s *ring;
+  FAR struct io_uring_sq *sq;
+  FAR struct io_uring_cq *cq;
+  uint32_t sq_entries;
+  uint32_t cq_entries;
+  int oflags = O_RDOK;
+  int ret = EINVAL;
+  int fd;
+  int i;
+
+  if (p == NULL || entries == 0 || entries > CONFIG_IO_URING_ENTRIES_MAX ||
+      (p->flags & ~(IORING_SETUP_CQSIZE | IORING_SETUP_CLOEXEC)) != 0)
+    {
+      goto errout;
+    }
+
+  sq_entries = uring_roundup(entries);
+  if (p->flags & IORING_SETUP_CQSIZE)
+    {
+      if (p->cq_entries < sq_entries ||
+          p->cq_entries > 2 * CONFIG_IO_URING_ENTRIES_MAX)
+        {
+          goto errout;
+        }
+
+      cq_entries = uring_roundup(p->cq_entries);
+    }
+  else
+    {
+      cq_entries = 2 * sq_entries;
+    }
+
+  if (p->flags & IORING_SETUP_CLOEXEC)
+    {
+      oflags |= O_CLOEXEC;
+    }
+
+  /* One request per completion entry is enough, since no more are
+   * accepted than the completion ring can hold.
+   */
+
+  ring = fs_heap_zalloc(SIZEOF_URING_S(cq_entries));
+  if (ring == NULL)
+    {
+      ret = ENOMEM;
+      goto errout;
+    }
+
+  /* The rings are shared with the application */
+
+  sq = kumm_zalloc(sizeof(struct io_uring_sq) + sizeof(struct io_uring_cq));
+  if (sq == NULL)
+    {
+      ret = ENOMEM;
+      goto errout_with_ring;
+    }
+
+  cq = (FAR struct io_uring_cq *)(sq + 1);
+  sq->ring_entries = sq_entries;
+  sq->ring_mask    = sq_entries - 1;
+  sq->sqes         = kumm_zalloc(sq_entries * sizeof(struct io_uring_sqe));
+  cq->ring_entries = cq_entries;
+  cq->ring_mask    = cq_entries - 1;
+  cq->cqes         = kumm_zalloc(cq_entries * sizeof(struct io_uring_cqe));
+  if (sq->sqes == NULL || cq->cqes == NULL)
+    {
+      ret = ENOMEM;
+      goto errout_with_rings;
+    }
+
+  ring->sq         = sq;
+  ring->cq         = cq;
+  ring->sqes       = sq->sqes;
+  ring->cqes       = cq->cqes;
+  ring->sq_entries = sq_entries;
+  ring->cq_entries = cq_entries;
+  ring->pid = nxsched_getpid();
+  nxmutex_init(&ring->lock);
+  nxsem_init(&ring->waitsem, 0, 0);
+  spin_lock_init(&ring->splock);
+
+  for (i = 0; i < cq_entries; i++)
+    {
+      ring->reqs[i].ring = ring;
+      dq_addlast(&ring->reqs[i].node, &ring->freeq);
+    }
+
+  fd = file_allocate(&g_uring_inode, oflags, 0, ring, 0, true);
+  if (fd < 0)
+    {
+      ret = -fd;
+      nxsem_destroy(&ring->waitsem);
+      nxmutex_destroy(&ring->lock);
+      goto errout_with_rings;
+    }
+
+  ring->crefs++;
+
+  p->sq_entries = sq_entries;
+  p->cq_entries = cq_entries;
+  p->sq         = sq;
+  p->cq         = cq;
+  return fd;
+
+errout_with_rings:
+  kumm_free(sq->sqes);
+  kumm_free(cq->cqes);
+  kumm_free(sq);
+
+errout_with_ring:
+  fs_heap_free(ring);
+
+errout:
+  set_errno(ret);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: io_uring_enter
+ *
+ * Description:
+ *   Submit up to to_submit entries of the submission ring.  With
+ *   IORING_ENTER_GETEVENTS, then wait until at least min_complete
+ *   completions are available (or nothing is left in flight).
+ *
+ * Input Parameters:
+ *   fd           - The file descriptor returned by io_uring_setup()
+ *   to_submit    - The maximum number of entries to submit
+ *   min_complete - The number of completions to wait for
+ *   flags        - IORING_ENTER_* flags
+ *
+ * Returned Value:
+ *   The number of entries submitted on success.  On error, -1 is returned
+ *   and errno is set to indicate the error: EBUSY if the completion ring
+ *   has no room for another request.
+ *
+ ****************************************************************************/
+
+int io_uring_enter(int fd, unsigned int to_submit,
+                   unsigned int min_complete, unsigned int flags)
+{
+  FAR struct uring_s *ring;
+  FAR struct file *filep;
+  int submitted = 0;
+  int ret;
+
+  if (fs_getfilep(fd, &filep) < 0)
+    {
+      ret = -EBADF;
+      goto errout;
+    }
+
+  if (filep->f_inode->u.i_ops != &g_uring_fileops ||
+      (flags & ~IORING_ENTER_GETEVENTS) != 0)
+    {
+      ret = -EINVAL;
+      goto errout_with_filep;
+    }
+
+  ring = filep->f_priv;
+  if (to_submit > 0)
+    {
+      ret = nxmutex_lock(&ring->lock);
+      if (ret < 0)
+        {
+          goto errout_with_filep;
+        }
+
+      submitted = uring_submit(ring, to_submit);
+      nxmutex_unlock(&ring->lock);
+      if (submitted < 0)
+        {
+          ret = submitted;
+          goto errout_with_filep;
+        }
+    }
+
+  if ((flags & IORING_ENTER_GETEVENTS) != 0 && min_complete > 0)
+    {
+      ret = uring_wait(ring, min_complete);
+      if (ret < 0 && submitted == 0)
+        {
+          goto errout_with_filep;
+        }
+    }
+
+  fs_putfilep(filep);
+  return submitted;
+
+errout_with_filep:
+  fs_putfilep(filep);
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
@@ -459,6 +459,60 @@ struct avg_filter_data_s
   float k;             /* k counter */
 };
 
+/* Batched (multi-channel) data.  Each member points to an array with one
+ * element per channel, e.g. per motor, so that a batch function processes
+ * all the channels in one call.
+ */
+
+/* ABC frames of a batch */
+
+struct abc_batch_f32_s
+{
+  FAR float *a;                  /* A components */
+  FAR float *b;                  /* B components */
+  FAR float *c;                  /* C components */
+};
+
+/* Alpha-beta frames of a batch */
+
+struct ab_batch_f32_s
+{
+  FAR float *a;                  /* Alpha components */
+  FAR float *b;                  /* Beta components */
+};
+
+/* Direct-quadrature frames of a batch */
+
+struct dq_batch_f32_s
+{
+  FAR float *d;                  /* Direct components */
+  FAR float *q;                  /* Quadrature components */
+};
+
+/* Phase angles of a batch, only their sine and cosine */
+
+struct phase_angle_batch_f32_s
+{
+  FAR float *sin;                /* Phase angle sines */
+  FAR float *cos;                /* Phase angle cosines */
+};
+
+/* PI controllers of a batch, always with output saturation and
+ * anti-windup:  a zero KC disables the anti-windup of a channel.
+ */
+
+struct pi_batch_f32_s
+{
+  FAR float *KP;                 /* Proportional coefficients */
+  FAR float *KI;                 /* Integral coefficients */
+  FAR float *KC;                 /* Integral anti-windup decay coefficients */
+  FAR float *min;                /* Output lower limits */
+  FAR float *max;                /* Output upper limits */
+  FAR float *part;               /* Integral parts */
+  FAR float *aw;                 /* Integral anti-windup decay parts */
+  bool       ireset_en;          /* Integral part reset if saturated */
+};
+
 /****************************************************************************
  * Public Functions Prototypes
  ****************************************************************************/
@@ -619,6 +673,25 @@ void avg_filter_data_init(FAR struct avg_filter_data_s *data,
                           float prev_avg, float k);
 float avg_filter(FAR struct avg_filter_data_s *data, float x);
 
+/* Batched functions */
+
+void clarke_transform_batch(FAR const struct abc_batch_f32_s *abc,
+                            FAR struct ab_batch_f32_s *ab, size_t n);
+void inv_clarke_transform_batch(FAR const struct ab_batch_f32_s *ab,
+                                FAR struct abc_batch_f32_s *abc,
+                                size_t n);
+void park_transform_batch(FAR const struct phase_angle_batch_f32_s *angle,
+                          FAR const struct ab_batch_f32_s *ab,
+                          FAR struct dq_batch_f32_s *dq, size_t n);
+void inv_park_transform_batch(
+  FAR const struct phase_angle_batch_f32_s *angle,
+  FAR const struct dq_batch_f32_s *dq, FAR struct ab_batch_f32_s *ab,
+  size_t n);
+void svm3_batch(FAR const struct ab_batch_f32_s *v_ab,
+                FAR struct abc_batch_f32_s *duty, size_t n);
+void pi_controller_batch(FAR struct pi_batch_f32_s *pi,
+                         FAR const float *err, FAR float *out, size_t n);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -441,6 +441,60 @@ struct pmsm_model_b16_s
   b16_t                         iq_int; /* Iq integral part */
 };
 
+/* Batched (multi-channel) data.  Each member points to an array with one
+ * element per channel, e.g. per motor, so that a batch function processes
+ * all the channels in one call.
+ */
+
+/* ABC frames of a batch */
+
+struct abc_batch_b16_s
+{
+  FAR b16_t *a;                  /* A components */
+  FAR b16_t *b;                  /* B components */
+  FAR b16_t *c;                  /* C components */
+};
+
+/* Alpha-beta frames of a batch */
+
+struct ab_batch_b16_s
+{
+  FAR b16_t *a;                  /* Alpha components */
+  FAR b16_t *b;                  /* Beta components */
+};
+
+/* Direct-quadrature frames of a batch */
+
+struct dq_batch_b16_s
+{
+  FAR b16_t *d;                  /* Direct components */
+  FAR b16_t *q;                  /* Quadrature components */
+};
+
+/* Phase angles of a batch, only their sine and cosine */
+
+struct phase_angle_batch_b16_s
+{
+  FAR b16_t *sin;                /* Phase angle sines */
+  FAR b16_t *cos;                /* Phase angle cosines */
+};
+
+/* PI controllers of a batch, always with output saturation and
+ * anti-windup:  a zero KC disables the anti-windup of a channel.
+ */
+
+struct pi_batch_b16_s
+{
+  FAR b16_t *KP;                 /* Proportional coefficients */
+  FAR b16_t *KI;                 /* Integral coefficients */
+  FAR b16_t *KC;                 /* Integral anti-windup decay coefficients */
+  FAR b16_t *min;                /* Output lower limits */
+  FAR b16_t *max;                /* Output upper limits */
+  FAR b16_t *part;               /* Integral parts */
+  FAR b16_t *aw;                 /* Integral anti-windup decay parts */
+  bool       ireset_en;          /* Integral part reset if saturated */
+};
+
 /****************************************************************************
  * Public Functions Prototypes
  ****************************************************************************/
@@ -600,6 +654,26 @@ int pmsm_model_elec_b16(FAR struct pmsm_model_b16_s *model,
                         FAR ab_frame_b16_t *vab);
 int pmsm_model_mech_b16(FAR struct pmsm_model_b16_s *model, b16_t load);
 
+/* Batched functions */
+
+void clarke_transform_batch_b16(FAR const struct abc_batch_b16_s *abc,
+                                FAR struct ab_batch_b16_s *ab, size_t n);
+void inv_clarke_transform_batch_b16(FAR const struct ab_batch_b16_s *ab,
+                                    FAR struct abc_batch_b16_s *abc,
+                                    size_t n);
+void park_transform_batch_b16(
+  FAR const struct phase_angle_batch_b16_s *angle,
+  FAR const struct ab_batch_b16_s *ab, FAR struct dq_batch_b16_s *dq,
+  size_t n);
+void inv_park_transform_batch_b16(
+  FAR const struct phase_angle_batch_b16_s *angle,
+  FAR const struct dq_batch_b16_s *dq, FAR struct ab_batch_b16_s *ab,
+  size_t n);
+void svm3_batch_b16(FAR const struct ab_batch_b16_s *v_ab,
+                    FAR struct abc_batch_b16_s *duty, size_t n);
+void pi_controller_batch_b16(FAR struct pi_batch_b16_s *pi,
+                             FAR const b16_t *err, FAR b16_t *out, size_t n);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -0,0 +1,169 @@
+/****************************************************************************
+ * include/lz4.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_LZ4_H
+#define __INCLUDE_LZ4_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sys/types.h>
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_LZ4
+
+/* Block format */
+
+#define LZ4_MINMATCH           4     /* Shortest match */
+#define LZ4_LASTLITERALS       5     /* The last bytes are always literals */
+#define LZ4_MFLIMIT            12    /* No match starts in the last bytes */
+#define LZ4_MAX_OFFSET         65535 /* Farthest match */
+
+/* Size of the output buffer always large enough to compress n bytes */
+
+#define LZ4_COMPRESSBOUND(n)   ((n) + (n) / 255 + 16)
+
+/* Frame format */
+
+#define LZ4_FRAME_MAGIC        0x184d2204
+#define LZ4_SKIPPABLE_MAGIC    0x184d2a50 /* to 0x184d2a5f */
+#define LZ4_FRAME_HDR_SIZE     7          /* Header without optional fields */
+#define LZ4_BLOCK_HDR_SIZE     4          /* Size of a block, little-endian */
+#define LZ4_BLOCK_UNCOMPRESSED 0x80000000 /* Set for a block stored as is */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* LZ4 hash table, the positions of the last sequences seen */
+
+typedef uint32_t lz4_state_t[1 << CONFIG_LIBC_LZ4_HLOG];
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_compress
+ *
+ * Description:
+ *   Compress in_len bytes at in_data into an LZ4 block at out_data, up to
+ *   out_len bytes.  The block is compatible with LZ4_decompress_safe() of
+ *   the reference implementation.
+ *
+ *   The compressed block is never larger than LZ4_COMPRESSBOUND(in_len).
+ *   Passing a smaller out_len, e.g. in_len - 1, gives up as soon as the
+ *   data turns out not to be compressible.
+ *
+ *   htab is the scratch hash table of the compressor.  It is not cleared:
+ *   what a previous call left there may change the output, which always
+ *   decompresses to the same data.  The buffers must not overlap.
+ *
+ * Returned Value:
+ *   The size of the compressed block, or 0 if it does not fit in out_len
+ *   bytes.
+ *
+ ****************************************************************************/
+
+size_t lz4_compress(FAR const void *in_data, size_t in_len,
+                    FAR void *out_data, size_t out_len, lz4_state_t htab);
+
+/****************************************************************************
+ * Name: lz4_decompress
+ *
+ * Description:
+ *   Decompress the LZ4 block of in_len bytes at in_data to out_data, up to
+ *   out_len bytes.  Corrupted input is detected and never causes accesses
+ *   out of the buffers.
+ *
+ * Returned Value:
+ *   The size of the decompressed data.  0 is returned and errno is set to
+ *   E2BIG if the data does not fit in out_len bytes, or to EINVAL if the
+ *   block is corrupted.
+ *
+ ****************************************************************************/
+
+size_t lz4_decompress(FAR const void *in_data, size_t in_len,
+                      FAR void *out_data, size_t out_len);
+
+/****************************************************************************
+ * Name: lz4_frame_header
+ *
+ * Description:
+ *   Write the header of an LZ4 frame of independent blocks of at most
+ *   blocksize bytes, without checksums nor content size, to out_data,
+ *   which must have room for LZ4_FRAME_HDR_SIZE bytes.
+ *
+ *   The frame is made of this header, of the blocks written by
+ *   lz4_frame_block() and of an end mark of LZ4_BLOCK_HDR_SIZE zero bytes.
+ *
+ * Returned Value:
+ *   The size of the header, LZ4_FRAME_HDR_SIZE.
+ *
+ ****************************************************************************/
+
+size_t lz4_frame_header(FAR void *out_data, size_t blocksize);
+
+/****************************************************************************
+ * Name: lz4_frame_block
+ *
+ * Description:
+ *   Compress the in_len bytes at in_data, at most the block size of the
+ *   frame, into a block of an LZ4 frame at out_data.  The block is stored
+ *   uncompressed if it does not compress, so out_data must have room for
+ *   LZ4_BLOCK_HDR_SIZE + in_len bytes.
+ *
+ * Returned Value:
+ *   The size of the block with its header.
+ *
+ ****************************************************************************/
+
+size_t lz4_frame_block(FAR const void *in_data, size_t in_len,
+                       FAR void *out_data, lz4_state_t htab);
+
+/****************************************************************************
+ * Name: lz4_frame_decompress
+ *
+ * Description:
+ *   Decompress the LZ4 frames of in_len bytes at in_data, as written by
+ *   lz4_frame_header() and lz4_frame_block() or by the lz4 tool, to
+ *   out_data, up to out_len bytes.  Linked and independent blocks are
+ *   supported, the checksums are verified and skippable frames are
+ *   skipped.  Frames with a dictionary are not supported.
+ *
+ * Returned Value:
+ *   The size of the decompressed data.  0 is returned and errno is set to
+ *   E2BIG if the data does not fit in out_len bytes, to EINVAL if a frame
+ *   is corrupted, or to ENOTSUP for a frame with a dictionary.
+ *
+ ****************************************************************************/
+
+size_t lz4_frame_decompress(FAR const void *in_data, size_t in_len,
+                            FAR void *out_data, size_t out_len);
+
+#endif /* CONFIG_LIBC_LZ4 */
+#endif /* __INCLUDE_LZ4_H */
@@ -110,6 +110,7 @@
 #define _PCIBASE        (0x4100) /* Pci ioctl commands */
 #define _I3CBASE        (0x4200) /* I3C driver ioctl commands */
 #define _MSIOCBASE      (0x4300) /* Mouse ioctl commands */
+#define _PERFIOCBASE    (0x4400) /* Perf events ioctl commands */
 #define _WLIOCBASE      (0x8b00) /* Wireless modules ioctl network commands */
 
 /* boardctl() commands share the same number space */
@@ -748,6 +749,13 @@
 #define _I3CIOCVALID(c)   (_IOC_TYPE(c)==_I3CBASE)
 #define _I3CIOC(nr)       _IOC(_I3CBASE,nr)
 
+/* Perf events ioctl definitions ********************************************/
+
+/* see nuttx/include/nuttx/perf.h */
+
+#define _PERFIOCVALID(c)  (_IOC_TYPE(c)==_PERFIOCBASE)
+#define _PERFIOC(nr)      _IOC(_PERFIOCBASE,nr)
+
 /* Force Feedback driver command definitions ********************************/
 
 /* see nuttx/include/input/ff.h */
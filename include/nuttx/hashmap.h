@@ -0,0 +1,242 @@
+/****************************************************************************
+ * include/nuttx/hashmap.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_HASHMAP_H
+#define __INCLUDE_NUTTX_HASHMAP_H
+
+/* A growable hash map of key and data pointers, with open addressing and
+ * Robin Hood probing:  the entries are kept in one array, and lookups read
+ * a few consecutive slots instead of following lists.
+ *
+ * The map grows by doubling, incrementally:  while the entries of the old
+ * array are moved to the new one, a few at a time by each insertion and
+ * removal, lookups search both.  No operation pays for moving the whole
+ * map at once.
+ *
+ * Note about locking:  the map is not locked, the user serializes the
+ * accesses.  hashmap_find() does not modify the map and may be called
+ * concurrently by readers.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define HASHMAP_INITIALIZER(hash, cmp) { NULL, NULL, hash, cmp }
+
+/* The number of entries in the map */
+
+#define hashmap_count(map) ((map)->count)
+
+/* Iterate over all the entries of the map, in no particular order.  The
+ * map must not be modified meanwhile.
+ */
+
+#define hashmap_for_every(map, iter, key, data) \
+  for ((iter) = 0; hashmap_next(map, &(iter), &(key), &(data)); )
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Hash of a key, and comparison of two keys:  0 if they are equal */
+
+typedef CODE uint32_t (*hashmap_hash_t)(FAR const void *key);
+typedef CODE int (*hashmap_cmp_t)(FAR const void *key1,
+                                  FAR const void *key2);
+
+/* A slot of the map:  hash is 0 in an empty slot */
+
+struct hashmap_slot_s
+{
+  uint32_t  hash;              /* The scrambled hash of the key */
+  FAR void *key;               /* The key */
+  FAR void *data;              /* The data of the entry */
+};
+
+/* This structure describes a hash map */
+
+struct hashmap_s
+{
+  FAR struct hashmap_slot_s *slots; /* The array of 1 << bits slots */
+  FAR struct hashmap_slot_s *old;   /* The array being moved, or NULL */
+  hashmap_hash_t hash;              /* Hash of the keys, NULL: the pointer */
+  hashmap_cmp_t  cmp;               /* Compare the keys, NULL: the pointer */
+  size_t         count;             /* The number of entries */
+  size_t         oldcount;          /* The entries left in old */
+  size_t         migrate;           /* The next slot of old to move */
+  uint8_t        bits;              /* Log2 of the number of slots */
+  uint8_t        oldbits;           /* Log2 of the number of old slots */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: hashmap_init
+ *
+ * Description:
+ *   Initialize a hash map.
+ *
+ * Input Parameters:
+ *   map  - Address of the hash map to be used.
+ *   nel  - The number of entries to make room for, the map grows beyond as
+ *          needed.  If 0, nothing is allocated until the first insertion.
+ *   hash - The hash function of the keys.  If NULL, the key pointers are
+ *          the keys, e.g. integers cast to pointers, and are hashed.
+ *   cmp  - The comparison function of the keys.  If NULL, the key
+ *          pointers are compared.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int hashmap_init(FAR struct hashmap_s *map, size_t nel,
+                 hashmap_hash_t hash, hashmap_cmp_t cmp);
+
+/****************************************************************************
+ * Name: hashmap_uninit
+ *
+ * Description:
+ *   Free the memory of a hash map.  The keys and the data of the entries
+ *   are not freed.
+ *
+ * Input Parameters:
+ *   map - Address of the hash map to be used.
+ *
+ ****************************************************************************/
+
+void hashmap_uninit(FAR struct hashmap_s *map);
+
+/****************************************************************************
+ * Name: hashmap_insert
+ *
+ * Description:
+ *   Insert an entry.  The key is not copied, it must stay unchanged while
+ *   the entry is in the map.
+ *
+ * Input Parameters:
+ *   map  - Address of the hash map to be used.
+ *   key  - The key of the entry.
+ *   data - The data of the entry.
+ *
+ * Returned Value:
+ *   Zero on success; -EEXIST if the key is already in the map, which is
+ *   left unchanged, or -ENOMEM.
+ *
+ ****************************************************************************/
+
+int hashmap_insert(FAR struct hashmap_s *map, FAR void *key,
+                   FAR void *data);
+
+/****************************************************************************
+ * Name: hashmap_find
+ *
+ * Description:
+ *   Look up a key.
+ *
+ * Input Parameters:
+ *   map - Address of the hash map to be used.
+ *   key - The key to look up.
+ *
+ * Returned Value:
+ *   The data of the entry, or NULL if the key is not in the map.
+ *
+ ****************************************************************************/
+
+FAR void *hashmap_find(FAR const struct hashmap_s *map,
+                       FAR const void *key);
+
+/****************************************************************************
+ * Name: hashmap_remove
+ *
+ * Description:
+ *   Remove the entry of a key.
+ *
+ * Input Parameters:
+ *   map - Address of the hash map to be used.
+ *   key - The key of the entry to remove.
+ *
+ * Returned Value:
+ *   The data of the removed entry, or NULL if the key is not in the map.
+ *
+ ****************************************************************************/
+
+FAR void *hashmap_remove(FAR struct hashmap_s *map, FAR const void *key);
+
+/****************************************************************************
+ * Name: hashmap_next
+ *
+ * Description:
+ *   Get the next entry of an iteration over the map, see
+ *   hashmap_for_every().
+ *
+ * Input Parameters:
+ *   map  - Address of the hash map to be used.
+ *   iter - The position of the iteration, 0 to start it.
+ *   key  - The location to return the key of the entry.
+ *   data - The location to return the data of the entry.
+ *
+ * Returned Value:
+ *   True if an entry is returned, false at the end of the map.
+ *
+ ****************************************************************************/
+
+bool hashmap_next(FAR const struct hashmap_s *map, FAR size_t *iter,
+                  FAR void **key, FAR void **data);
+
+/****************************************************************************
+ * Name: hashmap_strhash and hashmap_strcmp
+ *
+ * Description:
+ *   The hash and comparison functions of string keys.
+ *
+ ****************************************************************************/
+
+uint32_t hashmap_strhash(FAR const void *key);
+int hashmap_strcmp(FAR const void *key1, FAR const void *key2);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_HASHMAP_H */
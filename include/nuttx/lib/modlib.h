@@ -169,6 +169,9 @@ struct module_s
   uint16_t nsect;                      /* Number of entries in sectalloc array */
 #endif
   int dynamic;                         /* Module is a dynamic shared object */
+#ifdef CONFIG_MODLIB_LOADSYMS
+  FAR char *strtab;                    /* String table of the exported names */
+#endif
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MODULE)
   size_t textsize;                     /* Size of the kernel .text memory allocation */
   size_t datasize;                     /* Size of the kernel .bss/.data memory allocation */
@@ -236,6 +239,18 @@ struct mod_loadinfo_s
   int           filfd;       /* Descriptor for the file being loaded */
   int           nexports;    /* ET_DYN - Number of symbols exported */
   int           gotindex;    /* Index to the GOT section */
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+  FAR const char *filename;  /* Path of the file being loaded */
+  struct timespec filemtime; /* Modification time of the file */
+  ino_t         fileino;     /* Serial number of the file */
+  bool          textshared;  /* textalloc is shared with other instances */
+#endif
+#ifdef CONFIG_MODLIB_LOADSYMS
+  FAR Elf_Sym  *symtab;      /* Symbol table in memory, with resolved values */
+  FAR uint8_t  *symresolved; /* Bitmap of the symbols already resolved */
+  FAR const char *strtab;    /* Symbol string table in memory */
+  bool          strmapped;   /* strtab points in the mapped file */
+#endif
   uintptr_t     xipbase;     /* if elf is position independent, and use
                               * romfs/tmps, we can try get xipbase,
                               * skip the copy.
@@ -129,6 +129,7 @@ struct iob_s
 
 #ifdef CONFIG_IOB_ALLOC
   iob_free_cb_t io_free;  /* Custom free callback */
+  FAR void     *io_freearg; /* Argument of io_free, io_data by default */
   FAR uint8_t  *io_data;
 #else
   uint8_t       io_data[CONFIG_IOB_BUFSIZE];
@@ -260,7 +261,9 @@ FAR struct iob_s *iob_alloc_dynamic(uint16_t size);
  *   size    - The size of the data parameter
  *   free_cb - Notify the caller when the iob is freed. The caller can
  *             perform additional operations on the data before it is freed.
- *             The free_cb is called when the iob is freed.
+ *             The free_cb is called when the iob is freed, with io_freearg
+ *             as its argument.  io_freearg is initialized to data and may
+ *             be changed by the caller.
  *
  ****************************************************************************/
 
@@ -32,10 +32,12 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/signal.h>
 #include <nuttx/list.h>
+#include <nuttx/spinlock.h>
 
 #include <sys/types.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <mqueue.h>
 #include <poll.h>
 
@@ -94,6 +96,10 @@
 #  define MQ_WNELIST(cmn)             (&((cmn).waitfornotempty))
 #  define MQ_WNFLIST(cmn)             (&((cmn).waitfornotfull))
 
+#ifdef CONFIG_MQ_PRIO_BUCKETS
+#  define MQ_PRIO_NWORDS              ((_POSIX_MQ_PRIO_MAX + 32) / 32)
+#endif
+
 /****************************************************************************
  * Public Type Declarations
  ****************************************************************************/
@@ -115,6 +121,14 @@ struct mqueue_inode_s
   struct mqueue_cmn_s cmn;    /* Common prologue */
   FAR struct inode *inode;    /* Containing inode */
   struct list_node msglist;   /* Prioritized message list */
+#ifdef CONFIG_MQ_PRIO_BUCKETS
+  uint32_t prioset[MQ_PRIO_NWORDS]; /* Priorities present in msglist */
+  FAR struct list_node *priotail[_POSIX_MQ_PRIO_MAX + 1]; /* Last of each */
+#endif
+#ifdef CONFIG_MQ_PERQUEUE_MSGS
+  struct list_node msgfree;   /* Free pre-allocated messages of the queue */
+  spinlock_t freelock;        /* Protects msgfree */
+#endif
   int16_t maxmsgs;            /* Maximum number of messages in the queue */
   int16_t nmsgs;              /* Number of message in the queue */
 #if CONFIG_MQ_MAXMSGSIZE < 256
@@ -41,6 +41,18 @@
                                 SEM_PRIO_INHERIT), NXMUTEX_NO_HOLDER}
 #define NXRMUTEX_INITIALIZER   {NXMUTEX_INITIALIZER, 0}
 
+/* A mutex held for short times by threads of different CPUs, the waiters
+ * spin while the holder is running instead of sleeping at once.
+ */
+
+#ifdef CONFIG_LIBC_MUTEX_ADAPTIVE
+#  define NXMUTEX_ADAPTIVE_INITIALIZER \
+                               {NXSEM_INITIALIZER(1, SEM_TYPE_MUTEX | \
+                                SEM_PRIO_INHERIT), NXMUTEX_NO_HOLDER, true}
+#else
+#  define NXMUTEX_ADAPTIVE_INITIALIZER NXMUTEX_INITIALIZER
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -49,6 +61,9 @@ struct mutex_s
 {
   sem_t sem;
   pid_t holder;
+#ifdef CONFIG_LIBC_MUTEX_ADAPTIVE
+  bool adaptive;        /* Spin while the holder runs on another CPU */
+#endif
 #if CONFIG_LIBC_MUTEX_BACKTRACE > 0
   FAR void *backtrace[CONFIG_LIBC_MUTEX_BACKTRACE];
 #endif
@@ -64,6 +79,17 @@ struct rmutex_s
 
 typedef struct rmutex_s rmutex_t;
 
+#ifdef CONFIG_LIBC_MUTEX_ADAPTIVE
+/* The contention statistics of all the adaptive mutexes */
+
+struct nxmutex_stats_s
+{
+  uint32_t contended;   /* Lock attempts that found the mutex locked */
+  uint32_t spun;        /* ... and acquired it while spinning */
+  uint32_t slept;       /* ... and had to sleep */
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -360,6 +386,41 @@ int nxmutex_restorelock(FAR mutex_t *mutex, unsigned int locked);
 
 int nxmutex_set_protocol(FAR mutex_t *mutex, int protocol);
 
+/****************************************************************************
+ * Name: nxmutex_set_adaptive
+ *
+ * Description:
+ *   Select whether nxmutex_lock() spins, while the holder of the mutex is
+ *   running on another CPU, before it sleeps.  This is worth it only for
+ *   mutexes held for short times.
+ *
+ * Parameters:
+ *   mutex    - mutex descriptor.
+ *   adaptive - true to spin before sleeping.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_MUTEX_ADAPTIVE
+void nxmutex_set_adaptive(FAR mutex_t *mutex, bool adaptive);
+#else
+#  define nxmutex_set_adaptive(mutex, adaptive)
+#endif
+
+/****************************************************************************
+ * Name: nxmutex_get_stats
+ *
+ * Description:
+ *   Return the contention statistics of the adaptive mutexes since boot.
+ *
+ * Parameters:
+ *   stats - Location to return the statistics.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_MUTEX_ADAPTIVE
+void nxmutex_get_stats(FAR struct nxmutex_stats_s *stats);
+#endif
+
 /****************************************************************************
  * Name: nxmutex_getprioceiling
  *
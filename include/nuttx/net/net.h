@@ -51,6 +51,13 @@
 #define SOCKCAP_NONBLOCKING (1 << 0)  /* Bit 0: Socket supports non-blocking
                                        *        operation. */
 
+/* Kernel internal flag of psock_accept():  fail with EAGAIN rather than
+ * wait for a connection, whatever the blocking mode of the listening
+ * socket.  accept4() rejects it from the applications.
+ */
+
+#define SOCK_ACCEPT_DONTWAIT 0x40000000
+
 /* Definitions of 8-bit socket flags */
 
 #define _SF_INITD           0x01  /* Bit 0: Socket structure is initialized */
@@ -220,6 +227,13 @@ struct socket_conn_s
   uint8_t       s_boundto;   /* Index of the interface we are bound to.
                               * Unbound: 0, Bound: 1-MAX_IFINDEX */
 #  endif
+#  ifdef CONFIG_NET_SEND_ZEROCOPY
+  uint32_t      s_zcnext;    /* Id of the next MSG_ZEROCOPY send */
+  uint32_t      s_zcdone;    /* Completed sends not yet reported */
+  sq_queue_t    s_zcq;       /* MSG_ZEROCOPY sends not yet reported */
+  sq_entry_t    s_zcnode;    /* Entry in the completions to notify */
+  bool          s_zcnotify;  /* s_zcnode is queued */
+#  endif
 #endif
 
   /* Definitions of 8-bit socket flags */
@@ -579,6 +593,26 @@ FAR struct iob_s *net_ioballoc(bool throttled);
 
 int sockfd_allocate(FAR struct socket *psock, int oflags);
 
+/****************************************************************************
+ * Name: sockfd_allocate_from_tcb
+ *
+ * Description:
+ *   Allocate a socket descriptor in the file list of another task.
+ *
+ * Input Parameters:
+ *   tcb      The task that will own the descriptor.
+ *   psock    A pointer to socket structure.
+ *   oflags   Open mode flags.
+ *
+ * Returned Value:
+ *   Returns the file descriptor == index into the files array of the task.
+ *
+ ****************************************************************************/
+
+struct tcb_s;
+int sockfd_allocate_from_tcb(FAR struct tcb_s *tcb,
+                             FAR struct socket *psock, int oflags);
+
 /****************************************************************************
  * Name: sockfd_socket
  *
@@ -751,7 +785,8 @@ int psock_listen(FAR struct socket *psock, int backlog);
  *   not marked as non-blocking, psock_accept blocks the caller until a
  *   connection is present. If the socket is marked non-blocking and no
  *   pending connections are present on the queue, psock_accept returns
- *   EAGAIN.
+ *   EAGAIN.  So does it with SOCK_ACCEPT_DONTWAIT in flags, for the
+ *   kernel users that must not block on a shared listening socket.
  *
  * Input Parameters:
  *   psock    Reference to the listening socket structure
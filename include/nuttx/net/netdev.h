@@ -174,6 +174,22 @@
 #  define NETDEV_TXTIMEOUTS(dev)  _NETDEV_ERROR(dev,tx_timeouts)
 #  define NETDEV_ERRORS(dev)      _NETDEV_STATISTIC(dev,errors)
 
+#  ifdef CONFIG_NETDEV_RPS
+#    define NETDEV_RPS_QUEUED(dev,cpu) \
+       _NETDEV_STATISTIC(dev,rps_queued[cpu])
+#    define NETDEV_RPS_PROCESSED(dev,cpu) \
+       _NETDEV_STATISTIC(dev,rps_processed[cpu])
+#    define NETDEV_RPS_DROPPED(dev,cpu) \
+       _NETDEV_STATISTIC(dev,rps_dropped[cpu])
+#    define NETDEV_RPS_FLOW(dev,cpu) \
+       _NETDEV_STATISTIC(dev,rps_flow[cpu])
+#  else
+#    define NETDEV_RPS_QUEUED(dev,cpu)
+#    define NETDEV_RPS_PROCESSED(dev,cpu)
+#    define NETDEV_RPS_DROPPED(dev,cpu)
+#    define NETDEV_RPS_FLOW(dev,cpu)
+#  endif
+
 #else
 #  define NETDEV_RESET_STATISTICS(dev)
 #  define NETDEV_RXPACKETS(dev)
@@ -190,6 +206,11 @@
 #  define NETDEV_TXTIMEOUTS(dev)
 
 #  define NETDEV_ERRORS(dev)
+
+#  define NETDEV_RPS_QUEUED(dev,cpu)
+#  define NETDEV_RPS_PROCESSED(dev,cpu)
+#  define NETDEV_RPS_DROPPED(dev,cpu)
+#  define NETDEV_RPS_FLOW(dev,cpu)
 #endif
 
 /* There are some helper pointers for accessing the contents of the IP
@@ -257,6 +278,15 @@ struct netdev_statistics_s
 
   uint32_t errors;         /* Total number of errors */
 
+#ifdef CONFIG_NETDEV_RPS
+  /* Receive packet steering, per CPU */
+
+  uint32_t rps_queued[CONFIG_SMP_NCPUS];    /* Packets steered to the CPU */
+  uint32_t rps_processed[CONFIG_SMP_NCPUS]; /* Packets input on the CPU */
+  uint32_t rps_dropped[CONFIG_SMP_NCPUS];   /* Dropped, backlog was full */
+  uint32_t rps_flow[CONFIG_SMP_NCPUS];      /* Steered by the flow table */
+#endif
+
 #if CONFIG_NETDEV_STATISTICS_LOG_PERIOD > 0
   struct work_s logwork;   /* For periodic log work */
 #endif
@@ -1347,4 +1377,51 @@ int netdev_ipv6_foreach(FAR struct net_driver_s *dev,
 void netdev_statistics_log(FAR void *arg);
 #endif
 
+/****************************************************************************
+ * Name: netdev_rss_hash
+ *
+ * Description:
+ *   Calculate the hash of a flow, the same one as that provided to the
+ *   driver with SIOCNOTIFYRECVCPU.  The local address and port are the
+ *   source of the flow.
+ *
+ * Input Parameters:
+ *   domain   - The layer 3 protocol, PF_INET/PF_INET6
+ *   src_addr - The local address, in_addr_t or net_ipv6addr_t
+ *   src_port - The local port, in network order
+ *   dst_addr - The remote address, in_addr_t or net_ipv6addr_t
+ *   dst_port - The remote port, in network order
+ *
+ * Returned Value:
+ *  The hash value
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RSS
+uint32_t netdev_rss_hash(uint8_t domain,
+                         FAR const void *src_addr, uint16_t src_port,
+                         FAR const void *dst_addr, uint16_t dst_port);
+#endif
+
+/****************************************************************************
+ * Name: netdev_rss_porthash
+ *
+ * Description:
+ *   Calculate the hash of all the flows to a local port, the one provided
+ *   to the driver with SIOCNOTIFYRECVCPU for the sockets bound to
+ *   INADDR_ANY/in6addr_any or not connected.
+ *
+ * Input Parameters:
+ *   domain   - The layer 3 protocol, PF_INET/PF_INET6
+ *   src_port - The local port, in network order
+ *
+ * Returned Value:
+ *  The hash value
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RSS
+uint32_t netdev_rss_porthash(uint8_t domain, uint16_t src_port);
+#endif
+
 #endif /* __INCLUDE_NUTTX_NET_NETDEV_H */
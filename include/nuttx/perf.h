@@ -704,6 +704,16 @@ enum perf_event_type_e
   PERF_RECORD_MAX,      /* non-ABI */
 };
 
+/* The PERF_SAMPLE_CALLCHAIN part of a sample:  the number of return
+ * addresses, innermost first, then the addresses.
+ */
+
+struct perf_callchain_entry
+{
+  uint64_t nr;
+  uint64_t ip[];
+};
+
 struct perf_sample_data_s
 {
 /* Fields set by perf_sample_data_init() unconditionally,
@@ -806,13 +816,16 @@ int perf_event_open(FAR struct perf_event_attr_s *attr, pid_t pid,
  * Name: perf_event_overflow
  *
  * Description:
- *   Perf event overflow handler
+ *   Called by a PMU driver from its overflow interrupt, after the counter
+ *   of a sampling event has been updated and reloaded with its period.
+ *   A sample of the interrupted code is recorded in the ring buffer of the
+ *   event.
  *
  * Input Parameters:
  *   event - Perf event
  *
  * Returned Value:
- *   Result
+ *   Non-zero if the PMU driver should stop the event.
  *
  ****************************************************************************/
 
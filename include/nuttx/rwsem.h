@@ -36,6 +36,9 @@
 #define RWSEM_NO_HOLDER     ((pid_t)-1)
 #define RWSEM_INITIALIZER   {NXMUTEX_INITIALIZER, SEM_INITIALIZER(0), \
                              RWSEM_NO_HOLDER, 0, 0, 0}
+#define RWSEM_ADAPTIVE_INITIALIZER \
+                            {NXMUTEX_ADAPTIVE_INITIALIZER, \
+                             SEM_INITIALIZER(0), RWSEM_NO_HOLDER, 0, 0, 0}
 
 /****************************************************************************
  * Public Type Definitions
@@ -100,6 +100,10 @@
 #  define CONFIG_SCHED_CRITMONITOR_MAXTIME_WDOG -1
 #endif
 
+#ifndef CONFIG_SCHED_CRITMONITOR_CSECTION_SITES
+#  define CONFIG_SCHED_CRITMONITOR_CSECTION_SITES 0
+#endif
+
 /* Task Management Definitions **********************************************/
 
 /* Special task IDS.  Any negative PID is invalid. */
@@ -123,6 +127,7 @@
 #  define TCB_FLAG_SCHED_FIFO      (0 << TCB_FLAG_POLICY_SHIFT)  /* FIFO scheding policy */
 #  define TCB_FLAG_SCHED_RR        (1 << TCB_FLAG_POLICY_SHIFT)  /* Round robin scheding policy */
 #  define TCB_FLAG_SCHED_SPORADIC  (2 << TCB_FLAG_POLICY_SHIFT)  /* Sporadic scheding policy */
+#  define TCB_FLAG_SCHED_DEADLINE  (3 << TCB_FLAG_POLICY_SHIFT)  /* Deadline scheding policy */
 #define TCB_FLAG_CPU_LOCKED        (1 << 5)                      /* Bit 5: Locked to this CPU */
 #define TCB_FLAG_SIGNAL_ACTION     (1 << 6)                      /* Bit 6: In a signal handler */
 #define TCB_FLAG_SYSCALL           (1 << 7)                      /* Bit 7: In a system call */
@@ -160,6 +165,13 @@
 #define SPORADIC_FLAG_REPLENISH    (1 << 2)                      /* Bit 2: Replenishment cycle */
                                                                  /* Bits 3-7: Available */
 
+/* Deadline scheduler flags */
+
+#define DEADLINE_FLAG_THROTTLED    (1 << 0)                      /* Bit 0: Budget exhausted */
+#define DEADLINE_FLAG_DONE         (1 << 1)                      /* Bit 1: Job completed */
+#define DEADLINE_FLAG_ATDEADLINE   (1 << 2)                      /* Bit 2: Timer set to the deadline */
+                                                                 /* Bits 3-7: Available */
+
 /* Most internal nxsched_* interfaces are not available in the user space in
  * PROTECTED and KERNEL builds.  In that context, the application semaphore
  * interfaces must be used.  The differences between the two sets of
@@ -369,6 +381,33 @@ struct sporadic_s
 
 #endif /* CONFIG_SCHED_SPORADIC */
 
+/* struct deadline_s ********************************************************/
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/* This structure is an allocated "plug-in" to the main TCB structure, like
+ * struct sporadic_s.  It holds the parameters and the state of a thread
+ * with the deadline scheduling policy.  All times are in system ticks.
+ */
+
+struct deadline_s
+{
+  FAR struct tcb_s *tcb;            /* The parent TCB structure              */
+  struct wdog_s timer;              /* Deadline and period timer             */
+  clock_t   runtime;                /* Execution budget per period           */
+  clock_t   deadline;               /* Relative deadline                     */
+  clock_t   period;                 /* Activation period                     */
+  clock_t   release;                /* Start of the current period           */
+  clock_t   absdeadline;            /* Absolute deadline of the current job  */
+  clock_t   budget;                 /* Budget remaining in the period        */
+  uint32_t  bandwidth;              /* runtime / period, in 1/65536          */
+  uint32_t  misses;                 /* Number of deadlines missed            */
+  uint32_t  throttled;              /* Number of budgets exhausted           */
+  uint8_t   flags;                  /* See DEADLINE_FLAG_* definitions       */
+};
+
+#endif /* CONFIG_SCHED_DEADLINE */
+
 /* struct child_status_s ****************************************************/
 
 /* This structure is used to maintain information about child tasks.
@@ -581,6 +620,10 @@ struct task_group_s
  * definitions.
  */
 
+#ifdef CONFIG_SCHED_PERF_EVENTS
+struct perf_event_context_s;
+#endif
+
 struct tcb_s
 {
   /* Fields used to support list management *********************************/
@@ -649,6 +692,9 @@ struct tcb_s
 #ifdef CONFIG_SCHED_SPORADIC
   FAR struct sporadic_s *sporadic;       /* Sporadic scheduling parameters  */
 #endif
+#ifdef CONFIG_SCHED_DEADLINE
+  FAR struct deadline_s *deadline;       /* Deadline scheduling parameters  */
+#endif
 
   struct wdog_s waitdog;                 /* All timed waits use this timer  */
 
@@ -730,6 +776,11 @@ struct tcb_s
   char name[CONFIG_TASK_NAME_SIZE + 1];  /* Task name (with NUL terminator) */
 #endif
 
+#ifdef CONFIG_SCHED_PERF_EVENTS
+  FAR struct perf_event_context_s *perf_event_ctx; /* Perf events context */
+  mutex_t perf_event_mutex;              /* Protects perf_event_ctx         */
+#endif
+
 #if CONFIG_SCHED_STACK_RECORD > 0
   FAR void *stackrecord_pc[CONFIG_SCHED_STACK_RECORD];
   FAR void *stackrecord_sp[CONFIG_SCHED_STACK_RECORD];
@@ -829,15 +880,37 @@ begin_packed_struct struct tcbinfo_s
   end_packed_struct reg_off; /* Refer to https://sourceware.org/gdb/current/onlinedocs/gdb.html/Standard-Target-Features.html */
 } end_packed_struct;
 
+/* The time spent in the critical section from one call site */
+
+#if CONFIG_SCHED_CRITMONITOR_CSECTION_SITES > 0
+struct critmon_site_s
+{
+  FAR void *caller;                      /* Caller of enter_critical_section */
+  uint32_t  count;                       /* Number of entries               */
+  clock_t   total;                       /* Total holding time              */
+  clock_t   max;                         /* Maximum holding time            */
+};
+#endif
+
+/* The time run by one thread, see nxsched_critmon_cputime() */
+
+#if CONFIG_SCHED_CRITMONITOR_MAXTIME_THREAD >= 0
+struct critmon_cputime_s
+{
+  pid_t     pid;                         /* Thread ID                       */
+  clock_t   runtime;                     /* Total time thread run           */
+};
+#endif
+
 /* This is the callback type used by nxsched_foreach() */
 
 typedef CODE void (*nxsched_foreach_t)(FAR struct tcb_s *tcb, FAR void *arg);
 
 /* This is the callback type used by nxsched_smp_call() */
 
-#ifdef CONFIG_SMP
 typedef CODE int (*nxsched_smp_call_t)(FAR void *arg);
 
+#ifdef CONFIG_SMP
 struct smp_call_cookie_s;
 struct smp_call_data_s
 {
@@ -874,6 +947,14 @@ EXTERN clock_t g_premp_max[CONFIG_SMP_NCPUS];
 EXTERN clock_t g_crit_max[CONFIG_SMP_NCPUS];
 #endif /* CONFIG_SCHED_CRITMONITOR_MAXTIME_CSECTION >= 0 */
 
+/* Critical section entries that could not be profiled, the table of call
+ * sites being full.
+ */
+
+#if CONFIG_SCHED_CRITMONITOR_CSECTION_SITES > 0
+EXTERN uint32_t g_crit_sites_dropped;
+#endif
+
 /* g_running_tasks[] holds a references to the running task for each CPU.
  * It is valid only when up_interrupt_context() returns true.
  */
@@ -923,6 +1004,71 @@ FAR struct tcb_s *nxsched_self(void);
 
 void nxsched_foreach(nxsched_foreach_t handler, FAR void *arg);
 
+/****************************************************************************
+ * Name: nxsched_critmon_sites
+ *
+ * Description:
+ *   Return the call sites of enter_critical_section() that held the
+ *   critical section the longest in total, in decreasing order.
+ *
+ * Input Parameters:
+ *   sites  - The array receiving the call sites
+ *   nsites - The size of the array
+ *
+ * Returned Value:
+ *   The number of call sites returned.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_CRITMONITOR_CSECTION_SITES > 0
+int nxsched_critmon_sites(FAR struct critmon_site_s *sites, int nsites);
+#endif
+
+/****************************************************************************
+ * Name: nxsched_critmon_runtime
+ *
+ * Description:
+ *   Return the total time a thread has run, in perf_gettime() units,
+ *   including the time elapsed since it was last resumed if it is running.
+ *   The caller must hold the critical section.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread
+ *
+ * Returned Value:
+ *   The run time of the thread.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_CRITMONITOR_MAXTIME_THREAD >= 0
+clock_t nxsched_critmon_runtime(FAR struct tcb_s *tcb);
+#endif
+
+/****************************************************************************
+ * Name: nxsched_critmon_cputime
+ *
+ * Description:
+ *   Take a snapshot of the run time of all the threads, as a top-like tool
+ *   needs:  all the run times are read at the same instant, within one
+ *   critical section.
+ *
+ * Input Parameters:
+ *   snap  - The array receiving the run time of each thread, may be NULL
+ *           if nsnap is zero
+ *   nsnap - The size of the array
+ *   now   - If not NULL, receives the perf_gettime() time of the snapshot
+ *
+ * Returned Value:
+ *   The number of threads, which may exceed nsnap.  Only the first nsnap
+ *   are returned.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_CRITMONITOR_MAXTIME_THREAD >= 0
+int nxsched_critmon_cputime(FAR struct critmon_cputime_s *snap, int nsnap,
+                            FAR clock_t *now);
+#endif
+
 /****************************************************************************
  * Name: nxsched_get_tcb
  *
@@ -941,6 +1087,20 @@ void nxsched_foreach(nxsched_foreach_t handler, FAR void *arg);
 
 FAR struct tcb_s *nxsched_get_tcb(pid_t pid);
 
+/****************************************************************************
+ * Name: nxsched_is_running
+ *
+ * Description:
+ *   Return true if the thread of a task ID is running on a CPU.  No lock is
+ *   taken, the answer is only a hint that may be stale when it is returned:
+ *   this is what the adaptive mutexes need to decide whether to spin.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_MUTEX_ADAPTIVE
+bool nxsched_is_running(pid_t pid);
+#endif
+
 /****************************************************************************
  * Name:  nxsched_releasepid
  *
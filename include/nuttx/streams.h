@@ -32,6 +32,10 @@
 #ifdef CONFIG_LIBC_LZF
 #  include <lzf.h>
 #endif
+#ifdef CONFIG_LIBC_LZ4
+#  include <lz4.h>
+#endif
+#include <stdbool.h>
 #include <stdio.h>
 #ifndef CONFIG_DISABLE_MOUNTPOINT
 #  include <nuttx/fs/fs.h>
@@ -68,6 +72,10 @@
 #define LZF_STREAM_BLOCKSIZE  ((1 << CONFIG_STREAM_LZF_BLOG) - 1)
 #endif
 
+#ifdef CONFIG_LIBC_LZ4
+#define LZ4_STREAM_BLOCKSIZE  (1 << CONFIG_STREAM_LZ4_BLOG)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -290,6 +298,21 @@ struct lib_lzfoutstream_s
 };
 #endif
 
+/* LZ4 compressed stream pipeline */
+
+#ifdef CONFIG_LIBC_LZ4
+struct lib_lz4outstream_s
+{
+  struct lib_outstream_s      common;
+  FAR struct lib_outstream_s *backend;
+  lz4_state_t                 state;
+  off_t                       offset;
+  bool                        inframe; /* The frame header is written */
+  char                        in[LZ4_STREAM_BLOCKSIZE];
+  char                        out[LZ4_BLOCK_HDR_SIZE + LZ4_STREAM_BLOCKSIZE];
+};
+#endif
+
 #ifndef CONFIG_DISABLE_MOUNTPOINT
 struct lib_blkoutstream_s
 {
@@ -606,6 +629,29 @@ void lib_lzfoutstream(FAR struct lib_lzfoutstream_s *stream,
                       FAR struct lib_outstream_s *backend);
 #endif
 
+/****************************************************************************
+ * Name: lib_lz4outstream
+ *
+ * Description:
+ *  LZ4 compressed pipeline stream.  The output is a sequence of LZ4 frames
+ *  that the lz4 tool decompresses:  a frame is ended by each flush, the
+ *  next output starts a new one.
+ *
+ * Input Parameters:
+ *   stream  - User allocated, uninitialized instance of struct
+ *                lib_lz4outstream_s to be initialized.
+ *   backend - Stream backend port.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_LZ4
+void lib_lz4outstream(FAR struct lib_lz4outstream_s *stream,
+                      FAR struct lib_outstream_s *backend);
+#endif
+
 /****************************************************************************
  * Name: lib_blkoutstream_open
  *
@@ -144,6 +144,9 @@ struct task_info_s
 #endif
 #ifdef CONFIG_FILE_STREAM
   struct streamlist ta_streamlist; /* Holds C buffered I/O info */
+#  ifdef CONFIG_STDIO_LOCK_ELISION
+  bool            ta_threaded; /* A pthread was created, lock the streams */
+#  endif
 #endif
 
 #ifdef CONFIG_PTHREAD_ATFORK
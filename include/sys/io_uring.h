@@ -0,0 +1,268 @@
+/****************************************************************************
+ * include/sys/io_uring.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_SYS_IO_URING_H
+#define __INCLUDE_SYS_IO_URING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <string.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Operation codes of a submission queue entry.  The values are those of
+ * Linux, only a subset is supported.
+ */
+
+#define IORING_OP_NOP          0  /* No operation */
+#define IORING_OP_FSYNC        3  /* fsync(fd) */
+#define IORING_OP_POLL_ADD     6  /* Wait for the poll events op_flags */
+#define IORING_OP_ACCEPT      13  /* accept4(fd, addr, addr2, op_flags) */
+#define IORING_OP_READ        22  /* pread(fd, addr, len, off) */
+#define IORING_OP_WRITE       23  /* pwrite(fd, addr, len, off) */
+#define IORING_OP_SEND        26  /* send(fd, addr, len, op_flags) */
+#define IORING_OP_RECV        27  /* recv(fd, addr, len, op_flags) */
+
+/* Use the current file position for IORING_OP_READ/WRITE */
+
+#define IORING_OFF_CURRENT    ((uint64_t)-1)
+
+/* io_uring_setup() flags */
+
+#define IORING_SETUP_CQSIZE   (1 << 3) /* cq_entries of the params is valid */
+#define IORING_SETUP_CLOEXEC  (1 << 16) /* Set FD_CLOEXEC on the ring fd */
+
+/* io_uring_enter() flags */
+
+#define IORING_ENTER_GETEVENTS (1 << 0) /* Wait for min_complete CQEs */
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+/* Submission queue entry, filled in by the application */
+
+struct io_uring_sqe
+{
+  uint8_t  opcode;     /* IORING_OP_* */
+  uint8_t  flags;      /* Reserved, must be zero */
+  uint16_t ioprio;     /* Reserved, must be zero */
+  int32_t  fd;         /* File descriptor the operation applies to */
+  uint64_t off;        /* File offset or IORING_OFF_CURRENT */
+  uint64_t addr;       /* Buffer address, or sockaddr for accept */
+  uint32_t len;        /* Buffer length */
+  uint32_t op_flags;   /* Poll events, send/recv flags or accept flags */
+  uint64_t user_data;  /* Returned untouched in the completion */
+  uint64_t addr2;      /* socklen_t pointer for accept */
+};
+
+/* Completion queue entry, filled in by the kernel */
+
+struct io_uring_cqe
+{
+  uint64_t user_data;  /* user_data of the submission */
+  int32_t  res;        /* Result, a negated errno value on failure */
+  uint32_t flags;      /* Reserved */
+};
+
+/* The rings are shared between the application and the kernel.  Each one
+ * has a single producer that advances the tail and a single consumer that
+ * advances the head, so both sides only need ordered loads and stores and
+ * no system call is required to reap the completions.
+ */
+
+struct io_uring_sq
+{
+  volatile uint32_t head;           /* Consumed by the kernel */
+  volatile uint32_t tail;           /* Produced by the application */
+  uint32_t          ring_mask;      /* ring_entries - 1 */
+  uint32_t          ring_entries;   /* Power of two */
+  FAR struct io_uring_sqe *sqes;    /* The entries, indexed by tail & mask */
+};
+
+struct io_uring_cq
+{
+  volatile uint32_t head;           /* Consumed by the application */
+  volatile uint32_t tail;           /* Produced by the kernel */
+  uint32_t          ring_mask;      /* ring_entries - 1 */
+  uint32_t          ring_entries;   /* Power of two */
+  FAR struct io_uring_cqe *cqes;    /* The entries, indexed by head & mask */
+};
+
+/* Parameters of io_uring_setup().  NuttX has no mmap() of the rings, the
+ * kernel returns their address in sq and cq instead.
+ */
+
+struct io_uring_params
+{
+  uint32_t sq_entries;              /* Out: entries of the submission ring */
+  uint32_t cq_entries;              /* In/out: entries of the completion
+                                     * ring (IORING_SETUP_CQSIZE) */
+  uint32_t flags;                   /* IORING_SETUP_* */
+  FAR struct io_uring_sq *sq;       /* Out: the submission ring */
+  FAR struct io_uring_cq *cq;       /* Out: the completion ring */
+};
+
+/* A ring as used by the library helpers */
+
+struct io_uring
+{
+  int ring_fd;
+  uint32_t sqe_tail;                /* Entries handed out, published to
+                                     * sq->tail by io_uring_submit() */
+  FAR struct io_uring_sq *sq;
+  FAR struct io_uring_cq *cq;
+};
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+static inline void io_uring_prep_rw(FAR struct io_uring_sqe *sqe,
+                                    int op, int fd, FAR const void *addr,
+                                    uint32_t len, uint64_t off)
+{
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = op;
+  sqe->fd     = fd;
+  sqe->off    = off;
+  sqe->addr   = (uintptr_t)addr;
+  sqe->len    = len;
+}
+
+static inline void io_uring_prep_nop(FAR struct io_uring_sqe *sqe)
+{
+  io_uring_prep_rw(sqe, IORING_OP_NOP, -1, NULL, 0, 0);
+}
+
+static inline void io_uring_prep_read(FAR struct io_uring_sqe *sqe, int fd,
+                                      FAR void *buf, uint32_t nbytes,
+                                      uint64_t offset)
+{
+  io_uring_prep_rw(sqe, IORING_OP_READ, fd, buf, nbytes, offset);
+}
+
+static inline void io_uring_prep_write(FAR struct io_uring_sqe *sqe, int fd,
+                                       FAR const void *buf, uint32_t nbytes,
+                                       uint64_t offset)
+{
+  io_uring_prep_rw(sqe, IORING_OP_WRITE, fd, buf, nbytes, offset);
+}
+
+static inline void io_uring_prep_send(FAR struct io_uring_sqe *sqe,
+                                      int sockfd, FAR const void *buf,
+                                      size_t len, int flags)
+{
+  io_uring_prep_rw(sqe, IORING_OP_SEND, sockfd, buf, len, 0);
+  sqe->op_flags = flags;
+}
+
+static inline void io_uring_prep_recv(FAR struct io_uring_sqe *sqe,
+                                      int sockfd, FAR void *buf,
+                                      size_t len, int flags)
+{
+  io_uring_prep_rw(sqe, IORING_OP_RECV, sockfd, buf, len, 0);
+  sqe->op_flags = flags;
+}
+
+static inline void io_uring_prep_accept(FAR struct io_uring_sqe *sqe,
+                                        int fd, FAR struct sockaddr *addr,
+                                        FAR socklen_t *addrlen, int flags)
+{
+  io_uring_prep_rw(sqe, IORING_OP_ACCEPT, fd, addr, 0, 0);
+  sqe->addr2    = (uintptr_t)addrlen;
+  sqe->op_flags = flags;
+}
+
+static inline void io_uring_prep_fsync(FAR struct io_uring_sqe *sqe, int fd)
+{
+  io_uring_prep_rw(sqe, IORING_OP_FSYNC, fd, NULL, 0, 0);
+}
+
+static inline void io_uring_prep_poll_add(FAR struct io_uring_sqe *sqe,
+                                          int fd, unsigned int poll_mask)
+{
+  io_uring_prep_rw(sqe, IORING_OP_POLL_ADD, fd, NULL, 0, 0);
+  sqe->op_flags = poll_mask;
+}
+
+static inline void io_uring_sqe_set_data(FAR struct io_uring_sqe *sqe,
+                                         FAR void *data)
+{
+  sqe->user_data = (uintptr_t)data;
+}
+
+static inline FAR void *io_uring_cqe_get_data(FAR const struct io_uring_cqe
+                                              *cqe)
+{
+  return (FAR void *)(uintptr_t)cqe->user_data;
+}
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/* System calls */
+
+int io_uring_setup(unsigned int entries, FAR struct io_uring_params *p);
+int io_uring_enter(int fd, unsigned int to_submit,
+                   unsigned int min_complete, unsigned int flags);
+
+/* Library helpers, modelled after liburing */
+
+int io_uring_queue_init(unsigned int entries, FAR struct io_uring *ring,
+                        unsigned int flags);
+void io_uring_queue_exit(FAR struct io_uring *ring);
+FAR struct io_uring_sqe *io_uring_get_sqe(FAR struct io_uring *ring);
+int io_uring_submit(FAR struct io_uring *ring);
+int io_uring_submit_and_wait(FAR struct io_uring *ring,
+                             unsigned int wait_nr);
+int io_uring_peek_cqe(FAR struct io_uring *ring,
+                      FAR struct io_uring_cqe **cqe_ptr);
+int io_uring_wait_cqe(FAR struct io_uring *ring,
+                      FAR struct io_uring_cqe **cqe_ptr);
+void io_uring_cqe_seen(FAR struct io_uring *ring,
+                       FAR struct io_uring_cqe *cqe);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_SYS_IO_URING_H */
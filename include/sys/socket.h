@@ -139,6 +139,10 @@
 #define MSG_CMSG_CLOEXEC 0x100000 /* Set close_on_exit for file
                                    * descriptor received through SCM_RIGHTS.
                                    */
+#define MSG_ZEROCOPY   0x4000000 /* Send the user data without copying it,
+                                   * completion is reported on the error
+                                   * queue (requires SO_ZEROCOPY).
+                                   */
 
 /* Protocol levels supported by get/setsockopt(): */
 
@@ -220,6 +224,17 @@
 #define SO_PEERCRED     18 /* Return the credentials of the peer process
                             * connected to this socket.
                             */
+#define SO_REUSEPORT    19 /* Allow multiple sockets to bind the same local
+                            * address and port, with incoming connections
+                            * and datagrams distributed among them (get/set).
+                            * arg: pointer to integer containing a boolean
+                            * value
+                            */
+#define SO_ZEROCOPY     20 /* Allow MSG_ZEROCOPY sends on this socket
+                            * (get/set).
+                            * arg: pointer to integer containing a boolean
+                            * value
+                            */
 
 /* The options are unsupported but included for compatibility
  * and portability
@@ -297,6 +312,13 @@
 #define SCM_SECURITY    0x03    /* rw: security label */
 #define SCM_TIMESTAMP   SO_TIMESTAMP
 
+/* Origin and code of the extended errors reported on the error queue */
+
+#define SO_EE_ORIGIN_NONE           0
+#define SO_EE_ORIGIN_ZEROCOPY       5
+
+#define SO_EE_CODE_ZEROCOPY_COPIED  1 /* The data was copied after all */
+
 /* Desired design of maximum size and alignment (see RFC2553) */
 
 #define SS_MAXSIZE   128               /* Implementation-defined maximum size. */
@@ -386,6 +408,22 @@ struct ucred
   gid_t gid;
 };
 
+/* Extended error read from the error queue with MSG_ERRQUEUE, carried in
+ * an IP_RECVERR or IPV6_RECVERR control message.  For MSG_ZEROCOPY the
+ * completed sends are numbered from ee_info to ee_data (inclusive).
+ */
+
+struct sock_extended_err
+{
+  uint32_t ee_errno;            /* Error number, 0 for completions */
+  uint8_t  ee_origin;           /* SO_EE_ORIGIN_* */
+  uint8_t  ee_type;
+  uint8_t  ee_code;             /* SO_EE_CODE_* */
+  uint8_t  ee_pad;
+  uint32_t ee_info;
+  uint32_t ee_data;
+};
+
 /****************************************************************************
  * Inline Functions
  ****************************************************************************/
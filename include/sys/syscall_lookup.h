@@ -225,6 +225,10 @@ SYSCALL_LOOKUP(pwrite,                     4)
 #ifdef CONFIG_SIGNAL_FD
   SYSCALL_LOOKUP(signalfd,                 3)
 #endif
+#ifdef CONFIG_IO_URING
+  SYSCALL_LOOKUP(io_uring_setup,           2)
+  SYSCALL_LOOKUP(io_uring_enter,           4)
+#endif
 
 /* Board support */
 
@@ -0,0 +1,78 @@
+/****************************************************************************
+ * libs/libc/lz4/lz4.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_LZ4_LZ4_H
+#define __LIBS_LIBC_LZ4_LZ4_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <lz4.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LZ4_GET16LE(p)  ((uint16_t)(p)[0] | (uint16_t)(p)[1] << 8)
+#define LZ4_GET32LE(p)  ((uint32_t)(p)[0] | (uint32_t)(p)[1] << 8 | \
+                         (uint32_t)(p)[2] << 16 | (uint32_t)(p)[3] << 24)
+
+#define LZ4_PUT32LE(p, v) \
+  do \
+    { \
+      (p)[0] = (uint8_t)(v); \
+      (p)[1] = (uint8_t)((v) >> 8); \
+      (p)[2] = (uint8_t)((v) >> 16); \
+      (p)[3] = (uint8_t)((v) >> 24); \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_decompress_prefix
+ *
+ * Description:
+ *   lz4_decompress() of a block whose matches may reach back to prefix,
+ *   the start of the data already decompressed before out_data.  This is
+ *   how the linked blocks of a frame are decompressed.
+ *
+ * Returned Value:
+ *   The size of the decompressed data, or -E2BIG or -EINVAL.
+ *
+ ****************************************************************************/
+
+ssize_t lz4_decompress_prefix(FAR const void *in_data, size_t in_len,
+                              FAR void *out_data, size_t out_len,
+                              FAR const void *prefix);
+
+#endif /* __LIBS_LIBC_LZ4_LZ4_H */
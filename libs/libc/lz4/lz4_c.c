@@ -0,0 +1,264 @@
+/****************************************************************************
+ * libs/libc/lz4/lz4_c.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <strings.h>
+
+#include "lz4/lz4.h"
+
+#ifdef CONFIG_LIBC_LZ4
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Without a match, the search steps faster and faster over the data, one
+ * byte more every (1 << LZ4_SKIPLOG) bytes:  incompressible data costs
+ * little time and only a few matches are missed.
+ */
+
+#define LZ4_SKIPLOG 6
+
+#define LZ4_HASH(v) \
+  ((uint32_t)((v) * 2654435761u) >> (32 - CONFIG_LIBC_LZ4_HLOG))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline uint32_t lz4_read32(FAR const uint8_t *p)
+{
+  uint32_t v;
+
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline unsigned long lz4_readword(FAR const uint8_t *p)
+{
+  unsigned long v;
+
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline FAR uint8_t *lz4_putlen(FAR uint8_t *op, size_t len)
+{
+  while (len >= 255)
+    {
+      *op++ = 255;
+      len  -= 255;
+    }
+
+  *op++ = (uint8_t)len;
+  return op;
+}
+
+/****************************************************************************
+ * Name: lz4_sequence
+ *
+ * Description:
+ *   Write a sequence:  a token, the literals and, if matchlen is not zero,
+ *   the offset and the length of the match.  NULL is returned if it does
+ *   not fit before oend.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *lz4_sequence(FAR uint8_t *op, FAR uint8_t *oend,
+                                 FAR const uint8_t *anchor, size_t litlen,
+                                 size_t offset, size_t matchlen)
+{
+  FAR uint8_t *token = op;
+
+  /* Worst case:  a token, the literals with their length, an offset and
+   * the length of the match.
+   */
+
+  if ((size_t)(oend - op) < litlen + litlen / 255 + matchlen / 255 + 5)
+    {
+      return NULL;
+    }
+
+  op++;
+  if (litlen >= 15)
+    {
+      *token = 15 << 4;
+      op = lz4_putlen(op, litlen - 15);
+    }
+  else
+    {
+      *token = (uint8_t)(litlen << 4);
+    }
+
+  memcpy(op, anchor, litlen);
+  op += litlen;
+
+  if (matchlen > 0)
+    {
+      *op++ = (uint8_t)offset;
+      *op++ = (uint8_t)(offset >> 8);
+
+      matchlen -= LZ4_MINMATCH;
+      if (matchlen >= 15)
+        {
+          *token |= 15;
+          op = lz4_putlen(op, matchlen - 15);
+        }
+      else
+        {
+          *token |= (uint8_t)matchlen;
+        }
+    }
+
+  return op;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_compress
+ *
+ * Description:
+ *   Compress in_len bytes at in_data into an LZ4 block at out_data, up to
+ *   out_len bytes.  This is the greedy single hash table parser of the
+ *   "fast" LZ4 compressor:  every match found is taken as is, extended
+ *   forwards and backwards.
+ *
+ ****************************************************************************/
+
+size_t lz4_compress(FAR const void *in_data, size_t in_len,
+                    FAR void *out_data, size_t out_len, lz4_state_t htab)
+{
+  FAR const uint8_t *in = in_data;
+  FAR const uint8_t *ip = in;
+  FAR const uint8_t *anchor = in;
+  FAR const uint8_t *iend = in + in_len;
+  FAR const uint8_t *mflimit;
+  FAR const uint8_t *matchlimit;
+  FAR const uint8_t *ref;
+  FAR uint8_t *op = out_data;
+  FAR uint8_t *oend = op + out_len;
+  unsigned long diff;
+  uint32_t cand;
+  uint32_t pos;
+  uint32_t seq;
+  uint32_t h;
+  size_t len;
+
+  /* Shorter data are only literals */
+
+  if (in_len > LZ4_MFLIMIT)
+    {
+      mflimit    = iend - LZ4_MFLIMIT;
+      matchlimit = iend - LZ4_LASTLITERALS;
+
+      /* The table is not cleared:  a position left by a previous call is
+       * only a candidate, rejected if it is not behind, and its sequence
+       * compared anyway.
+       */
+
+      while (ip <= mflimit)
+        {
+          seq  = lz4_read32(ip);
+          h    = LZ4_HASH(seq);
+          pos  = (uint32_t)(ip - in);
+          cand = htab[h];
+          htab[h] = pos;
+
+          if (cand >= pos || pos - cand > LZ4_MAX_OFFSET ||
+              lz4_read32(in + cand) != seq)
+            {
+              ip += 1 + ((size_t)(ip - anchor) >> LZ4_SKIPLOG);
+              continue;
+            }
+
+          ref = in + cand;
+
+          /* Extend the match backwards over the pending literals */
+
+          while (ip > anchor && ref > in && *(ip - 1) == *(ref - 1))
+            {
+              ip--;
+              ref--;
+            }
+
+          /* And forwards, up to the last literals */
+
+          len = LZ4_MINMATCH;
+          while (ip + len + sizeof(diff) <= matchlimit)
+            {
+              diff = lz4_readword(ip + len) ^ lz4_readword(ref + len);
+              if (diff != 0)
+                {
+#ifndef CONFIG_ENDIAN_BIG
+                  /* The first different byte is the lowest one */
+
+                  len += (ffsl((long)diff) - 1) >> 3;
+#endif
+                  break;
+                }
+
+              len += sizeof(diff);
+            }
+
+          while (ip + len < matchlimit && ip[len] == ref[len])
+            {
+              len++;
+            }
+
+          op = lz4_sequence(op, oend, anchor, ip - anchor, ip - ref, len);
+          if (op == NULL)
+            {
+              return 0;
+            }
+
+          ip    += len;
+          anchor = ip;
+
+          /* Fill in the table inside the match, it finds the next one
+           * sooner in repetitive data.
+           */
+
+          if (ip <= mflimit)
+            {
+              htab[LZ4_HASH(lz4_read32(ip - 2))] = (uint32_t)(ip - 2 - in);
+            }
+        }
+    }
+
+  /* The last literals */
+
+  op = lz4_sequence(op, oend, anchor, iend - anchor, 0, 0);
+  if (op == NULL)
+    {
+      return 0;
+    }
+
+  return op - (FAR uint8_t *)out_data;
+}
+
+#endif /* CONFIG_LIBC_LZ4 */
@@ -0,0 +1,220 @@
+/****************************************************************************
+ * libs/libc/lz4/lz4_d.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include "lz4/lz4.h"
+
+#ifdef CONFIG_LIBC_LZ4
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_getlen
+ *
+ * Description:
+ *   Read the extra bytes of a length of 15 or more, NULL is returned if the
+ *   input ends first.
+ *
+ ****************************************************************************/
+
+static FAR const uint8_t *lz4_getlen(FAR const uint8_t *ip,
+                                     FAR const uint8_t *iend,
+                                     FAR size_t *len)
+{
+  uint8_t b;
+
+  do
+    {
+      if (ip >= iend)
+        {
+          return NULL;
+        }
+
+      b     = *ip++;
+      *len += b;
+    }
+  while (b == 255);
+
+  return ip;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_decompress_prefix
+ ****************************************************************************/
+
+ssize_t lz4_decompress_prefix(FAR const void *in_data, size_t in_len,
+                              FAR void *out_data, size_t out_len,
+                              FAR const void *prefix)
+{
+  FAR const uint8_t *ip = in_data;
+  FAR const uint8_t *iend = ip + in_len;
+  FAR const uint8_t *ref;
+  FAR uint8_t *op = out_data;
+  FAR uint8_t *oend = op + out_len;
+  size_t offset;
+  size_t len;
+  uint8_t token;
+
+  for (; ; )
+    {
+      if (ip >= iend)
+        {
+          return -EINVAL;
+        }
+
+      /* The literals */
+
+      token = *ip++;
+      len   = token >> 4;
+      if (len == 15)
+        {
+          ip = lz4_getlen(ip, iend, &len);
+          if (ip == NULL)
+            {
+              return -EINVAL;
+            }
+        }
+
+      if (len > (size_t)(iend - ip))
+        {
+          return -EINVAL;
+        }
+
+      if (len > (size_t)(oend - op))
+        {
+          return -E2BIG;
+        }
+
+      /* Most runs are short:  away from the ends of the buffers, copy a
+       * fixed size, which needs no call to memcpy().
+       */
+
+      if (len <= 16 && iend - ip >= 16 && oend - op >= 16)
+        {
+          memcpy(op, ip, 16);
+        }
+      else
+        {
+          memcpy(op, ip, len);
+        }
+
+      ip += len;
+      op += len;
+
+      /* The last sequence has no match */
+
+      if (ip == iend)
+        {
+          break;
+        }
+
+      /* The match */
+
+      if (iend - ip < 2)
+        {
+          return -EINVAL;
+        }
+
+      offset = LZ4_GET16LE(ip);
+      ip    += 2;
+      if (offset == 0 ||
+          offset > (size_t)(op - (FAR const uint8_t *)prefix))
+        {
+          return -EINVAL;
+        }
+
+      len = token & 15;
+      if (len == 15)
+        {
+          ip = lz4_getlen(ip, iend, &len);
+          if (ip == NULL)
+            {
+              return -EINVAL;
+            }
+        }
+
+      len += LZ4_MINMATCH;
+      if (len > (size_t)(oend - op))
+        {
+          return -E2BIG;
+        }
+
+      /* An overlapping match repeats the last offset bytes */
+
+      ref = op - offset;
+      if (offset >= 16 && len <= 16 && oend - op >= 16)
+        {
+          memcpy(op, ref, 16);
+          op += len;
+        }
+      else if (offset >= len)
+        {
+          memcpy(op, ref, len);
+          op += len;
+        }
+      else
+        {
+          while (len-- > 0)
+            {
+              *op++ = *ref++;
+            }
+        }
+    }
+
+  return op - (FAR uint8_t *)out_data;
+}
+
+/****************************************************************************
+ * Name: lz4_decompress
+ *
+ * Description:
+ *   Decompress the LZ4 block of in_len bytes at in_data to out_data, up to
+ *   out_len bytes.
+ *
+ ****************************************************************************/
+
+size_t lz4_decompress(FAR const void *in_data, size_t in_len,
+                      FAR void *out_data, size_t out_len)
+{
+  ssize_t ret;
+
+  ret = lz4_decompress_prefix(in_data, in_len, out_data, out_len,
+                              out_data);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return 0;
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_LIBC_LZ4 */
@@ -0,0 +1,381 @@
+/****************************************************************************
+ * libs/libc/lz4/lz4_frame.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include "lz4/lz4.h"
+
+#ifdef CONFIG_LIBC_LZ4
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Frame descriptor flags */
+
+#define LZ4_FLG_VERSION     0x40 /* Version 01 in bits 7-6 */
+#define LZ4_FLG_VERSIONMASK 0xc0
+#define LZ4_FLG_BINDEP      0x20 /* Independent blocks */
+#define LZ4_FLG_BCHECKSUM   0x10 /* Checksum after each block */
+#define LZ4_FLG_CSIZE       0x08 /* Content size in the header */
+#define LZ4_FLG_CCHECKSUM   0x04 /* Checksum after the end mark */
+#define LZ4_FLG_RESERVED    0x02
+#define LZ4_FLG_DICTID      0x01 /* Dictionary ID in the header */
+
+#define LZ4_BD_SHIFT        4    /* Block maximum size ID in bits 6-4 */
+#define LZ4_BD_MASK         0x70
+
+/* The block maximum size IDs 4 to 7 are 64 KiB to 4 MiB */
+
+#define LZ4_BD_SIZE(id)     ((size_t)1 << (2 * (id) + 8))
+#define LZ4_BD_MIN          4
+#define LZ4_BD_MAX          7
+
+/* xxHash32, the checksum of the frames */
+
+#define XXH_PRIME1          2654435761u
+#define XXH_PRIME2          2246822519u
+#define XXH_PRIME3          3266489917u
+#define XXH_PRIME4          668265263u
+#define XXH_PRIME5          374761393u
+
+#define XXH_ROTL(x, r)      (((x) << (r)) | ((x) >> (32 - (r))))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline uint32_t lz4_xxh32_round(uint32_t acc, uint32_t input)
+{
+  acc += input * XXH_PRIME2;
+  acc  = XXH_ROTL(acc, 13);
+  return acc * XXH_PRIME1;
+}
+
+/****************************************************************************
+ * Name: lz4_xxh32
+ *
+ * Description:
+ *   The xxHash32 of len bytes with a zero seed, as used by the frames for
+ *   the header, block and content checksums.
+ *
+ ****************************************************************************/
+
+static uint32_t lz4_xxh32(FAR const uint8_t *p, size_t len)
+{
+  FAR const uint8_t *end = p + len;
+  uint32_t v1 = XXH_PRIME1 + XXH_PRIME2;
+  uint32_t v2 = XXH_PRIME2;
+  uint32_t v3 = 0;
+  uint32_t v4 = -XXH_PRIME1;
+  uint32_t h;
+
+  if (len >= 16)
+    {
+      do
+        {
+          v1 = lz4_xxh32_round(v1, LZ4_GET32LE(p));
+          v2 = lz4_xxh32_round(v2, LZ4_GET32LE(p + 4));
+          v3 = lz4_xxh32_round(v3, LZ4_GET32LE(p + 8));
+          v4 = lz4_xxh32_round(v4, LZ4_GET32LE(p + 12));
+          p += 16;
+        }
+      while (end - p >= 16);
+
+      h = XXH_ROTL(v1, 1) + XXH_ROTL(v2, 7) +
+          XXH_ROTL(v3, 12) + XXH_ROTL(v4, 18);
+    }
+  else
+    {
+      h = XXH_PRIME5;
+    }
+
+  h += (uint32_t)len;
+
+  for (; end - p >= 4; p += 4)
+    {
+      h += LZ4_GET32LE(p) * XXH_PRIME3;
+      h  = XXH_ROTL(h, 17) * XXH_PRIME4;
+    }
+
+  for (; p < end; p++)
+    {
+      h += *p * XXH_PRIME5;
+      h  = XXH_ROTL(h, 11) * XXH_PRIME1;
+    }
+
+  h ^= h >> 15;
+  h *= XXH_PRIME2;
+  h ^= h >> 13;
+  h *= XXH_PRIME3;
+  h ^= h >> 16;
+  return h;
+}
+
+/****************************************************************************
+ * Name: lz4_frame_one
+ *
+ * Description:
+ *   Decompress the frame at ip, *in_len is updated with the size of the
+ *   frame.  The size of the decompressed data or a negated errno is
+ *   returned.
+ *
+ ****************************************************************************/
+
+static ssize_t lz4_frame_one(FAR const uint8_t *ip, FAR size_t *in_len,
+                             FAR uint8_t *out, size_t out_len)
+{
+  FAR const uint8_t *start = ip;
+  FAR const uint8_t *iend = ip + *in_len;
+  FAR uint8_t *op = out;
+  uint32_t blksize;
+  size_t bchecksum;
+  size_t maxsize;
+  size_t hdrlen;
+  size_t len;
+  ssize_t ret;
+  uint8_t flg;
+  uint8_t bd;
+
+  /* The frame descriptor */
+
+  if (*in_len < LZ4_FRAME_HDR_SIZE)
+    {
+      return -EINVAL;
+    }
+
+  flg     = ip[4];
+  bd      = ip[5];
+  hdrlen  = LZ4_FRAME_HDR_SIZE;
+  hdrlen += flg & LZ4_FLG_CSIZE ? 8 : 0;
+  hdrlen += flg & LZ4_FLG_DICTID ? 4 : 0;
+
+  if ((flg & (LZ4_FLG_VERSIONMASK | LZ4_FLG_RESERVED)) !=
+      LZ4_FLG_VERSION || (bd & ~LZ4_BD_MASK) != 0 ||
+      (bd >> LZ4_BD_SHIFT) < LZ4_BD_MIN || *in_len < hdrlen ||
+      ip[hdrlen - 1] != (uint8_t)(lz4_xxh32(ip + 4, hdrlen - 5) >> 8))
+    {
+      return -EINVAL;
+    }
+
+  if (flg & LZ4_FLG_DICTID)
+    {
+      return -ENOTSUP;
+    }
+
+  maxsize   = LZ4_BD_SIZE(bd >> LZ4_BD_SHIFT);
+  bchecksum = flg & LZ4_FLG_BCHECKSUM ? 4 : 0;
+  ip       += hdrlen;
+
+  /* The blocks, up to the end mark */
+
+  for (; ; )
+    {
+      if (iend - ip < LZ4_BLOCK_HDR_SIZE)
+        {
+          return -EINVAL;
+        }
+
+      blksize = LZ4_GET32LE(ip);
+      ip     += LZ4_BLOCK_HDR_SIZE;
+      if (blksize == 0)
+        {
+          break;
+        }
+
+      len = blksize & ~LZ4_BLOCK_UNCOMPRESSED;
+      if (len > maxsize || len + bchecksum > (size_t)(iend - ip))
+        {
+          return -EINVAL;
+        }
+
+      if (bchecksum && LZ4_GET32LE(ip + len) != lz4_xxh32(ip, len))
+        {
+          return -EINVAL;
+        }
+
+      if (blksize & LZ4_BLOCK_UNCOMPRESSED)
+        {
+          if (len > (size_t)(out + out_len - op))
+            {
+              return -E2BIG;
+            }
+
+          memcpy(op, ip, len);
+          op += len;
+        }
+      else
+        {
+          /* A linked block may refer to the previous ones */
+
+          ret = lz4_decompress_prefix(ip, len, op, out + out_len - op,
+                                      flg & LZ4_FLG_BINDEP ? op : out);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          op += ret;
+        }
+
+      ip += len + bchecksum;
+    }
+
+  if (flg & LZ4_FLG_CCHECKSUM)
+    {
+      if (iend - ip < 4 || LZ4_GET32LE(ip) != lz4_xxh32(out, op - out))
+        {
+          return -EINVAL;
+        }
+
+      ip += 4;
+    }
+
+  if ((flg & LZ4_FLG_CSIZE) &&
+      (LZ4_GET32LE(start + 6) != (uint32_t)(op - out) ||
+       LZ4_GET32LE(start + 10) != 0))
+    {
+      return -EINVAL;
+    }
+
+  *in_len = ip - start;
+  return op - out;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4_frame_header
+ *
+ * Description:
+ *   Write the header of an LZ4 frame of independent blocks of at most
+ *   blocksize bytes.
+ *
+ ****************************************************************************/
+
+size_t lz4_frame_header(FAR void *out_data, size_t blocksize)
+{
+  FAR uint8_t *op = out_data;
+  uint8_t id = LZ4_BD_MIN;
+
+  while (id < LZ4_BD_MAX && LZ4_BD_SIZE(id) < blocksize)
+    {
+      id++;
+    }
+
+  LZ4_PUT32LE(op, LZ4_FRAME_MAGIC);
+  op[4] = LZ4_FLG_VERSION | LZ4_FLG_BINDEP;
+  op[5] = id << LZ4_BD_SHIFT;
+  op[6] = (uint8_t)(lz4_xxh32(op + 4, 2) >> 8);
+  return LZ4_FRAME_HDR_SIZE;
+}
+
+/****************************************************************************
+ * Name: lz4_frame_block
+ *
+ * Description:
+ *   Compress the in_len bytes at in_data into a block of an LZ4 frame at
+ *   out_data, stored uncompressed if it does not compress.
+ *
+ ****************************************************************************/
+
+size_t lz4_frame_block(FAR const void *in_data, size_t in_len,
+                       FAR void *out_data, lz4_state_t htab)
+{
+  FAR uint8_t *op = out_data;
+  uint32_t blksize;
+
+  blksize = in_len > 0 ? lz4_compress(in_data, in_len,
+                                      op + LZ4_BLOCK_HDR_SIZE,
+                                      in_len - 1, htab) : 0;
+  if (blksize == 0)
+    {
+      memcpy(op + LZ4_BLOCK_HDR_SIZE, in_data, in_len);
+      blksize = in_len | LZ4_BLOCK_UNCOMPRESSED;
+    }
+
+  LZ4_PUT32LE(op, blksize);
+  return LZ4_BLOCK_HDR_SIZE + (blksize & ~LZ4_BLOCK_UNCOMPRESSED);
+}
+
+/****************************************************************************
+ * Name: lz4_frame_decompress
+ *
+ * Description:
+ *   Decompress the LZ4 frames of in_len bytes at in_data to out_data, up to
+ *   out_len bytes.
+ *
+ ****************************************************************************/
+
+size_t lz4_frame_decompress(FAR const void *in_data, size_t in_len,
+                            FAR void *out_data, size_t out_len)
+{
+  FAR const uint8_t *ip = in_data;
+  FAR uint8_t *op = out_data;
+  FAR uint8_t *oend = op + out_len;
+  uint32_t magic;
+  size_t framelen;
+  ssize_t ret;
+
+  while (in_len > 0)
+    {
+      if (in_len < 8)
+        {
+          set_errno(EINVAL);
+          return 0;
+        }
+
+      framelen = in_len;
+      magic    = LZ4_GET32LE(ip);
+      if ((magic & ~0xf) == LZ4_SKIPPABLE_MAGIC)
+        {
+          framelen = 8 + (size_t)LZ4_GET32LE(ip + 4);
+          ret      = framelen > in_len ? -EINVAL : 0;
+        }
+      else if (magic == LZ4_FRAME_MAGIC)
+        {
+          ret = lz4_frame_one(ip, &framelen, op, oend - op);
+        }
+      else
+        {
+          ret = -EINVAL;
+        }
+
+      if (ret < 0)
+        {
+          set_errno(-ret);
+          return 0;
+        }
+
+      ip     += framelen;
+      in_len -= framelen;
+      op     += ret;
+    }
+
+  return op - (FAR uint8_t *)out_data;
+}
+
+#endif /* CONFIG_LIBC_LZ4 */
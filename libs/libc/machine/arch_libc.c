@@ -48,6 +48,10 @@ FAR void *ARCH_LIBCFUN(memmove)(FAR void *dest,
                                 FAR const void *src, size_t n);
 #endif
 
+#ifdef CONFIG_LIBC_ARCH_MEMRCHR
+FAR void *ARCH_LIBCFUN(memrchr)(FAR const void *s, int c, size_t n);
+#endif
+
 #ifdef CONFIG_LIBC_ARCH_MEMSET
 FAR void *ARCH_LIBCFUN(memset)(FAR void *s, int c, size_t n);
 #endif
@@ -159,6 +163,19 @@ FAR void *memmove(FAR void *dest, FAR const void *src, FAR size_t n)
 }
 #endif
 
+#ifdef CONFIG_LIBC_ARCH_MEMRCHR
+FAR void *memrchr(FAR const void *s, int c, size_t n)
+{
+#  ifdef CONFIG_MM_KASAN
+#    ifndef CONFIG_MM_KASAN_DISABLE_READS_CHECK
+  __asan_loadN((FAR void *)s, n);
+#    endif
+#  endif
+
+  return ARCH_LIBCFUN(memrchr)(s, c, n);
+}
+#endif
+
 #ifdef CONFIG_LIBC_ARCH_MEMSET
 FAR void *memset(FAR void *s, int c, FAR size_t n)
 {
@@ -26,6 +26,7 @@
 
 #include <errno.h>
 
+#include <nuttx/atomic.h>
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
 #include <nuttx/mutex.h>
@@ -37,6 +38,23 @@
 
 #define NXMUTEX_RESET          ((pid_t)-2)
 
+/* Only the kernel copy of the library may look at the running tasks */
+
+#if defined(CONFIG_LIBC_MUTEX_ADAPTIVE) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define NXMUTEX_HAVE_ADAPTIVE
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef NXMUTEX_HAVE_ADAPTIVE
+static volatile uint32_t g_nxmutex_contended;
+static volatile uint32_t g_nxmutex_spun;
+static volatile uint32_t g_nxmutex_slept;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -88,6 +106,58 @@ static void nxmutex_add_backtrace(FAR mutex_t *mutex)
 #  define nxmutex_add_backtrace(mutex)
 #endif
 
+/****************************************************************************
+ * Name: nxmutex_spin
+ *
+ * Description:
+ *   Spin on a locked adaptive mutex while its holder is running on another
+ *   CPU:  a mutex released soon is then taken without sleeping.
+ *
+ * Parameters:
+ *   mutex - mutex descriptor.
+ *
+ * Return Value:
+ *   true if the mutex was taken, false if the caller has to sleep.
+ *
+ ****************************************************************************/
+
+#ifdef NXMUTEX_HAVE_ADAPTIVE
+static bool nxmutex_spin(FAR mutex_t *mutex)
+{
+  pid_t holder;
+  int spins;
+
+  atomic_fetch_add(&g_nxmutex_contended, 1);
+
+  for (spins = 0; spins < CONFIG_LIBC_MUTEX_ADAPTIVE_SPINS; spins++)
+    {
+      /* Poll the count without any lock, nxsem_trywait() only enters its
+       * critical section when the mutex looks free.
+       */
+
+      if (mutex->sem.semcount > 0 && nxsem_trywait(&mutex->sem) >= 0)
+        {
+          atomic_fetch_add(&g_nxmutex_spun, 1);
+          return true;
+        }
+
+      /* Give up as soon as the holder does not run, it has to be scheduled
+       * again to release the mutex.  The holder is not known yet right
+       * after the mutex is taken, keep spinning then.
+       */
+
+      holder = mutex->holder;
+      if (holder >= 0 && !nxsched_is_running(holder))
+        {
+          break;
+        }
+    }
+
+  atomic_fetch_add(&g_nxmutex_slept, 1);
+  return false;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -121,6 +191,9 @@ int nxmutex_init(FAR mutex_t *mutex)
     }
 
   mutex->holder = NXMUTEX_NO_HOLDER;
+#ifdef CONFIG_LIBC_MUTEX_ADAPTIVE
+  mutex->adaptive = false;
+#endif
 #ifdef CONFIG_PRIORITY_INHERITANCE
   nxsem_set_protocol(&mutex->sem, SEM_TYPE_MUTEX | SEM_PRIO_INHERIT);
 #else
@@ -246,6 +319,18 @@ int nxmutex_lock(FAR mutex_t *mutex)
   int ret;
 
   DEBUGASSERT(!nxmutex_is_hold(mutex));
+
+#ifdef NXMUTEX_HAVE_ADAPTIVE
+  /* An adaptive mutex found locked is first waited for by spinning */
+
+  if (mutex->adaptive && mutex->sem.semcount <= 0 && nxmutex_spin(mutex))
+    {
+      mutex->holder = _SCHED_GETTID();
+      nxmutex_add_backtrace(mutex);
+      return OK;
+    }
+#endif
+
   for (; ; )
     {
       /* Take the semaphore (perhaps waiting) */
@@ -537,6 +622,46 @@ int nxmutex_set_protocol(FAR mutex_t *mutex, int protocol)
   return nxsem_set_protocol(&mutex->sem, protocol);
 }
 
+/****************************************************************************
+ * Name: nxmutex_set_adaptive
+ *
+ * Description:
+ *   Select whether nxmutex_lock() spins, while the holder of the mutex is
+ *   running on another CPU, before it sleeps.
+ *
+ * Parameters:
+ *   mutex    - mutex descriptor.
+ *   adaptive - true to spin before sleeping.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_MUTEX_ADAPTIVE
+void nxmutex_set_adaptive(FAR mutex_t *mutex, bool adaptive)
+{
+  mutex->adaptive = adaptive;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxmutex_get_stats
+ *
+ * Description:
+ *   Return the contention statistics of the adaptive mutexes since boot.
+ *
+ * Parameters:
+ *   stats - Location to return the statistics.
+ *
+ ****************************************************************************/
+
+#ifdef NXMUTEX_HAVE_ADAPTIVE
+void nxmutex_get_stats(FAR struct nxmutex_stats_s *stats)
+{
+  stats->contended = g_nxmutex_contended;
+  stats->spun      = g_nxmutex_spun;
+  stats->slept     = g_nxmutex_slept;
+}
+#endif
+
 /****************************************************************************
  * Name: nxmutex_getprioceiling
  *
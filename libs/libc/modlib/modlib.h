@@ -83,6 +83,150 @@ int modlib_findsymtab(FAR struct mod_loadinfo_s *loadinfo);
 int modlib_readsym(FAR struct mod_loadinfo_s *loadinfo, int index,
                    FAR Elf_Sym *sym, FAR Elf_Shdr *shdr);
 
+/****************************************************************************
+ * Name: modlib_loadsyms
+ *
+ * Description:
+ *   Bring the symbol table and its string table in memory, with one read
+ *   each, or in place for the string table when the file can be mapped.
+ *
+ * Input Parameters:
+ *   loadinfo - Load state information
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_LOADSYMS
+int modlib_loadsyms(FAR struct mod_loadinfo_s *loadinfo);
+#endif
+
+/****************************************************************************
+ * Name: modlib_getsym
+ *
+ * Description:
+ *   Return a symbol of the symbol table loaded by modlib_loadsyms(), its
+ *   value resolved by modlib_symvalue() on the first use only.
+ *
+ * Input Parameters:
+ *   modp     - Module state information
+ *   loadinfo - Load state information
+ *   index    - Symbol table index
+ *   exports  - Pointer to the symbol table
+ *   nexports - Number of symbols in the symbol table
+ *   sym      - Location to return the symbol
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.  A symbol without a name is returned unresolved, as some
+ *   relocations do not need a named symbol.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_LOADSYMS
+int modlib_getsym(FAR struct module_s *modp,
+                  FAR struct mod_loadinfo_s *loadinfo, int index,
+                  FAR const struct symtab_s *exports, int nexports,
+                  FAR Elf_Sym **sym);
+#endif
+
+/****************************************************************************
+ * Name: modlib_prelink_load
+ *
+ * Description:
+ *   Load a prelinked executable (ET_EXEC) from a mappable file system (see
+ *   tools/prelink.py):  the text is run in place, the data is copied to the
+ *   fixed addresses it was linked at.
+ *
+ * Input Parameters:
+ *   loadinfo - Load state information
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.  -ENOEXEC is returned if the image was not prelinked to run
+ *   from where it is.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_PRELINKED
+int modlib_prelink_load(FAR struct mod_loadinfo_s *loadinfo);
+#endif
+
+/****************************************************************************
+ * Name: modlib_prelink_release
+ *
+ * Description:
+ *   Release the data area of a prelinked executable.
+ *
+ * Input Parameters:
+ *   datastart - The start of the data of an image
+ *
+ * Returned Value:
+ *   true if the data belongs to a prelinked executable and must not be
+ *   freed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_PRELINKED
+bool modlib_prelink_release(uintptr_t datastart);
+#else
+#  define modlib_prelink_release(d) false
+#endif
+
+/****************************************************************************
+ * Name: modlib_text_attach
+ *
+ * Description:
+ *   Reuse the text of a running instance of the same position independent
+ *   module, loaded from the same unmodified file.  On success, textalloc
+ *   and textshared are set in the load information.
+ *
+ * Input Parameters:
+ *   loadinfo - Load state information, after modlib_elfsize()
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+void modlib_text_attach(FAR struct mod_loadinfo_s *loadinfo);
+#endif
+
+/****************************************************************************
+ * Name: modlib_text_insert
+ *
+ * Description:
+ *   Share the text of a module just loaded with its next instances.
+ *
+ * Input Parameters:
+ *   loadinfo - Load state information
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+void modlib_text_insert(FAR struct mod_loadinfo_s *loadinfo);
+#endif
+
+/****************************************************************************
+ * Name: modlib_text_release
+ *
+ * Description:
+ *   Release a reference to a shared text, freeing it with the last one.
+ *
+ * Input Parameters:
+ *   textalloc - The text of a module
+ *
+ * Returned Value:
+ *   true if the text is shared and must not be freed by the caller.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+bool modlib_text_release(uintptr_t textalloc);
+#else
+#  define modlib_text_release(t) false
+#endif
+
 /****************************************************************************
  * Name: modlib_symvalue
  *
@@ -237,9 +237,24 @@ static int modlib_relocate(FAR struct module_s *modp,
 
       symidx = ELF_R_SYM(rel->r_info);
 
-      /* First try the cache */
+      /* First try the symbols loaded in memory, then the cache */
 
       sym = NULL;
+#ifdef CONFIG_MODLIB_LOADSYMS
+      if (loadinfo->symtab != NULL)
+        {
+          ret = modlib_getsym(modp, loadinfo, symidx, exports, nexports,
+                              &sym);
+          if (ret < 0)
+            {
+              berr("ERROR: Section %d reloc %d: "
+                   "Failed to get value of symbol[%d]: %d\n",
+                   relidx, i, symidx, ret);
+              break;
+            }
+        }
+#endif
+
       for (e = dq_peek(&q); e; e = dq_next(e))
         {
           cache = (FAR Elf_SymCache *)e;
@@ -489,9 +504,24 @@ static int modlib_relocateadd(FAR struct module_s *modp,
 
       symidx = ELF_R_SYM(rela->r_info);
 
-      /* First try the cache */
+      /* First try the symbols loaded in memory, then the cache */
 
       sym = NULL;
+#ifdef CONFIG_MODLIB_LOADSYMS
+      if (loadinfo->symtab != NULL)
+        {
+          ret = modlib_getsym(modp, loadinfo, symidx, exports, nexports,
+                              &sym);
+          if (ret < 0)
+            {
+              berr("ERROR: Section %d reloc %d: "
+                   "Failed to get value of symbol[%d]: %d\n",
+                   relidx, i, symidx, ret);
+              break;
+            }
+        }
+#endif
+
       for (e = dq_peek(&q); e; e = dq_next(e))
         {
           cache = (FAR Elf_SymCache *)e;
@@ -941,6 +971,26 @@ int modlib_bind(FAR struct module_s *modp,
       return ret;
     }
 
+#ifdef CONFIG_MODLIB_LOADSYMS
+  /* Bring the symbols of a relocatable module in memory, or else read them
+   * one by one.
+   */
+
+  if (loadinfo->ehdr.e_type != ET_DYN)
+    {
+      ret = modlib_loadsyms(loadinfo);
+      if (ret == -ENOMEM)
+        {
+          bwarn("WARNING: No memory for the symbol tables\n");
+          ret = OK;
+        }
+      else if (ret < 0)
+        {
+          return ret;
+        }
+    }
+#endif
+
   /* Process relocations in every allocated section */
 
   for (i = 1; i < loadinfo->ehdr.e_shnum; i++)
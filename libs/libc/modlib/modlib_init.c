@@ -76,6 +76,10 @@ static inline int modlib_fileinfo(FAR struct mod_loadinfo_s *loadinfo)
   loadinfo->fileuid  = buf.st_uid;
   loadinfo->filegid  = buf.st_gid;
   loadinfo->filemode = buf.st_mode;
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+  loadinfo->filemtime = buf.st_mtim;
+  loadinfo->fileino   = buf.st_ino;
+#endif
   return OK;
 }
 
@@ -117,6 +121,10 @@ int modlib_initialize(FAR const char *filename,
       return -errval;
     }
 
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+  loadinfo->filename = filename;
+#endif
+
   /* Get some stats info of the file. */
 
   ret = modlib_fileinfo(loadinfo);
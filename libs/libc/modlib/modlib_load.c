@@ -424,6 +424,13 @@ static inline int modlib_loadfile(FAR struct mod_loadinfo_s *loadinfo)
               goto skipload;
             }
 
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+          if (pptr == &text && loadinfo->textshared)
+            {
+              goto skipload;
+            }
+#endif
+
           /* SHT_NOBITS indicates that there is no data in the file for the
            * section.
            */
@@ -561,10 +568,35 @@ int modlib_load(FAR struct mod_loadinfo_s *loadinfo)
         }
     }
 
+#ifdef CONFIG_MODLIB_PRELINKED
+  /* A prelinked executable runs in place, only its data is loaded */
+
+  if (loadinfo->ehdr.e_type == ET_EXEC)
+    {
+      ret = modlib_prelink_load(loadinfo);
+      if (ret != -ENOEXEC)
+        {
+          if (ret < 0)
+            {
+              berr("ERROR: modlib_prelink_load failed: %d\n", ret);
+              goto errout_with_buffers;
+            }
+
+          return OK;
+        }
+    }
+#endif
+
   /* Determine total size to allocate */
 
   modlib_elfsize(loadinfo, true);
 
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+  /* Reuse the text of a running instance of the same program */
+
+  modlib_text_attach(loadinfo);
+#endif
+
   /* Allocate (and zero) memory for the ELF file. */
 
   /* Allocate memory to hold the ELF image */
@@ -584,7 +616,7 @@ int modlib_load(FAR struct mod_loadinfo_s *loadinfo)
           loadinfo->textalloc = loadinfo->xipbase +
                                 loadinfo->shdr[1].sh_offset;
         }
-      else if (loadinfo->textsize > 0)
+      else if (loadinfo->textsize > 0 && loadinfo->textalloc == 0)
         {
 #    ifdef CONFIG_ARCH_USE_TEXT_HEAP
           loadinfo->textalloc = (uintptr_t)
@@ -667,6 +699,10 @@ int modlib_load(FAR struct mod_loadinfo_s *loadinfo)
     }
 #endif
 
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+  modlib_text_insert(loadinfo);
+#endif
+
   return OK;
 
   /* Error exits */
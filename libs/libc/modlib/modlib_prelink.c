@@ -0,0 +1,333 @@
+/****************************************************************************
+ * libs/libc/modlib/modlib_prelink.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/ioctl.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/mutex.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/lib/modlib.h>
+
+#include "libc.h"
+#include "modlib/modlib.h"
+
+#ifdef CONFIG_MODLIB_PRELINKED
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PRELINK_RAMEND \
+  (CONFIG_MODLIB_PRELINKED_RAMSTART + CONFIG_MODLIB_PRELINKED_RAMSIZE)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The data area of a prelinked image being run */
+
+struct modlib_prelinked_s
+{
+  uintptr_t start;
+  uintptr_t end;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The data areas are at fixed addresses, two images sharing some data
+ * cannot be run at the same time, nor one image run twice.
+ */
+
+static struct modlib_prelinked_s
+  g_prelinked[CONFIG_MODLIB_PRELINKED_NIMAGES];
+static mutex_t g_prelinked_lock = NXMUTEX_INITIALIZER;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: modlib_prelink_reserve
+ *
+ * Description:
+ *   Reserve the data area of an image, failing with -EBUSY if it overlaps
+ *   the area of an image being run.
+ *
+ ****************************************************************************/
+
+static int modlib_prelink_reserve(uintptr_t start, uintptr_t end)
+{
+  FAR struct modlib_prelinked_s *slot = NULL;
+  int ret = OK;
+  int i;
+
+  nxmutex_lock(&g_prelinked_lock);
+
+  for (i = 0; i < CONFIG_MODLIB_PRELINKED_NIMAGES; i++)
+    {
+      if (g_prelinked[i].end == 0)
+        {
+          if (slot == NULL)
+            {
+              slot = &g_prelinked[i];
+            }
+        }
+      else if (start < g_prelinked[i].end && g_prelinked[i].start < end)
+        {
+          ret = -EBUSY;
+          break;
+        }
+    }
+
+  if (ret == OK)
+    {
+      if (slot != NULL)
+        {
+          slot->start = start;
+          slot->end   = end;
+        }
+      else
+        {
+          ret = -ENOMEM;
+        }
+    }
+
+  nxmutex_unlock(&g_prelinked_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: modlib_prelink_load
+ *
+ * Description:
+ *   Load a prelinked image (ET_EXEC):  its read-only sections are run in
+ *   place from the mapped file and its writable sections are copied to
+ *   the fixed addresses they were linked at.  There is nothing to allocate
+ *   and nothing to relocate.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.  -ENOEXEC is returned if the image was not prelinked to run
+ *   from where it is, it may still be loaded the usual way then.
+ *
+ ****************************************************************************/
+
+int modlib_prelink_load(FAR struct mod_loadinfo_s *loadinfo)
+{
+  uintptr_t xipbase = 0;
+  uintptr_t textstart = UINTPTR_MAX;
+  uintptr_t textend = 0;
+  uintptr_t datastart = UINTPTR_MAX;
+  uintptr_t dataend = 0;
+  int ret;
+  int i;
+
+  if (ioctl(loadinfo->filfd, FIOC_XIPBASE,
+            (unsigned long)&xipbase) < 0 || xipbase == 0)
+    {
+      binfo("Not on a mappable file system, cannot run in place\n");
+      return -ENOEXEC;
+    }
+
+  /* Check that the image was prelinked for where it is now */
+
+  for (i = 0; i < loadinfo->ehdr.e_shnum; i++)
+    {
+      FAR Elf_Shdr *shdr = &loadinfo->shdr[i];
+
+      if ((shdr->sh_flags & SHF_ALLOC) == 0 || shdr->sh_size == 0)
+        {
+          continue;
+        }
+
+      /* The constructors are otherwise found by modlib_bind() */
+
+      if (shdr->sh_type == SHT_INIT_ARRAY)
+        {
+          loadinfo->initarr = shdr->sh_addr;
+          loadinfo->ninit   = shdr->sh_size / sizeof(uintptr_t);
+        }
+      else if (shdr->sh_type == SHT_FINI_ARRAY)
+        {
+          loadinfo->finiarr = shdr->sh_addr;
+          loadinfo->nfini   = shdr->sh_size / sizeof(uintptr_t);
+        }
+
+      if ((shdr->sh_flags & SHF_WRITE) == 0)
+        {
+          if (shdr->sh_type == SHT_NOBITS ||
+              shdr->sh_addr != xipbase + shdr->sh_offset)
+            {
+              binfo("Section %d not prelinked at %08lx\n",
+                    i, (unsigned long)(xipbase + shdr->sh_offset));
+              return -ENOEXEC;
+            }
+
+          textstart = MIN(textstart, shdr->sh_addr);
+          textend   = MAX(textend, shdr->sh_addr + shdr->sh_size);
+        }
+      else
+        {
+          if (shdr->sh_addr < CONFIG_MODLIB_PRELINKED_RAMSTART ||
+              shdr->sh_addr + shdr->sh_size > PRELINK_RAMEND)
+            {
+              berr("ERROR: Section %d out of the prelinked data area\n", i);
+              return -ERANGE;
+            }
+
+          datastart = MIN(datastart, shdr->sh_addr);
+          dataend   = MAX(dataend, shdr->sh_addr + shdr->sh_size);
+        }
+    }
+
+  if (textend == 0)
+    {
+      binfo("No text to run in place\n");
+      return -ENOEXEC;
+    }
+
+  if (dataend != 0)
+    {
+      ret = modlib_prelink_reserve(datastart, dataend);
+      if (ret < 0)
+        {
+          berr("ERROR: Data area %08lx-%08lx in use: %d\n",
+               (unsigned long)datastart, (unsigned long)dataend, ret);
+          return ret;
+        }
+    }
+  else
+    {
+      datastart = 0;
+    }
+
+  /* Only the data is copied, the text stays in the file system */
+
+  for (i = 0; i < loadinfo->ehdr.e_shnum; i++)
+    {
+      FAR Elf_Shdr *shdr = &loadinfo->shdr[i];
+
+      if ((shdr->sh_flags & (SHF_ALLOC | SHF_WRITE)) !=
+          (SHF_ALLOC | SHF_WRITE) || shdr->sh_size == 0)
+        {
+          continue;
+        }
+
+      if (shdr->sh_type == SHT_NOBITS)
+        {
+          memset((FAR void *)(uintptr_t)shdr->sh_addr, 0, shdr->sh_size);
+        }
+      else
+        {
+          ret = modlib_read(loadinfo, (FAR uint8_t *)(uintptr_t)shdr->sh_addr,
+                            shdr->sh_size, shdr->sh_offset);
+          if (ret < 0)
+            {
+              berr("ERROR: Failed to read section %d: %d\n", i, ret);
+              modlib_prelink_release(datastart);
+              return ret;
+            }
+        }
+    }
+
+  /* The GOT, if any, was filled by the linker:  nothing to bind */
+
+  loadinfo->gotindex  = -1;
+  loadinfo->xipbase   = xipbase;
+  loadinfo->textalloc = textstart;
+  loadinfo->textsize  = textend - textstart;
+  loadinfo->datastart = datastart;
+  loadinfo->datasize  = dataend - (datastart ? datastart : dataend);
+
+#ifdef CONFIG_MODLIB_EXIDX_SECTNAME
+  ret = modlib_findsection(loadinfo, CONFIG_MODLIB_EXIDX_SECTNAME);
+  if (ret >= 0)
+    {
+      up_init_exidx(loadinfo->shdr[ret].sh_addr,
+                    loadinfo->shdr[ret].sh_size);
+    }
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: modlib_prelink_release
+ *
+ * Description:
+ *   Release the data area of a prelinked image.
+ *
+ * Input Parameters:
+ *   datastart - The start of the data area of an image
+ *
+ * Returned Value:
+ *   true if datastart was the data area of a prelinked image, that must
+ *   not be freed then.
+ *
+ ****************************************************************************/
+
+bool modlib_prelink_release(uintptr_t datastart)
+{
+  bool found = false;
+  int i;
+
+  if (datastart == 0)
+    {
+      return false;
+    }
+
+  nxmutex_lock(&g_prelinked_lock);
+
+  for (i = 0; i < CONFIG_MODLIB_PRELINKED_NIMAGES; i++)
+    {
+      if (g_prelinked[i].end != 0 && g_prelinked[i].start == datastart)
+        {
+          g_prelinked[i].start = 0;
+          g_prelinked[i].end   = 0;
+          found = true;
+          break;
+        }
+    }
+
+  nxmutex_unlock(&g_prelinked_lock);
+  return found;
+}
+
+#endif /* CONFIG_MODLIB_PRELINKED */
@@ -31,6 +31,8 @@
 #include <nuttx/lib/lib.h>
 #include <nuttx/lib/modlib.h>
 
+#include "modlib/modlib.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -132,7 +134,8 @@ int modlib_uninit(FAR struct module_s *modp)
           modp->sectalloc = NULL;
           modp->nsect = 0;
 #else
-          if (modp->xipbase == 0)
+          if (modp->xipbase == 0 &&
+              !modlib_text_release((uintptr_t)modp->textalloc))
             {
 #  if defined(CONFIG_ARCH_USE_TEXT_HEAP)
               up_textheap_free((FAR void *)modp->textalloc);
@@ -141,11 +144,14 @@ int modlib_uninit(FAR struct module_s *modp)
 #  endif
             }
 
+          if (!modlib_prelink_release((uintptr_t)modp->dataalloc))
+            {
 #  if defined(CONFIG_ARCH_USE_DATA_HEAP)
-          up_dataheap_free((FAR void *)modp->dataalloc);
+              up_dataheap_free((FAR void *)modp->dataalloc);
 #  else
-          lib_free((FAR void *)modp->dataalloc);
+              lib_free((FAR void *)modp->dataalloc);
 #  endif
+            }
 #endif
         }
       else
@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/ioctl.h>
 #include <inttypes.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -34,6 +35,7 @@
 #include <debug.h>
 
 #include <nuttx/symtab.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/lib/modlib.h>
 
 #include "libc.h"
@@ -80,7 +82,8 @@ extern int nglobals;
  * Name: modlib_symname
  *
  * Description:
- *   Get the symbol name in loadinfo->iobuffer[].
+ *   Get the symbol name, in the string table loaded in memory or else read
+ *   in loadinfo->iobuffer[].
  *
  * Returned Value:
  *   0 (OK) is returned on success and a negated errno is returned on
@@ -93,7 +96,8 @@ extern int nglobals;
  ****************************************************************************/
 
 static int modlib_symname(FAR struct mod_loadinfo_s *loadinfo,
-                          FAR const Elf_Sym *sym, Elf_Off sh_offset)
+                          FAR const Elf_Sym *sym, Elf_Off sh_offset,
+                          FAR const char **name)
 {
   FAR uint8_t *buffer;
   off_t  offset;
@@ -111,6 +115,21 @@ static int modlib_symname(FAR struct mod_loadinfo_s *loadinfo,
       return -ESRCH;
     }
 
+#ifdef CONFIG_MODLIB_LOADSYMS
+  if (loadinfo->strtab != NULL &&
+      sh_offset == loadinfo->shdr[loadinfo->strtabidx].sh_offset)
+    {
+      if (sym->st_name >= loadinfo->shdr[loadinfo->strtabidx].sh_size)
+        {
+          berr("ERROR: Symbol name out of the string table\n");
+          return -EINVAL;
+        }
+
+      *name = loadinfo->strtab + sym->st_name;
+      return OK;
+    }
+#endif
+
   /* Allocate an I/O buffer.  This buffer is used by mod_symname() to
    * accumulate the variable length symbol name.
    */
@@ -162,6 +181,7 @@ static int modlib_symname(FAR struct mod_loadinfo_s *loadinfo,
         {
           /* Yes, the buffer contains a NUL terminator. */
 
+          *name = (FAR const char *)loadinfo->iobuffer;
           return OK;
         }
 
@@ -310,6 +330,176 @@ int modlib_readsym(FAR struct mod_loadinfo_s *loadinfo, int index,
   return modlib_read(loadinfo, (FAR uint8_t *)sym, sizeof(Elf_Sym), offset);
 }
 
+/****************************************************************************
+ * Name: modlib_loadsyms
+ *
+ * Description:
+ *   Bring the symbol table and its string table in memory, with one read
+ *   each, or in place for the string table when the file can be mapped.
+ *
+ * Input Parameters:
+ *   loadinfo - Load state information
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODLIB_LOADSYMS
+int modlib_loadsyms(FAR struct mod_loadinfo_s *loadinfo)
+{
+  FAR Elf_Shdr *symhdr = &loadinfo->shdr[loadinfo->symtabidx];
+  FAR Elf_Shdr *strhdr = &loadinfo->shdr[loadinfo->strtabidx];
+  size_t nsyms = symhdr->sh_size / sizeof(Elf_Sym);
+  uintptr_t xipbase = 0;
+  FAR char *strtab;
+  int ret;
+
+  if (loadinfo->symtab != NULL)
+    {
+      return OK;
+    }
+
+  if (strhdr->sh_size == 0 ||
+      symhdr->sh_offset + symhdr->sh_size > loadinfo->filelen ||
+      strhdr->sh_offset + strhdr->sh_size > loadinfo->filelen)
+    {
+      berr("ERROR: Bad symbol or string table\n");
+      return -EINVAL;
+    }
+
+  loadinfo->symtab      = lib_malloc(symhdr->sh_size);
+  loadinfo->symresolved = lib_zalloc((nsyms + 7) / 8);
+  if (loadinfo->symtab == NULL || loadinfo->symresolved == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  ret = modlib_read(loadinfo, (FAR uint8_t *)loadinfo->symtab,
+                    symhdr->sh_size, symhdr->sh_offset);
+  if (ret < 0)
+    {
+      berr("ERROR: Failed to read the symbol table: %d\n", ret);
+      goto errout;
+    }
+
+  /* The string table is only read, use it in place if the file system can
+   * map the file.
+   */
+
+  if (ioctl(loadinfo->filfd, FIOC_XIPBASE, (unsigned long)&xipbase) >= 0 &&
+      xipbase != 0)
+    {
+      loadinfo->strtab    = (FAR const char *)xipbase + strhdr->sh_offset;
+      loadinfo->strmapped = true;
+    }
+  else
+    {
+      strtab = lib_malloc(strhdr->sh_size);
+      if (strtab == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout;
+        }
+
+      loadinfo->strtab    = strtab;
+      loadinfo->strmapped = false;
+
+      ret = modlib_read(loadinfo, (FAR uint8_t *)strtab, strhdr->sh_size,
+                        strhdr->sh_offset);
+      if (ret < 0)
+        {
+          berr("ERROR: Failed to read the string table: %d\n", ret);
+          goto errout;
+        }
+    }
+
+  /* The names are used in place, the table must end with a terminator */
+
+  if (loadinfo->strtab[strhdr->sh_size - 1] != '\0')
+    {
+      berr("ERROR: String table not terminated\n");
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  return OK;
+
+errout:
+  if (loadinfo->strtab != NULL && !loadinfo->strmapped)
+    {
+      lib_free((FAR void *)loadinfo->strtab);
+    }
+
+  lib_free(loadinfo->symresolved);
+  lib_free(loadinfo->symtab);
+  loadinfo->strtab      = NULL;
+  loadinfo->symresolved = NULL;
+  loadinfo->symtab      = NULL;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: modlib_getsym
+ *
+ * Description:
+ *   Return a symbol of the symbol table loaded by modlib_loadsyms(), its
+ *   value resolved by modlib_symvalue() on the first use only.
+ *
+ * Input Parameters:
+ *   modp     - Module state information
+ *   loadinfo - Load state information
+ *   index    - Symbol table index
+ *   exports  - Pointer to the symbol table
+ *   nexports - Number of symbols in the symbol table
+ *   sym      - Location to return the symbol
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int modlib_getsym(FAR struct module_s *modp,
+                  FAR struct mod_loadinfo_s *loadinfo, int index,
+                  FAR const struct symtab_s *exports, int nexports,
+                  FAR Elf_Sym **sym)
+{
+  FAR Elf_Shdr *symhdr = &loadinfo->shdr[loadinfo->symtabidx];
+  uint8_t mask = 1 << (index & 7);
+  int ret;
+
+  if (index < 0 || index >= symhdr->sh_size / sizeof(Elf_Sym))
+    {
+      berr("ERROR: Bad relocation symbol index: %d\n", index);
+      return -EINVAL;
+    }
+
+  *sym = &loadinfo->symtab[index];
+  if ((loadinfo->symresolved[index >> 3] & mask) != 0)
+    {
+      return OK;
+    }
+
+  /* A symbol without a name (-ESRCH) is left as it is, some relocations
+   * do not need a named symbol.
+   */
+
+  ret = modlib_symvalue(modp, loadinfo, *sym,
+                        loadinfo->shdr[loadinfo->strtabidx].sh_offset,
+                        exports, nexports);
+  if (ret < 0 && ret != -ESRCH)
+    {
+      return ret;
+    }
+
+  loadinfo->symresolved[index >> 3] |= mask;
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: modlib_symvalue
  *
@@ -344,6 +534,7 @@ int modlib_symvalue(FAR struct module_s *modp,
 {
   FAR const struct symtab_s *symbol;
   struct mod_exportinfo_s exportinfo;
+  FAR const char *name;
   uintptr_t secbase;
   int ret;
 
@@ -369,7 +560,7 @@ int modlib_symvalue(FAR struct module_s *modp,
       {
         /* Get the name of the undefined symbol */
 
-        ret = modlib_symname(loadinfo, sym, sh_offset);
+        ret = modlib_symname(loadinfo, sym, sh_offset, &name);
         if (ret < 0)
           {
             /* There are a few relocations for a few architectures that do
@@ -388,7 +579,7 @@ int modlib_symvalue(FAR struct module_s *modp,
          * recently installed will take precedence.
          */
 
-        exportinfo.name   = (FAR const char *)loadinfo->iobuffer;
+        exportinfo.name   = name;
         exportinfo.modp   = modp;
         exportinfo.symbol = NULL;
 
@@ -417,7 +608,7 @@ int modlib_symvalue(FAR struct module_s *modp,
         if (symbol == NULL)
           {
             berr("ERROR: SHN_UNDEF: Exported symbol \"%s\" not found\n",
-                 loadinfo->iobuffer);
+                 name);
             return -ENOENT;
           }
 
@@ -427,7 +618,7 @@ int modlib_symvalue(FAR struct module_s *modp,
 
         binfo("SHN_UNDEF: name=%s "
               "%08" PRIxPTR "+%08" PRIxPTR "=%08" PRIxPTR "\n",
-              loadinfo->iobuffer,
+              name,
               (uintptr_t)sym->st_value, (uintptr_t)symbol->sym_value,
               (uintptr_t)(sym->st_value + (uintptr_t)symbol->sym_value));
 
@@ -483,6 +674,7 @@ int modlib_insertsymtab(FAR struct module_s *modp,
 {
   FAR struct symtab_s *symbol;
   FAR Elf_Shdr *strtab = &loadinfo->shdr[shdr->sh_link];
+  FAR const char *name;
   int ret = 0;
   int i;
   int j;
@@ -526,7 +718,8 @@ int modlib_insertsymtab(FAR struct module_s *modp,
                   ELF_ST_TYPE(sym[i].st_info) != STT_NOTYPE &&
                   ELF_ST_VISIBILITY(sym[i].st_other) == STV_DEFAULT)
                 {
-                  ret = modlib_symname(loadinfo, &sym[i], strtab->sh_offset);
+                  ret = modlib_symname(loadinfo, &sym[i], strtab->sh_offset,
+                                       &name);
                   if (ret < 0)
                     {
                       lib_free((FAR void *)modp->modinfo.exports);
@@ -534,14 +727,37 @@ int modlib_insertsymtab(FAR struct module_s *modp,
                       return ret;
                     }
 
-                  symbol[j].sym_name =
-                      strdup((FAR char *)loadinfo->iobuffer);
+#ifdef CONFIG_MODLIB_LOADSYMS
+                  if (loadinfo->strtab != NULL && !loadinfo->strmapped &&
+                      shdr->sh_link == loadinfo->strtabidx)
+                    {
+                      symbol[j].sym_name = name;
+                    }
+                  else
+#endif
+                    {
+                      symbol[j].sym_name = strdup(name);
+                    }
+
                   symbol[j].sym_value =
                       (FAR const void *)(uintptr_t)sym[i].st_value;
                   j++;
                 }
             }
 
+#ifdef CONFIG_MODLIB_LOADSYMS
+          /* The names point in the loaded string table:  the module keeps
+           * it instead of a copy of each name.
+           */
+
+          if (loadinfo->strtab != NULL && !loadinfo->strmapped &&
+              shdr->sh_link == loadinfo->strtabidx)
+            {
+              modp->strtab     = (FAR char *)loadinfo->strtab;
+              loadinfo->strtab = NULL;
+            }
+#endif
+
 #ifdef CONFIG_SYMTAB_ORDEREDBYNAME
           symtab_sortbyname(symbol, symcount);
 #endif
@@ -591,17 +807,18 @@ void *modlib_findglobal(FAR struct module_s *modp,
                         FAR Elf_Shdr *shdr, FAR Elf_Sym *sym)
 {
   FAR Elf_Shdr *strtab = &loadinfo->shdr[shdr->sh_link];
+  FAR const char *name;
   int ret;
   struct eptable_s key;
   FAR struct eptable_s *res;
 
-  ret = modlib_symname(loadinfo, sym, strtab->sh_offset);
+  ret = modlib_symname(loadinfo, sym, strtab->sh_offset, &name);
   if (ret < 0)
     {
       return NULL;
     }
 
-  key.epname = loadinfo->iobuffer;
+  key.epname = (FAR uint8_t *)name;
   res = bsearch(&key, global_table, nglobals,
                 sizeof(struct eptable_s), findep);
   if (res != NULL)
@@ -632,9 +849,21 @@ void modlib_freesymtab(FAR struct module_s *modp)
 
   if ((symbol = modp->modinfo.exports) != NULL)
     {
-      for (i = 0; i < modp->modinfo.nexports; i++)
+#ifdef CONFIG_MODLIB_LOADSYMS
+      if (modp->strtab != NULL)
         {
-          lib_free((FAR void *)symbol[i].sym_name);
+          /* The names are in the string table of the module */
+
+          lib_free(modp->strtab);
+          modp->strtab = NULL;
+        }
+      else
+#endif
+        {
+          for (i = 0; i < modp->modinfo.nexports; i++)
+            {
+              lib_free((FAR void *)symbol[i].sym_name);
+            }
         }
 
       lib_free((FAR void *)symbol);
@@ -0,0 +1,419 @@
+/****************************************************************************
+ * libs/libc/modlib/modlib_textcache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/crc32.h>
+#include <nuttx/mutex.h>
+#include <nuttx/lib/lib.h>
+#include <nuttx/lib/modlib.h>
+
+#include "libc.h"
+#include "modlib/modlib.h"
+
+#ifdef CONFIG_MODLIB_SHARED_TEXT
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Size of the chunks in which the text is read back to be checksummed */
+
+#define MODLIB_TEXT_CHUNK 512
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The text of a position independent program, shared by all the
+ * instances loaded from the same file.  The text is never relocated, all
+ * the references to the data go through the per-instance GOT.
+ */
+
+struct modlib_text_s
+{
+  FAR struct modlib_text_s *flink;
+  off_t filelen;               /* Length, modification time and serial    */
+  struct timespec filemtime;   /* number of the file, to tell a replaced  */
+  ino_t fileino;               /* file                                    */
+  uint32_t textcrc;            /* CRC-32 of the text sections in the file */
+  uintptr_t textalloc;         /* The shared text */
+  size_t textsize;             /* Size of the text allocation */
+  int crefs;                   /* Number of instances using the text */
+  char filename[1];            /* Path of the file the text was read from */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR struct modlib_text_s *g_modlib_text;
+static mutex_t g_modlib_text_lock = NXMUTEX_INITIALIZER;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: modlib_text_section
+ *
+ * Description:
+ *   Return true if modlib_loadfile() places a section in the text
+ *   allocation.
+ *
+ ****************************************************************************/
+
+static bool modlib_text_section(FAR const Elf_Shdr *shdr)
+{
+  if ((shdr->sh_flags & SHF_ALLOC) == 0 || shdr->sh_size == 0 ||
+      (shdr->sh_flags & SHF_WRITE) != 0)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_ARCH_HAVE_TEXT_HEAP_WORD_ALIGNED_READ
+  if ((shdr->sh_flags & SHF_EXECINSTR) == 0)
+    {
+      return false;
+    }
+#endif
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: modlib_text_shareable
+ *
+ * Description:
+ *   Return true if the text of a program can be shared:  a position
+ *   independent executable (ET_EXEC with a GOT, as linked with
+ *   --emit-relocs and bound by binfmt/elf.c), with its text in RAM and no
+ *   content specific to one instance.
+ *
+ *   For such a program, modlib_relocate() does not write to the read-only
+ *   sections:  it only reads there the GOT slot of an undefined symbol and
+ *   fills the GOT.  The text is thus the same for every instance, unless
+ *   the GOT itself is read-only and loaded with the text, or the text is
+ *   the target of SHT_RELA relocations, which modlib_relocateadd() always
+ *   applies.
+ *
+ ****************************************************************************/
+
+static bool modlib_text_shareable(FAR struct mod_loadinfo_s *loadinfo)
+{
+  FAR const Elf_Shdr *shdr;
+  int i;
+
+  if (loadinfo->filename == NULL ||
+      loadinfo->ehdr.e_type != ET_EXEC ||
+      loadinfo->gotindex < 0 ||
+      loadinfo->xipbase != 0 ||
+      loadinfo->textsize == 0)
+    {
+      return false;
+    }
+
+  if (modlib_text_section(&loadinfo->shdr[loadinfo->gotindex]))
+    {
+      return false;
+    }
+
+  for (i = 1; i < loadinfo->ehdr.e_shnum; i++)
+    {
+      shdr = &loadinfo->shdr[i];
+      if (shdr->sh_type == SHT_RELA &&
+          shdr->sh_info < loadinfo->ehdr.e_shnum &&
+          modlib_text_section(&loadinfo->shdr[shdr->sh_info]))
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: modlib_text_crc
+ *
+ * Description:
+ *   Compute the CRC-32 of the text sections of a program.  Before
+ *   modlib_loadfile() it is read from the file, after it from the memory
+ *   the sections were loaded to:  both give the same result.
+ *
+ * Returned Value:
+ *   0 (OK) on success and a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static int modlib_text_crc(FAR struct mod_loadinfo_s *loadinfo,
+                           bool loaded, FAR uint32_t *crc)
+{
+  FAR const Elf_Shdr *shdr;
+  FAR uint8_t *buffer = NULL;
+  size_t offset;
+  size_t nbytes;
+  int ret = OK;
+  int i;
+
+  if (!loaded)
+    {
+      buffer = lib_malloc(MODLIB_TEXT_CHUNK);
+      if (buffer == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  *crc = 0;
+  for (i = 1; i < loadinfo->ehdr.e_shnum && ret >= 0; i++)
+    {
+      shdr = &loadinfo->shdr[i];
+      if (!modlib_text_section(shdr) || shdr->sh_type == SHT_NOBITS)
+        {
+          continue;
+        }
+
+      if (loaded)
+        {
+          *crc = crc32part((FAR const uint8_t *)(uintptr_t)shdr->sh_addr,
+                           shdr->sh_size, *crc);
+          continue;
+        }
+
+      for (offset = 0; offset < shdr->sh_size; offset += nbytes)
+        {
+          nbytes = MIN(shdr->sh_size - offset, MODLIB_TEXT_CHUNK);
+          ret = modlib_read(loadinfo, buffer, nbytes,
+                            shdr->sh_offset + offset);
+          if (ret < 0)
+            {
+              break;
+            }
+
+          *crc = crc32part(buffer, nbytes, *crc);
+        }
+    }
+
+  lib_free(buffer);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: modlib_text_attach
+ *
+ * Description:
+ *   Reuse the text of an instance of the same module already loaded:  set
+ *   textalloc and textshared in the load information.
+ *
+ ****************************************************************************/
+
+void modlib_text_attach(FAR struct mod_loadinfo_s *loadinfo)
+{
+  FAR struct modlib_text_s *text;
+  bool checked = false;
+  uint32_t crc;
+
+  if (!modlib_text_shareable(loadinfo))
+    {
+      return;
+    }
+
+  nxmutex_lock(&g_modlib_text_lock);
+
+  for (text = g_modlib_text; text != NULL; text = text->flink)
+    {
+      if (text->filelen == loadinfo->filelen &&
+          text->filemtime.tv_sec == loadinfo->filemtime.tv_sec &&
+          text->filemtime.tv_nsec == loadinfo->filemtime.tv_nsec &&
+          text->fileino == loadinfo->fileino &&
+          text->textsize == loadinfo->textsize &&
+          strcmp(text->filename, loadinfo->filename) == 0)
+        {
+          /* The file may have been replaced by another one with the same
+           * length and time stamp, where the serial numbers are not kept
+           * by the file system:  the text read back must be the same.
+           */
+
+          if (!checked)
+            {
+              if (modlib_text_crc(loadinfo, false, &crc) < 0)
+                {
+                  break;
+                }
+
+              checked = true;
+            }
+
+          if (text->textcrc != crc)
+            {
+              continue;
+            }
+
+          text->crefs++;
+          loadinfo->textalloc  = text->textalloc;
+          loadinfo->textshared = true;
+
+          binfo("Sharing the text of %s at %08lx, %d users\n",
+                text->filename, (unsigned long)text->textalloc,
+                text->crefs);
+          break;
+        }
+    }
+
+  nxmutex_unlock(&g_modlib_text_lock);
+}
+
+/****************************************************************************
+ * Name: modlib_text_insert
+ *
+ * Description:
+ *   Make the text of a module just loaded available to the next instances
+ *   of the same module.  Nothing is done if the text cannot be shared or
+ *   is already shared.
+ *
+ ****************************************************************************/
+
+void modlib_text_insert(FAR struct mod_loadinfo_s *loadinfo)
+{
+  FAR struct modlib_text_s *text;
+  size_t namelen;
+
+  if (loadinfo->textshared || !modlib_text_shareable(loadinfo))
+    {
+      return;
+    }
+
+  /* If this fails, the text is simply not shared */
+
+  namelen = strlen(loadinfo->filename);
+  text = lib_zalloc(sizeof(struct modlib_text_s) + namelen);
+  if (text == NULL)
+    {
+      return;
+    }
+
+  if (modlib_text_crc(loadinfo, true, &text->textcrc) < 0)
+    {
+      lib_free(text);
+      return;
+    }
+
+  memcpy(text->filename, loadinfo->filename, namelen + 1);
+  text->filelen   = loadinfo->filelen;
+  text->filemtime = loadinfo->filemtime;
+  text->fileino   = loadinfo->fileino;
+  text->textalloc = loadinfo->textalloc;
+  text->textsize  = loadinfo->textsize;
+  text->crefs     = 1;
+
+  nxmutex_lock(&g_modlib_text_lock);
+  text->flink   = g_modlib_text;
+  g_modlib_text = text;
+  nxmutex_unlock(&g_modlib_text_lock);
+
+  loadinfo->textshared = true;
+}
+
+/****************************************************************************
+ * Name: modlib_text_release
+ *
+ * Description:
+ *   Release a reference to a shared text, freeing it with the last one.
+ *
+ * Input Parameters:
+ *   textalloc - The text of a module
+ *
+ * Returned Value:
+ *   true if the text is shared, it must not be freed by the caller then.
+ *
+ ****************************************************************************/
+
+bool modlib_text_release(uintptr_t textalloc)
+{
+  FAR struct modlib_text_s *prev = NULL;
+  FAR struct modlib_text_s *text;
+
+  if (textalloc == 0)
+    {
+      return false;
+    }
+
+  nxmutex_lock(&g_modlib_text_lock);
+
+  for (text = g_modlib_text; text != NULL; prev = text, text = text->flink)
+    {
+      if (text->textalloc == textalloc)
+        {
+          break;
+        }
+    }
+
+  if (text == NULL)
+    {
+      nxmutex_unlock(&g_modlib_text_lock);
+      return false;
+    }
+
+  if (--text->crefs > 0)
+    {
+      nxmutex_unlock(&g_modlib_text_lock);
+      return true;
+    }
+
+  if (prev != NULL)
+    {
+      prev->flink = text->flink;
+    }
+  else
+    {
+      g_modlib_text = text->flink;
+    }
+
+  nxmutex_unlock(&g_modlib_text_lock);
+
+#ifdef CONFIG_ARCH_USE_TEXT_HEAP
+  up_textheap_free((FAR void *)text->textalloc);
+#else
+  lib_free((FAR void *)text->textalloc);
+#endif
+
+  lib_free(text);
+  return true;
+}
+
+#endif /* CONFIG_MODLIB_SHARED_TEXT */
@@ -104,5 +104,29 @@ int modlib_freebuffers(FAR struct mod_loadinfo_s *loadinfo)
       loadinfo->buflen   = 0;
     }
 
+#ifdef CONFIG_MODLIB_LOADSYMS
+  if (loadinfo->symtab != NULL)
+    {
+      lib_free(loadinfo->symtab);
+      loadinfo->symtab = NULL;
+    }
+
+  if (loadinfo->symresolved != NULL)
+    {
+      lib_free(loadinfo->symresolved);
+      loadinfo->symresolved = NULL;
+    }
+
+  if (loadinfo->strtab != NULL)
+    {
+      if (!loadinfo->strmapped)
+        {
+          lib_free((FAR void *)loadinfo->strtab);
+        }
+
+      loadinfo->strtab = NULL;
+    }
+#endif
+
   return OK;
 }
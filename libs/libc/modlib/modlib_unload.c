@@ -100,7 +100,8 @@ int modlib_unload(FAR struct mod_loadinfo_s *loadinfo)
 
       lib_free(loadinfo->sectalloc);
 #else
-      if (loadinfo->textalloc != 0 && loadinfo->xipbase == 0)
+      if (loadinfo->textalloc != 0 && loadinfo->xipbase == 0 &&
+          !modlib_text_release(loadinfo->textalloc))
         {
 #  if defined(CONFIG_ARCH_USE_TEXT_HEAP)
           up_textheap_free((FAR void *)loadinfo->textalloc);
@@ -109,7 +110,8 @@ int modlib_unload(FAR struct mod_loadinfo_s *loadinfo)
 #  endif
         }
 
-      if (loadinfo->datastart != 0)
+      if (loadinfo->datastart != 0 &&
+          !modlib_prelink_release(loadinfo->datastart))
         {
 #  if defined(CONFIG_ARCH_USE_DATA_HEAP)
           up_dataheap_free((FAR void *)loadinfo->datastart);
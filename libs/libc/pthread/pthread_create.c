@@ -29,6 +29,7 @@
 #include <assert.h>
 
 #include <nuttx/pthread.h>
+#include <nuttx/tls.h>
 
 /****************************************************************************
  * Private Functions
@@ -88,6 +89,12 @@ static void pthread_startup(pthread_startroutine_t entry,
 int pthread_create(FAR pthread_t *thread, FAR const pthread_attr_t *attr,
                    pthread_startroutine_t pthread_entry, pthread_addr_t arg)
 {
+#ifdef CONFIG_STDIO_LOCK_ELISION
+  /* The streams are shared from now on, they must be locked */
+
+  task_get_info()->ta_threaded = true;
+#endif
+
   return nx_pthread_create(pthread_startup, thread, attr, pthread_entry,
                            arg);
 }
@@ -0,0 +1,541 @@
+/****************************************************************************
+ * libs/libc/search/hashmap.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include <nuttx/hashmap.h>
+#include <nuttx/hashtable.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define HASHMAP_MIN_BITS 3
+#define HASHMAP_MAX_BITS (sizeof(size_t) > 4 ? 31 : 26)
+
+/* The map grows when it is 3/4 full */
+
+#define HASHMAP_MAX_COUNT(bits) (((size_t)3 << (bits)) >> 2)
+
+/* The number of slots of the old array visited by each insertion and
+ * removal while the map grows:  the move takes less than (1 << oldbits) / 4
+ * insertions, it is over long before the map grows again after
+ * (3 << oldbits) / 4 insertions.
+ */
+
+#define HASHMAP_MIGRATE  8
+
+/* The first slot of a hash, its "home", and the distance of a slot from
+ * the home of its entry.
+ */
+
+#define HASHMAP_HOME(hash, bits) ((size_t)((hash) >> (32 - (bits))))
+#define HASHMAP_DIST(idx, hash, bits) \
+  (((idx) - HASHMAP_HOME(hash, bits)) & (((size_t)1 << (bits)) - 1))
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+extern uint32_t (*g_default_hash)(FAR const void *, size_t);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hashmap_hash
+ *
+ * Description:
+ *   The hash of a key, scrambled so that its upper bits, which select the
+ *   home slot, depend on all the bits.  0 marks the empty slots.
+ *
+ ****************************************************************************/
+
+static uint32_t hashmap_hash(FAR const struct hashmap_s *map,
+                             FAR const void *key)
+{
+  uintptr_t ptr = (uintptr_t)key;
+  uint32_t hash;
+
+  if (map->hash != NULL)
+    {
+      hash = map->hash(key);
+    }
+  else
+    {
+      hash = (uint32_t)ptr;
+      if (sizeof(ptr) > sizeof(hash))
+        {
+          hash ^= (uint32_t)((uint64_t)ptr >> 32);
+        }
+    }
+
+  hash *= GOLDEN_RATIO_32;
+  return hash != 0 ? hash : 1;
+}
+
+static inline bool hashmap_equal(FAR const struct hashmap_s *map,
+                                 FAR const void *key1,
+                                 FAR const void *key2)
+{
+  return map->cmp != NULL ? map->cmp(key1, key2) == 0 : key1 == key2;
+}
+
+/****************************************************************************
+ * Name: hashmap_lookup
+ *
+ * Description:
+ *   Find the slot of a key in an array.  The search ends at an entry
+ *   closer to its home than the key would be:  Robin Hood insertion would
+ *   have put the key there.
+ *
+ ****************************************************************************/
+
+static FAR struct hashmap_slot_s *
+hashmap_lookup(FAR const struct hashmap_s *map,
+               FAR struct hashmap_slot_s *slots, uint8_t bits,
+               FAR const void *key, uint32_t hash)
+{
+  FAR struct hashmap_slot_s *slot;
+  size_t mask;
+  size_t dist;
+  size_t idx;
+
+  if (slots == NULL)
+    {
+      return NULL;
+    }
+
+  mask = ((size_t)1 << bits) - 1;
+  idx  = HASHMAP_HOME(hash, bits);
+
+  for (dist = 0; ; dist++)
+    {
+      slot = &slots[idx];
+      if (slot->hash == 0 || HASHMAP_DIST(idx, slot->hash, bits) < dist)
+        {
+          return NULL;
+        }
+
+      if (slot->hash == hash && hashmap_equal(map, slot->key, key))
+        {
+          return slot;
+        }
+
+      idx = (idx + 1) & mask;
+    }
+}
+
+/****************************************************************************
+ * Name: hashmap_place
+ *
+ * Description:
+ *   Put an entry, known not to be in the array, in an array which has an
+ *   empty slot.  On the way, an entry closer to its home than the one
+ *   being placed gives its slot away and is placed further instead.
+ *
+ ****************************************************************************/
+
+static void hashmap_place(FAR struct hashmap_slot_s *slots, uint8_t bits,
+                          FAR const struct hashmap_slot_s *entry)
+{
+  FAR struct hashmap_slot_s *slot;
+  struct hashmap_slot_s cur = *entry;
+  struct hashmap_slot_s tmp;
+  size_t mask = ((size_t)1 << bits) - 1;
+  size_t idx = HASHMAP_HOME(cur.hash, bits);
+  size_t dist = 0;
+  size_t sdist;
+
+  for (; ; )
+    {
+      slot = &slots[idx];
+      if (slot->hash == 0)
+        {
+          *slot = cur;
+          return;
+        }
+
+      sdist = HASHMAP_DIST(idx, slot->hash, bits);
+      if (sdist < dist)
+        {
+          tmp   = *slot;
+          *slot = cur;
+          cur   = tmp;
+          dist  = sdist;
+        }
+
+      idx = (idx + 1) & mask;
+      dist++;
+    }
+}
+
+/****************************************************************************
+ * Name: hashmap_erase
+ *
+ * Description:
+ *   Empty a slot, and shift back the following entries which are not in
+ *   their home slot:  the array stays as if the entry was never inserted.
+ *
+ ****************************************************************************/
+
+static void hashmap_erase(FAR struct hashmap_slot_s *slots, uint8_t bits,
+                          FAR struct hashmap_slot_s *slot)
+{
+  size_t mask = ((size_t)1 << bits) - 1;
+  size_t idx = slot - slots;
+  size_t next;
+
+  for (; ; )
+    {
+      next = (idx + 1) & mask;
+      if (slots[next].hash == 0 ||
+          HASHMAP_DIST(next, slots[next].hash, bits) == 0)
+        {
+          break;
+        }
+
+      slots[idx] = slots[next];
+      idx        = next;
+    }
+
+  slots[idx].hash = 0;
+}
+
+/****************************************************************************
+ * Name: hashmap_migrate
+ *
+ * Description:
+ *   Move the entries of the old array to the current one, visiting up to
+ *   steps slots.  The entries are erased from the old array, which stays
+ *   consistent for the lookups:  the slots left behind are empty, and
+ *   erasing only shifts entries into slots which were in use.
+ *
+ ****************************************************************************/
+
+static void hashmap_migrate(FAR struct hashmap_s *map, size_t steps)
+{
+  FAR struct hashmap_slot_s *slot;
+
+  while (map->old != NULL && steps-- > 0)
+    {
+      slot = &map->old[map->migrate];
+      if (slot->hash != 0)
+        {
+          hashmap_place(map->slots, map->bits, slot);
+          hashmap_erase(map->old, map->oldbits, slot);
+          map->oldcount--;
+        }
+      else
+        {
+          map->migrate++;
+        }
+
+      if (map->oldcount == 0)
+        {
+          lib_free(map->old);
+          map->old = NULL;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: hashmap_grow
+ *
+ * Description:
+ *   Allocate an array of 1 << bits slots, the current one becomes the old
+ *   one, moved by the next insertions and removals.
+ *
+ ****************************************************************************/
+
+static int hashmap_grow(FAR struct hashmap_s *map, uint8_t bits)
+{
+  FAR struct hashmap_slot_s *slots;
+
+  if (bits > HASHMAP_MAX_BITS)
+    {
+      return -ENOMEM;
+    }
+
+  slots = lib_zalloc(sizeof(*slots) << bits);
+  if (slots == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* Not expected, but a growth before the end of the previous one first
+   * ends it.
+   */
+
+  hashmap_migrate(map, SIZE_MAX);
+
+  if (map->count > 0)
+    {
+      map->old      = map->slots;
+      map->oldbits  = map->bits;
+      map->oldcount = map->count;
+      map->migrate  = 0;
+    }
+  else
+    {
+      lib_free(map->slots);
+    }
+
+  map->slots = slots;
+  map->bits  = bits;
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hashmap_init
+ *
+ * Description:
+ *   Initialize a hash map, with room for nel entries.
+ *
+ ****************************************************************************/
+
+int hashmap_init(FAR struct hashmap_s *map, size_t nel,
+                 hashmap_hash_t hash, hashmap_cmp_t cmp)
+{
+  uint8_t bits = HASHMAP_MIN_BITS;
+
+  memset(map, 0, sizeof(*map));
+  map->hash = hash;
+  map->cmp  = cmp;
+
+  if (nel == 0)
+    {
+      return 0;
+    }
+
+  while (bits <= HASHMAP_MAX_BITS && HASHMAP_MAX_COUNT(bits) < nel)
+    {
+      bits++;
+    }
+
+  return hashmap_grow(map, bits);
+}
+
+/****************************************************************************
+ * Name: hashmap_uninit
+ *
+ * Description:
+ *   Free the memory of a hash map.
+ *
+ ****************************************************************************/
+
+void hashmap_uninit(FAR struct hashmap_s *map)
+{
+  lib_free(map->slots);
+  lib_free(map->old);
+  map->slots    = NULL;
+  map->old      = NULL;
+  map->count    = 0;
+  map->oldcount = 0;
+  map->bits     = 0;
+}
+
+/****************************************************************************
+ * Name: hashmap_insert
+ *
+ * Description:
+ *   Insert an entry.
+ *
+ ****************************************************************************/
+
+int hashmap_insert(FAR struct hashmap_s *map, FAR void *key,
+                   FAR void *data)
+{
+  struct hashmap_slot_s entry;
+  int ret;
+
+  entry.hash = hashmap_hash(map, key);
+  entry.key  = key;
+  entry.data = data;
+
+  if (hashmap_lookup(map, map->slots, map->bits, key, entry.hash) != NULL ||
+      hashmap_lookup(map, map->old, map->oldbits, key, entry.hash) != NULL)
+    {
+      return -EEXIST;
+    }
+
+  if (map->slots == NULL || map->count >= HASHMAP_MAX_COUNT(map->bits))
+    {
+      ret = hashmap_grow(map, map->slots == NULL ? HASHMAP_MIN_BITS :
+                                                   map->bits + 1);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  hashmap_place(map->slots, map->bits, &entry);
+  map->count++;
+
+  hashmap_migrate(map, HASHMAP_MIGRATE);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: hashmap_find
+ *
+ * Description:
+ *   Look up a key.
+ *
+ ****************************************************************************/
+
+FAR void *hashmap_find(FAR const struct hashmap_s *map,
+                       FAR const void *key)
+{
+  FAR struct hashmap_slot_s *slot;
+  uint32_t hash;
+
+  if (map->count == 0)
+    {
+      return NULL;
+    }
+
+  hash = hashmap_hash(map, key);
+  slot = hashmap_lookup(map, map->slots, map->bits, key, hash);
+  if (slot == NULL)
+    {
+      slot = hashmap_lookup(map, map->old, map->oldbits, key, hash);
+    }
+
+  return slot != NULL ? slot->data : NULL;
+}
+
+/****************************************************************************
+ * Name: hashmap_remove
+ *
+ * Description:
+ *   Remove the entry of a key.
+ *
+ ****************************************************************************/
+
+FAR void *hashmap_remove(FAR struct hashmap_s *map, FAR const void *key)
+{
+  FAR struct hashmap_slot_s *slot;
+  FAR void *data;
+  uint32_t hash;
+
+  if (map->count == 0)
+    {
+      return NULL;
+    }
+
+  hash = hashmap_hash(map, key);
+  slot = hashmap_lookup(map, map->slots, map->bits, key, hash);
+  if (slot != NULL)
+    {
+      data = slot->data;
+      hashmap_erase(map->slots, map->bits, slot);
+    }
+  else
+    {
+      slot = hashmap_lookup(map, map->old, map->oldbits, key, hash);
+      if (slot == NULL)
+        {
+          return NULL;
+        }
+
+      data = slot->data;
+      hashmap_erase(map->old, map->oldbits, slot);
+      map->oldcount--;
+    }
+
+  map->count--;
+  hashmap_migrate(map, HASHMAP_MIGRATE);
+  return data;
+}
+
+/****************************************************************************
+ * Name: hashmap_next
+ *
+ * Description:
+ *   Get the next entry of an iteration over the map:  the positions are
+ *   the slots of the current array, then those of the old one.
+ *
+ ****************************************************************************/
+
+bool hashmap_next(FAR const struct hashmap_s *map, FAR size_t *iter,
+                  FAR void **key, FAR void **data)
+{
+  FAR struct hashmap_slot_s *slot;
+  size_t size = map->slots != NULL ? (size_t)1 << map->bits : 0;
+  size_t oldsize = map->old != NULL ? (size_t)1 << map->oldbits : 0;
+
+  for (; *iter < size + oldsize; (*iter)++)
+    {
+      slot = *iter < size ? &map->slots[*iter] :
+                            &map->old[*iter - size];
+      if (slot->hash != 0)
+        {
+          *key  = slot->key;
+          *data = slot->data;
+          (*iter)++;
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: hashmap_strhash
+ *
+ * Description:
+ *   The hash of a string key, the default hash of hsearch().
+ *
+ ****************************************************************************/
+
+uint32_t hashmap_strhash(FAR const void *key)
+{
+  return g_default_hash(key, strlen(key));
+}
+
+/****************************************************************************
+ * Name: hashmap_strcmp
+ *
+ * Description:
+ *   Compare two string keys.
+ *
+ ****************************************************************************/
+
+int hashmap_strcmp(FAR const void *key1, FAR const void *key2)
+{
+  return strcmp(key1, key2);
+}
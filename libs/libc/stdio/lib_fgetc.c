@@ -25,6 +25,9 @@
  ****************************************************************************/
 
 #include <stdio.h>
+
+#include <nuttx/fs/fs.h>
+
 #include "libc.h"
 
 /****************************************************************************
@@ -40,6 +43,19 @@ int fgetc_unlocked(FAR FILE *stream)
   unsigned char ch;
   ssize_t ret;
 
+#ifndef CONFIG_STDIO_DISABLE_BUFFERING
+  /* Take the character directly from the read buffer if there is one */
+
+  if (stream != NULL && stream->fs_bufpos < stream->fs_bufread
+#  if CONFIG_NUNGET_CHARS > 0
+      && stream->fs_nungotten == 0
+#  endif
+     )
+    {
+      return (unsigned char)*stream->fs_bufpos++;
+    }
+#endif
+
   ret = lib_fread_unlocked(&ch, 1, stream);
   if (ret > 0)
     {
@@ -25,6 +25,10 @@
  ****************************************************************************/
 
 #include <stdio.h>
+#include <fcntl.h>
+
+#include <nuttx/fs/fs.h>
+
 #include "libc.h"
 
 /****************************************************************************
@@ -40,6 +44,21 @@ int fputc_unlocked(int c, FAR FILE *stream)
   unsigned char buf = (unsigned char)c;
   int ret;
 
+#ifndef CONFIG_STDIO_DISABLE_BUFFERING
+  /* Store the character directly if there is room in the write buffer,
+   * it does not fill it and it does not end a line to flush.
+   */
+
+  if (stream != NULL && stream->fs_bufend - stream->fs_bufpos > 1 &&
+      stream->fs_bufread == stream->fs_bufstart &&
+      (stream->fs_oflags & O_WROK) != 0 &&
+      (c != '\n' || (stream->fs_flags & __FS_FLAG_LBF) == 0))
+    {
+      *stream->fs_bufpos++ = (char)c;
+      return c;
+    }
+#endif
+
   ret = lib_fwrite_unlocked(&buf, 1, stream);
   if (ret > 0)
     {
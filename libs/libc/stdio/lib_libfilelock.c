@@ -33,8 +33,31 @@
 #include <assert.h>
 
 #include <nuttx/mutex.h>
+#include <nuttx/tls.h>
 #include <nuttx/fs/fs.h>
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_stream_threaded
+ *
+ * Description:
+ *   Return true if the streams of the calling task must be locked, that is
+ *   if it may share them with another thread.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_STDIO_LOCK_ELISION
+static inline bool lib_stream_threaded(void)
+{
+  return task_get_info()->ta_threaded;
+}
+#else
+#  define lib_stream_threaded() true
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -45,7 +68,10 @@
 
 void flockfile(FAR struct file_struct *stream)
 {
-  nxrmutex_lock(&stream->fs_lock);
+  if (lib_stream_threaded())
+    {
+      nxrmutex_lock(&stream->fs_lock);
+    }
 }
 
 /****************************************************************************
@@ -54,6 +80,11 @@ void flockfile(FAR struct file_struct *stream)
 
 int ftrylockfile(FAR struct file_struct *stream)
 {
+  if (!lib_stream_threaded())
+    {
+      return OK;
+    }
+
   return nxrmutex_trylock(&stream->fs_lock);
 }
 
@@ -63,5 +94,16 @@ int ftrylockfile(FAR struct file_struct *stream)
 
 void funlockfile(FAR struct file_struct *stream)
 {
+#ifdef CONFIG_STDIO_LOCK_ELISION
+  /* The first pthread may have been created with the stream "locked",
+   * there is nothing to unlock then.
+   */
+
+  if (!lib_stream_threaded() || !nxrmutex_is_hold(&stream->fs_lock))
+    {
+      return;
+    }
+#endif
+
   nxrmutex_unlock(&stream->fs_lock);
 }
@@ -194,6 +194,30 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
     {
       for (; ; )
         {
+#ifndef CONFIG_ARCH_ROMGETC
+          /* Output the text up to the next conversion at once, a single
+           * character is output below.
+           */
+
+          for (pnt = fmt; *fmt != '\0' && *fmt != '%'; fmt++);
+
+          if (fmt - pnt == 1)
+            {
+              fmt = pnt;
+            }
+          else if (fmt != pnt)
+            {
+#  ifdef CONFIG_LIBC_NUMBERED_ARGS
+              if (stream != NULL)
+                {
+                  stream_puts(pnt, fmt - pnt, stream);
+                }
+#  else
+              stream_puts(pnt, fmt - pnt, stream);
+#  endif
+            }
+#endif
+
           c = fmt_char(fmt);
           if (c == '\0')
             {
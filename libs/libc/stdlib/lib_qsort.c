@@ -1,42 +1,22 @@
 /****************************************************************************
  * libs/libc/stdlib/lib_qsort.c
  *
- *   Copyright (C) 2007, 2009, 2011 Gregory Nutt. All rights reserved.
- *   Author: Gregory Nutt <gnutt@nuttx.org>
+ * SPDX-License-Identifier: Apache-2.0
  *
- * Leveraged from:
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
  *
- *  Copyright (c) 1992, 1993
- *  The Regents of the University of California.  All rights reserved.
+ *   http://www.apache.org/licenses/LICENSE-2.0
  *
- * Redistribution and use in source and binary forms, with or without
- * modification, are permitted provided that the following conditions
- * are met:
- *
- * 1. Redistributions of source code must retain the above copyright
- *    notice, this list of conditions and the following disclaimer.
- * 2. Redistributions in binary form must reproduce the above copyright
- *    notice, this list of conditions and the following disclaimer in the
- *    documentation and/or other materials provided with the distribution.
- * 3. All advertising materials mentioning features or use of this software
- *    must display the following acknowledgement:
- *    This product includes software developed by the University of
- *    California, Berkeley and its contributors.
- * 4. Neither the name of the University nor the names of its contributors
- *    may be used to endorse or promote products derived from this software
- *    without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
- * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
- * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
- * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
- * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
- * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
- * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
- * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
- * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
- * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
- * SUCH DAMAGE.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
  *
  ****************************************************************************/
 
@@ -47,250 +27,618 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
-#include <sys/param.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define swapcode(TYPE, parmi, parmj, n) \
-  { \
-    long i = (n) / sizeof(TYPE); \
-    register FAR TYPE *pi = (FAR TYPE *)(parmi); \
-    register FAR TYPE *pj = (FAR TYPE *)(parmj); \
-    do { \
-      register TYPE t = *pi; \
-      *pi++ = *pj; \
-      *pj++ = t; \
-    } while (--i > 0); \
-  }
-
-#define SWAPINIT(a, width) \
-  swaptype = (uintptr_t)a % sizeof(long) || \
-  width % sizeof(long) ? 2 : width == sizeof(long) ? 0 : 1;
-
-#define swap(a, b) \
-  if (swaptype == 0) \
-    { \
-      long t = *(FAR long *)(a); \
-      *(FAR long *)(a) = *(FAR long *)(b); \
-      *(FAR long *)(b) = t; \
-    } \
-  else \
-    { \
-      swapfunc(a, b, width, swaptype); \
-    }
+/* Partitions smaller than this are insertion sorted */
+
+#define QSORT_INSERTION   16
+
+/* Partitions larger than this take the pseudomedian of nine as pivot */
 
-#define vecswap(a, b, n) if ((n) > 0) swapfunc(a, b, n, swaptype)
+#define QSORT_NINTHER     128
+
+/* Moves allowed to the insertion sort of an already partitioned array,
+ * before giving up on it being sorted.
+ */
+
+#define QSORT_PARTIAL     8
+
+#define QSORT_AT(c, p, n) ((p) + (n) * (c)->width)
 
 /****************************************************************************
- * Private Function Prototypes
+ * Private Types
  ****************************************************************************/
 
-static inline void swapfunc(FAR char *a, FAR char *b, int n, int swaptype);
-static inline FAR char *med3(FAR char *a, FAR char *b, FAR char *c,
-                             CODE int (*compar)(FAR const void *,
-                             FAR const void *));
+/* How the elements are swapped, by their size and alignment */
+
+enum qsort_swap_e
+{
+  QSORT_SWAP_4 = 0,    /* One aligned 32-bit word */
+  QSORT_SWAP_8,        /* One aligned 64-bit word */
+  QSORT_SWAP_16,       /* Two aligned 64-bit words */
+  QSORT_SWAP_WORD,     /* A multiple of aligned 32-bit words */
+  QSORT_SWAP_BYTE      /* Anything else */
+};
+
+struct qsort_s
+{
+  size_t width;
+  enum qsort_swap_e swaptype;
+  CODE int (*compar)(FAR const void *, FAR const void *);
+  CODE int (*compar_r)(FAR const void *, FAR const void *, FAR void *);
+  FAR void *arg;
+};
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
-static inline void swapfunc(FAR char *a, FAR char *b, int n, int swaptype)
+/* Return true if the element at a sorts before the element at b */
+
+static inline bool qsort_less(FAR const struct qsort_s *c,
+                              FAR const char *a, FAR const char *b)
 {
-  if (swaptype <= 1)
+  if (c->compar != NULL)
     {
-      swapcode(long, a, b, n)
+      return c->compar(a, b) < 0;
     }
-  else
+
+  return c->compar_r(a, b, c->arg) < 0;
+}
+
+static inline void qsort_swap(FAR const struct qsort_s *c,
+                              FAR char *a, FAR char *b)
+{
+  switch (c->swaptype)
     {
-      swapcode(char, a, b, n)
+      case QSORT_SWAP_4:
+        {
+          uint32_t t = *(FAR uint32_t *)a;
+          *(FAR uint32_t *)a = *(FAR uint32_t *)b;
+          *(FAR uint32_t *)b = t;
+        }
+        break;
+
+      case QSORT_SWAP_8:
+        {
+          uint64_t t = *(FAR uint64_t *)a;
+          *(FAR uint64_t *)a = *(FAR uint64_t *)b;
+          *(FAR uint64_t *)b = t;
+        }
+        break;
+
+      case QSORT_SWAP_16:
+        {
+          uint64_t t0 = ((FAR uint64_t *)a)[0];
+          uint64_t t1 = ((FAR uint64_t *)a)[1];
+          ((FAR uint64_t *)a)[0] = ((FAR uint64_t *)b)[0];
+          ((FAR uint64_t *)a)[1] = ((FAR uint64_t *)b)[1];
+          ((FAR uint64_t *)b)[0] = t0;
+          ((FAR uint64_t *)b)[1] = t1;
+        }
+        break;
+
+      case QSORT_SWAP_WORD:
+        {
+          FAR uint32_t *pa = (FAR uint32_t *)a;
+          FAR uint32_t *pb = (FAR uint32_t *)b;
+          size_t n = c->width / sizeof(uint32_t);
+
+          do
+            {
+              uint32_t t = *pa;
+              *pa++ = *pb;
+              *pb++ = t;
+            }
+          while (--n > 0);
+        }
+        break;
+
+      default:
+        {
+          size_t n = c->width;
+
+          do
+            {
+              char t = *a;
+              *a++ = *b;
+              *b++ = t;
+            }
+          while (--n > 0);
+        }
+        break;
     }
 }
 
-static inline FAR char *med3(FAR char *a, FAR char *b, FAR char *c,
-                             CODE int (*compar)(FAR const void *,
-                             FAR const void *))
+static inline void qsort_sort2(FAR const struct qsort_s *c,
+                               FAR char *a, FAR char *b)
 {
-  return compar(a, b) < 0 ?
-         (compar(b, c) < 0 ? b : (compar(a, c) < 0 ? c : a)) :
-         (compar(b, c) > 0 ? b : (compar(a, c) < 0 ? a : c));
+  if (qsort_less(c, b, a))
+    {
+      qsort_swap(c, a, b);
+    }
 }
 
-/****************************************************************************
- * Public Function
- ****************************************************************************/
+static void qsort_sort3(FAR const struct qsort_s *c,
+                        FAR char *a, FAR char *b, FAR char *cc)
+{
+  qsort_sort2(c, a, b);
+  qsort_sort2(c, b, cc);
+  qsort_sort2(c, a, b);
+}
 
 /****************************************************************************
- * Name: qsort
+ * Name: qsort_insertion
  *
  * Description:
- *   The qsort() function will sort an array of 'nel' objects, the initial
- *   element of which is pointed to by 'base'. The size of each object, in
- *   bytes, is specified by the 'width" argument. If the 'nel' argument has
- *   the value zero, the comparison function pointed to by 'compar' will not
- *   be called and no rearrangement will take place.
+ *   Insertion sort [begin, end).  The search is always bounded by begin:
+ *   the element preceding the range is not relied upon as a sentinel,
+ *   the comparator may be inconsistent.
  *
- *   The application will ensure that the comparison function pointed to by
- *   'compar' does not alter the contents of the array. The implementation
- *   may reorder elements of the array between calls to the comparison
- *   function, but will not alter the contents of any individual element.
- *
- *   When the same objects (consisting of 'width" bytes, irrespective of
- *   their current positions in the array) are passed more than once to
- *   the comparison function, the results will be consistent with one
- *   another. That is, they will define a total ordering on the array.
- *
- *   The contents of the array will be sorted in ascending order according
- *   to a comparison function. The 'compar' argument is a pointer to the
- *   comparison function, which is called with two arguments that point to
- *   the elements being compared. The application will ensure that the
- *   function returns an integer less than, equal to, or greater than 0,
- *   if the first argument is considered respectively less than, equal to,
- *   or greater than the second. If two members compare as equal, their
- *   order in the sorted array is unspecified.
+ ****************************************************************************/
+
+static void qsort_insertion(FAR const struct qsort_s *c,
+                            FAR char *begin, FAR char *end)
+{
+  size_t width = c->width;
+  FAR char *cur;
+  FAR char *sift;
+
+  for (cur = begin + width; cur < end; cur += width)
+    {
+      for (sift = cur;
+           sift > begin && qsort_less(c, sift, sift - width);
+           sift -= width)
+        {
+          qsort_swap(c, sift, sift - width);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: qsort_partial_insertion
  *
- *   (Based on description from OpenGroup.org).
+ * Description:
+ *   Insertion sort [begin, end), giving up after QSORT_PARTIAL moves.
+ *   Return true if the range was sorted.
  *
- * Returned Value:
- *   The qsort() function will not return a value.
+ ****************************************************************************/
+
+static bool qsort_partial_insertion(FAR const struct qsort_s *c,
+                                    FAR char *begin, FAR char *end)
+{
+  size_t width = c->width;
+  size_t moves = 0;
+  FAR char *cur;
+  FAR char *sift;
+
+  for (cur = begin + width; cur < end; cur += width)
+    {
+      if (moves > QSORT_PARTIAL)
+        {
+          return false;
+        }
+
+      for (sift = cur;
+           sift > begin && qsort_less(c, sift, sift - width);
+           sift -= width)
+        {
+          qsort_swap(c, sift, sift - width);
+          moves++;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: qsort_heap
  *
- * Notes from the original BSD version:
- *   Qsort routine from Bentley & McIlroy's "Engineering a Sort Function".
+ * Description:
+ *   Heapsort the nel elements at begin, the fallback which bounds the
+ *   worst case to O(n log n).
  *
  ****************************************************************************/
 
-void qsort(FAR void *base, size_t nel, size_t width,
-           CODE int(*compar)(FAR const void *, FAR const void *))
+static void qsort_heap(FAR const struct qsort_s *c,
+                       FAR char *begin, size_t nel)
 {
-  FAR char *pa;
-  FAR char *pb;
-  FAR char *pc;
-  FAR char *pd;
-  FAR char *pl;
-  FAR char *pm;
-  FAR char *pn;
-  int swaptype;
-  int swap_cnt;
-  int d;
-  int r;
-
-loop:
-  SWAPINIT(base, width);
-  swap_cnt = 0;
-
-  if (nel < 7)
+  size_t start;
+  size_t root;
+  size_t child;
+
+  for (start = nel / 2; nel > 1; )
     {
-      for (pm = (FAR char *)base + width;
-           pm < (FAR char *)base + nel * width;
-           pm += width)
+      if (start > 0)
+        {
+          root = --start;
+        }
+      else
+        {
+          qsort_swap(c, begin, QSORT_AT(c, begin, --nel));
+          root = 0;
+        }
+
+      while ((child = 2 * root + 1) < nel)
         {
-          for (pl = pm;
-               pl > (FAR char *)base && compar(pl - width, pl) > 0;
-               pl -= width)
+          if (child + 1 < nel &&
+              qsort_less(c, QSORT_AT(c, begin, child),
+                         QSORT_AT(c, begin, child + 1)))
+            {
+              child++;
+            }
+
+          if (!qsort_less(c, QSORT_AT(c, begin, root),
+                          QSORT_AT(c, begin, child)))
             {
-              swap(pl, pl - width);
+              break;
             }
+
+          qsort_swap(c, QSORT_AT(c, begin, root),
+                     QSORT_AT(c, begin, child));
+          root = child;
         }
+    }
+}
 
-      return;
+/****************************************************************************
+ * Name: qsort_partition_right
+ *
+ * Description:
+ *   Partition [begin, end) around the pivot at begin, the elements equal
+ *   to the pivot going to the right.  Return the final position of the
+ *   pivot, and in *partitioned if no element had to be moved.
+ *
+ *   The scans are bounded by the range, not by the sentinels a strict weak
+ *   order would provide:  nothing outside [begin, end) is ever accessed,
+ *   whatever the comparator returns.
+ *
+ ****************************************************************************/
+
+static FAR char *qsort_partition_right(FAR const struct qsort_s *c,
+                                       FAR char *begin, FAR char *end,
+                                       FAR bool *partitioned)
+{
+  size_t width = c->width;
+  FAR char *first = begin;
+  FAR char *last = end;
+
+  while ((first += width) < end && qsort_less(c, first, begin));
+
+  if (first - width == begin)
+    {
+      while (first < last && !qsort_less(c, last -= width, begin));
     }
+  else
+    {
+      while ((last -= width) > begin && !qsort_less(c, last, begin));
+    }
+
+  *partitioned = first >= last;
 
-  pm = (FAR char *)base + (nel / 2) * width;
-  if (nel > 7)
+  while (first < last)
     {
-      pl = base;
-      pn = (FAR char *)base + (nel - 1) * width;
-      if (nel > 40)
-        {
-          d  = (nel / 8) * width;
-          pl = med3(pl, pl + d, pl + 2 * d, compar);
-          pm = med3(pm - d, pm, pm + d, compar);
-          pn = med3(pn - 2 * d, pn - d, pn, compar);
-        }
+      qsort_swap(c, first, last);
+      while ((first += width) < end && qsort_less(c, first, begin));
+      while ((last -= width) > begin && !qsort_less(c, last, begin));
+    }
+
+  first -= width;
+  qsort_swap(c, begin, first);
+  return first;
+}
+
+/****************************************************************************
+ * Name: qsort_partition_left
+ *
+ * Description:
+ *   Partition [begin, end) around the pivot at begin, the elements equal
+ *   to the pivot going to the left.  Used when the pivot is equal to the
+ *   element preceding the range:  none of the left part needs sorting.
+ *   The scans are bounded by the range, as in qsort_partition_right().
+ *
+ ****************************************************************************/
+
+static FAR char *qsort_partition_left(FAR const struct qsort_s *c,
+                                      FAR char *begin, FAR char *end)
+{
+  size_t width = c->width;
+  FAR char *first = begin;
+  FAR char *last = end;
 
-      pm = med3(pl, pm, pn, compar);
+  while ((last -= width) > begin && qsort_less(c, begin, last));
+
+  if (last + width == end)
+    {
+      while (first < last && !qsort_less(c, begin, first += width));
+    }
+  else
+    {
+      while ((first += width) < end && !qsort_less(c, begin, first));
     }
 
-  swap(base, pm);
-  pa = pb = (FAR char *)base + width;
+  while (first < last)
+    {
+      qsort_swap(c, first, last);
+      while ((last -= width) > begin && qsort_less(c, begin, last));
+      while ((first += width) < end && !qsort_less(c, begin, first));
+    }
+
+  qsort_swap(c, begin, last);
+  return last;
+}
+
+/****************************************************************************
+ * Name: qsort_loop
+ *
+ * Description:
+ *   Sort [begin, end).  badallowed is the number of unbalanced partitions
+ *   allowed before falling back to heapsort, and leftmost tells if there
+ *   is no element before begin to compare the pivot with.
+ *
+ ****************************************************************************/
+
+static void qsort_loop(FAR const struct qsort_s *c, FAR char *begin,
+                       FAR char *end, int badallowed, bool leftmost)
+{
+  size_t width = c->width;
 
-  pc = pd = (FAR char *)base + (nel - 1) * width;
   for (; ; )
     {
-      while (pb <= pc && (r = compar(pb, base)) <= 0)
+      size_t nel = (end - begin) / width;
+      FAR char *mid = QSORT_AT(c, begin, nel / 2);
+      FAR char *pivot;
+      bool partitioned;
+      size_t lnel;
+      size_t rnel;
+
+      if (nel < QSORT_INSERTION)
         {
-          if (r == 0)
-            {
-              swap_cnt = 1;
-              swap(pa, pb);
-              pa += width;
-            }
-
-          pb += width;
+          qsort_insertion(c, begin, end);
+          return;
         }
 
-      while (pb <= pc && (r = compar(pc, base)) >= 0)
-        {
-          if (r == 0)
-            {
-              swap_cnt = 1;
-              swap(pc, pd);
-              pd -= width;
-            }
+      /* Move the median of three, or the pseudomedian of nine, to begin */
 
-          pc -= width;
+      if (nel > QSORT_NINTHER)
+        {
+          size_t d = (nel / 8) * width;
+          FAR char *last = end - width;
+
+          qsort_sort3(c, begin, mid, last);
+          qsort_sort3(c, begin + d, mid - width, last - d);
+          qsort_sort3(c, begin + 2 * d, mid + width, last - 2 * d);
+          qsort_sort3(c, mid - width, mid, mid + width);
+          qsort_swap(c, begin, mid);
         }
-
-      if (pb > pc)
+      else
         {
-          break;
+          qsort_sort3(c, mid, begin, end - width);
         }
 
-      swap(pb, pc);
-      swap_cnt = 1;
-      pb      += width;
-      pc      -= width;
-    }
+      /* If the pivot is equal to the preceding element, which is not
+       * greater than any of the range, so are all the elements left of
+       * it:  only the right part is left to sort.  This makes the runs of
+       * equal elements linear.
+       */
 
-  if (swap_cnt == 0)
-    {
-      /* Switch to insertion sort */
+      if (!leftmost && !qsort_less(c, begin - width, begin))
+        {
+          begin = qsort_partition_left(c, begin, end) + width;
+          continue;
+        }
 
-      for (pm = (FAR char *)base + width;
-           pm < (FAR char *)base + nel * width;
-           pm += width)
+      pivot = qsort_partition_right(c, begin, end, &partitioned);
+      lnel  = (pivot - begin) / width;
+      rnel  = (end - pivot) / width - 1;
+
+      if (lnel < nel / 8 || rnel < nel / 8)
         {
-          for (pl = pm;
-               pl > (FAR char *)base && compar(pl - width, pl) > 0;
-               pl -= width)
+          /* Too many unbalanced partitions, the input may be adversarial */
+
+          if (--badallowed == 0)
             {
-              swap(pl, pl - width);
+              qsort_heap(c, begin, nel);
+              return;
+            }
+
+          /* Shuffle some elements to break the patterns */
+
+          if (lnel >= QSORT_INSERTION)
+            {
+              qsort_swap(c, begin, QSORT_AT(c, begin, lnel / 4));
+              qsort_swap(c, pivot - width,
+                         pivot - (lnel / 4) * width);
+
+              if (lnel > QSORT_NINTHER)
+                {
+                  qsort_swap(c, begin + width,
+                             QSORT_AT(c, begin, lnel / 4 + 1));
+                  qsort_swap(c, begin + 2 * width,
+                             QSORT_AT(c, begin, lnel / 4 + 2));
+                  qsort_swap(c, pivot - 2 * width,
+                             pivot - (lnel / 4 + 1) * width);
+                  qsort_swap(c, pivot - 3 * width,
+                             pivot - (lnel / 4 + 2) * width);
+                }
+            }
+
+          if (rnel >= QSORT_INSERTION)
+            {
+              qsort_swap(c, pivot + width,
+                         QSORT_AT(c, pivot, rnel / 4 + 1));
+              qsort_swap(c, end - width, end - (rnel / 4) * width);
+
+              if (rnel > QSORT_NINTHER)
+                {
+                  qsort_swap(c, pivot + 2 * width,
+                             QSORT_AT(c, pivot, rnel / 4 + 2));
+                  qsort_swap(c, pivot + 3 * width,
+                             QSORT_AT(c, pivot, rnel / 4 + 3));
+                  qsort_swap(c, end - 2 * width,
+                             end - (rnel / 4 + 1) * width);
+                  qsort_swap(c, end - 3 * width,
+                             end - (rnel / 4 + 2) * width);
+                }
             }
         }
+      else if (partitioned &&
+               qsort_partial_insertion(c, begin, pivot) &&
+               qsort_partial_insertion(c, pivot + width, end))
+        {
+          /* The input was (nearly) sorted already */
 
-      return;
-    }
+          return;
+        }
+
+      /* Recurse into the smaller part and iterate on the larger one, the
+       * stack depth stays logarithmic.
+       */
 
-  pn = (FAR char *)base + nel * width;
-  r  = MIN(pa - (FAR char *)base, pb - pa);
-  vecswap(base, pb - r, r);
+      if (lnel < rnel)
+        {
+          qsort_loop(c, begin, pivot, badallowed, leftmost);
+          begin    = pivot + width;
+          leftmost = false;
+        }
+      else
+        {
+          qsort_loop(c, pivot + width, end, badallowed, false);
+          end = pivot;
+        }
+    }
+}
 
-  r  = MIN(pd - pc, pn - pd - width);
-  vecswap(pb, pn - r, r);
+static void qsort_sort(FAR struct qsort_s *c, FAR void *base, size_t nel)
+{
+  uintptr_t align = (uintptr_t)base | c->width;
+  int badallowed = 0;
 
-  if ((r = pb - pa) > width)
+  if (nel < 2 || c->width == 0)
     {
-      qsort(base, r / width, width, compar);
+      return;
     }
 
-  if ((r = pd - pc) > width)
+  if (align % sizeof(uint32_t) != 0)
+    {
+      c->swaptype = QSORT_SWAP_BYTE;
+    }
+  else if (c->width == 4)
+    {
+      c->swaptype = QSORT_SWAP_4;
+    }
+  else if (align % sizeof(uint64_t) != 0)
+    {
+      c->swaptype = QSORT_SWAP_WORD;
+    }
+  else if (c->width == 8)
     {
-      /* Iterate rather than recurse to save stack space */
+      c->swaptype = QSORT_SWAP_8;
+    }
+  else if (c->width == 16)
+    {
+      c->swaptype = QSORT_SWAP_16;
+    }
+  else
+    {
+      c->swaptype = QSORT_SWAP_WORD;
+    }
 
-      base = pn - r;
-      nel = r / width;
-      goto loop;
+  while ((nel >> badallowed) > 1)
+    {
+      badallowed++;
     }
+
+  qsort_loop(c, base, QSORT_AT(c, (FAR char *)base, nel),
+             badallowed, true);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: qsort
+ *
+ * Description:
+ *   The qsort() function will sort an array of 'nel' objects, the initial
+ *   element of which is pointed to by 'base'. The size of each object, in
+ *   bytes, is specified by the 'width" argument. If the 'nel' argument has
+ *   the value zero, the comparison function pointed to by 'compar' will not
+ *   be called and no rearrangement will take place.
+ *
+ *   The application will ensure that the comparison function pointed to by
+ *   'compar' does not alter the contents of the array. The implementation
+ *   may reorder elements of the array between calls to the comparison
+ *   function, but will not alter the contents of any individual element.
+ *
+ *   When the same objects (consisting of 'width" bytes, irrespective of
+ *   their current positions in the array) are passed more than once to
+ *   the comparison function, the results will be consistent with one
+ *   another. That is, they will define a total ordering on the array.
+ *
+ *   The contents of the array will be sorted in ascending order according
+ *   to a comparison function. The 'compar' argument is a pointer to the
+ *   comparison function, which is called with two arguments that point to
+ *   the elements being compared. The application will ensure that the
+ *   function returns an integer less than, equal to, or greater than 0,
+ *   if the first argument is considered respectively less than, equal to,
+ *   or greater than the second. If two members compare as equal, their
+ *   order in the sorted array is unspecified.
+ *
+ *   (Based on description from OpenGroup.org).
+ *
+ * Returned Value:
+ *   The qsort() function will not return a value.
+ *
+ * Notes:
+ *   Pattern-defeating quicksort, after Orson Peters' pdqsort:  insertion
+ *   sort of the small partitions, linear time on sorted inputs and on
+ *   runs of equal elements, and a heapsort fallback bounding the worst
+ *   case to O(n log n).
+ *
+ ****************************************************************************/
+
+void qsort(FAR void *base, size_t nel, size_t width,
+           CODE int (*compar)(FAR const void *, FAR const void *))
+{
+  struct qsort_s c;
+
+  c.width    = width;
+  c.compar   = compar;
+  c.compar_r = NULL;
+  c.arg      = NULL;
+
+  qsort_sort(&c, base, nel);
+}
+
+/****************************************************************************
+ * Name: qsort_r
+ *
+ * Description:
+ *   The qsort_r() function is identical to qsort() except that the
+ *   comparison function takes a third argument, 'arg' which is passed
+ *   unchanged from the caller.
+ *
+ ****************************************************************************/
+
+void qsort_r(FAR void *base, size_t nel, size_t width,
+             CODE int (*compar)(FAR const void *, FAR const void *,
+                                FAR void *),
+             FAR void *arg)
+{
+  struct qsort_s c;
+
+  c.width    = width;
+  c.compar   = NULL;
+  c.compar_r = compar;
+  c.arg      = arg;
+
+  qsort_sort(&c, base, nel);
 }
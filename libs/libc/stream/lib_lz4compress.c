@@ -0,0 +1,181 @@
+/****************************************************************************
+ * libs/libc/stream/lib_lz4compress.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <unistd.h>
+#include <nuttx/streams.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lz4outstream_block
+ *
+ * Description:
+ *   Compress the pending data into a block, after the frame header if it
+ *   is the first block of the frame.
+ *
+ ****************************************************************************/
+
+static ssize_t lz4outstream_block(FAR struct lib_lz4outstream_s *stream)
+{
+  size_t outlen;
+  ssize_t ret;
+
+  if (!stream->inframe)
+    {
+      outlen = lz4_frame_header(stream->out, LZ4_STREAM_BLOCKSIZE);
+      ret = lib_stream_puts(stream->backend, stream->out, outlen);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      stream->inframe = true;
+    }
+
+  outlen = lz4_frame_block(stream->in, stream->offset, stream->out,
+                           stream->state);
+  stream->offset = 0;
+
+  return lib_stream_puts(stream->backend, stream->out, outlen);
+}
+
+/****************************************************************************
+ * Name: lz4outstream_flush
+ *
+ * Description:
+ *   Compress the pending data and end the frame:  all the data written so
+ *   far can be decompressed.
+ *
+ ****************************************************************************/
+
+static int lz4outstream_flush(FAR struct lib_outstream_s *self)
+{
+  FAR struct lib_lz4outstream_s *stream =
+                                 (FAR struct lib_lz4outstream_s *)self;
+  ssize_t ret;
+
+  if (stream->offset > 0)
+    {
+      ret = lz4outstream_block(stream);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  if (stream->inframe)
+    {
+      memset(stream->out, 0, LZ4_BLOCK_HDR_SIZE);
+      ret = lib_stream_puts(stream->backend, stream->out,
+                            LZ4_BLOCK_HDR_SIZE);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      stream->inframe = false;
+    }
+
+  return lib_stream_flush(stream->backend);
+}
+
+/****************************************************************************
+ * Name: lz4outstream_puts
+ ****************************************************************************/
+
+static ssize_t lz4outstream_puts(FAR struct lib_outstream_s *self,
+                                 FAR const void *buf, size_t len)
+{
+  FAR struct lib_lz4outstream_s *stream =
+                                 (FAR struct lib_lz4outstream_s *)self;
+  FAR const char *ptr = buf;
+  size_t total = len;
+  size_t copyin;
+  ssize_t ret;
+
+  while (total > 0)
+    {
+      copyin = stream->offset + total > LZ4_STREAM_BLOCKSIZE ?
+               LZ4_STREAM_BLOCKSIZE - stream->offset : total;
+
+      memcpy(stream->in + stream->offset, ptr, copyin);
+
+      ptr            += copyin;
+      stream->offset += copyin;
+      self->nput     += copyin;
+      total          -= copyin;
+
+      if (stream->offset == LZ4_STREAM_BLOCKSIZE)
+        {
+          ret = lz4outstream_block(stream);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_lz4outstream
+ *
+ * Description:
+ *  LZ4 compressed pipeline stream
+ *
+ * Input Parameters:
+ *   stream  - User allocated, uninitialized instance of struct
+ *                lib_lz4outstream_s to be initialized.
+ *   backend - Stream backend port.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+void lib_lz4outstream(FAR struct lib_lz4outstream_s *stream,
+                      FAR struct lib_outstream_s *backend)
+{
+  if (stream == NULL || backend == NULL)
+    {
+      return;
+    }
+
+  memset(stream, 0, sizeof(*stream));
+  stream->common.puts  = lz4outstream_puts;
+  stream->common.flush = lz4outstream_flush;
+  stream->backend      = backend;
+}
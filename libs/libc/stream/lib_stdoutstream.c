@@ -28,6 +28,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "libc.h"
 
@@ -48,12 +49,12 @@ static void stdoutstream_putc(FAR struct lib_outstream_s *self, int ch)
   DEBUGASSERT(self && stream->handle);
 
   /* Loop until the character is successfully transferred or an irrecoverable
-   * error occurs.
+   * error occurs.  The caller holds the lock of the stream.
    */
 
   do
     {
-      result = fputc(ch, stream->handle);
+      result = fputc_unlocked(ch, stream->handle);
       if (result != EOF)
         {
           self->nput++;
@@ -81,19 +82,32 @@ static ssize_t stdoutstream_puts(FAR struct lib_outstream_s *self,
   DEBUGASSERT(self && stream->handle);
 
   /* Loop until the buffer is successfully transferred or an irrecoverable
-   * error occurs.
+   * error occurs.  The caller holds the lock of the stream.
    */
 
   do
     {
-      result = fwrite(buffer, 1, len, stream->handle);
+      result = lib_fwrite_unlocked(buffer, len, stream->handle);
       if (result >= 0)
         {
           self->nput += result;
+
+#ifndef CONFIG_STDIO_DISABLE_BUFFERING
+          /* Flush the buffer if a newline was written to a line buffered
+           * stream, as fputc() does.
+           */
+
+          if ((stream->handle->fs_flags & __FS_FLAG_LBF) != 0 &&
+              memchr(buffer, '\n', result) != NULL)
+            {
+              lib_fflush_unlocked(stream->handle);
+            }
+#endif
+
           return result;
         }
 
-      result = _NX_GETERRVAL(result);
+      result = -get_errno();
 
       /* EINTR (meaning that fputc was interrupted by a signal) is the only
        * recoverable error.
@@ -62,6 +62,7 @@ static ssize_t syslogstream_puts(FAR struct lib_outstream_s *self,
     }
 
   syslog(stream->priority, "%.*s", (int)len, (FAR const char *)buff);
+  stream->common.nput += len;
   return len;
 }
 
@@ -0,0 +1,232 @@
+/****************************************************************************
+ * libs/libc/uring/lib_uring.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/io_uring.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: io_uring_queue_init
+ *
+ * Description:
+ *   Create a ring with at least 'entries' submission entries.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int io_uring_queue_init(unsigned int entries, FAR struct io_uring *ring,
+                        unsigned int flags)
+{
+  struct io_uring_params p;
+  int fd;
+
+  memset(&p, 0, sizeof(p));
+  p.flags = flags;
+
+  fd = io_uring_setup(entries, &p);
+  if (fd < 0)
+    {
+      return -get_errno();
+    }
+
+  ring->ring_fd  = fd;
+  ring->sqe_tail = p.sq->tail;
+  ring->sq       = p.sq;
+  ring->cq       = p.cq;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: io_uring_queue_exit
+ *
+ * Description:
+ *   Destroy a ring, the rings must not be accessed afterwards.
+ *
+ ****************************************************************************/
+
+void io_uring_queue_exit(FAR struct io_uring *ring)
+{
+  close(ring->ring_fd);
+  ring->ring_fd = -1;
+  ring->sq      = NULL;
+  ring->cq      = NULL;
+}
+
+/****************************************************************************
+ * Name: io_uring_get_sqe
+ *
+ * Description:
+ *   Return the next free submission entry, or NULL if the submission ring
+ *   is full.  The entry is handed to the kernel by io_uring_submit().
+ *
+ ****************************************************************************/
+
+FAR struct io_uring_sqe *io_uring_get_sqe(FAR struct io_uring *ring)
+{
+  FAR struct io_uring_sq *sq = ring->sq;
+
+  if (ring->sqe_tail - sq->head >= sq->ring_entries)
+    {
+      return NULL;
+    }
+
+  return &sq->sqes[ring->sqe_tail++ & sq->ring_mask];
+}
+
+/****************************************************************************
+ * Name: io_uring_submit_and_wait
+ *
+ * Description:
+ *   Publish the entries returned by io_uring_get_sqe() and submit them,
+ *   then wait for at least wait_nr completions.
+ *
+ * Returned Value:
+ *   The number of entries submitted, or a negated errno value.
+ *
+ ****************************************************************************/
+
+int io_uring_submit_and_wait(FAR struct io_uring *ring,
+                             unsigned int wait_nr)
+{
+  FAR struct io_uring_sq *sq = ring->sq;
+  unsigned int pending;
+  int ret;
+
+  /* The entries must be visible before the new tail */
+
+  UP_DMB();
+  sq->tail = ring->sqe_tail;
+  pending  = sq->tail - sq->head;
+
+  if (pending == 0 && wait_nr == 0)
+    {
+      return 0;
+    }
+
+  ret = io_uring_enter(ring->ring_fd, pending, wait_nr,
+                       wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0);
+  return ret < 0 ? -get_errno() : ret;
+}
+
+/****************************************************************************
+ * Name: io_uring_submit
+ *
+ * Description:
+ *   Publish and submit the entries returned by io_uring_get_sqe().
+ *
+ ****************************************************************************/
+
+int io_uring_submit(FAR struct io_uring *ring)
+{
+  return io_uring_submit_and_wait(ring, 0);
+}
+
+/****************************************************************************
+ * Name: io_uring_peek_cqe
+ *
+ * Description:
+ *   Return the oldest completion without any system call.
+ *
+ * Returned Value:
+ *   Zero if a completion is available, -EAGAIN otherwise.
+ *
+ ****************************************************************************/
+
+int io_uring_peek_cqe(FAR struct io_uring *ring,
+                      FAR struct io_uring_cqe **cqe_ptr)
+{
+  FAR struct io_uring_cq *cq = ring->cq;
+  uint32_t head = cq->head;
+
+  if (head == cq->tail)
+    {
+      *cqe_ptr = NULL;
+      return -EAGAIN;
+    }
+
+  /* Read the entry only after the tail that published it */
+
+  UP_DMB();
+  *cqe_ptr = &cq->cqes[head & cq->ring_mask];
+  return 0;
+}
+
+/****************************************************************************
+ * Name: io_uring_wait_cqe
+ *
+ * Description:
+ *   Return the oldest completion, waiting for one if none is available.
+ *   -EAGAIN is returned if nothing is in flight.
+ *
+ ****************************************************************************/
+
+int io_uring_wait_cqe(FAR struct io_uring *ring,
+                      FAR struct io_uring_cqe **cqe_ptr)
+{
+  int ret;
+
+  ret = io_uring_peek_cqe(ring, cqe_ptr);
+  if (ret == -EAGAIN)
+    {
+      ret = io_uring_submit_and_wait(ring, 1);
+      if (ret >= 0)
+        {
+          ret = io_uring_peek_cqe(ring, cqe_ptr);
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: io_uring_cqe_seen
+ *
+ * Description:
+ *   Release a completion returned by io_uring_peek/wait_cqe().
+ *
+ ****************************************************************************/
+
+void io_uring_cqe_seen(FAR struct io_uring *ring,
+                       FAR struct io_uring_cqe *cqe)
+{
+  FAR struct io_uring_cq *cq = ring->cq;
+
+  /* Done with the entry before it is given back to the kernel */
+
+  UP_DMB();
+  cq->head++;
+}
@@ -0,0 +1,558 @@
+/****************************************************************************
+ * libs/libdsp/lib_batch.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+#ifdef CONFIG_LIBDSP_BATCH_SIMD
+#  if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 2)
+#    include <arm_mve.h>
+#    define DSPV_MVE
+#  elif defined(__ARM_NEON)
+#    include <arm_neon.h>
+#    define DSPV_NEON
+#  elif defined(__SSE__)
+#    include <xmmintrin.h>
+#    define DSPV_SSE
+#  endif
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Four channels are processed at a time with the SIMD extension of the
+ * CPU, if any:  Helium (MVE with floating point), NEON or SSE.  The
+ * remaining channels, or all of them without SIMD, are processed one at a
+ * time.
+ *
+ *   DSPV_LOAD/STORE - unaligned load and store of four channels
+ *   DSPV_DUP        - the same value in the four channels
+ *   DSPV_GT         - comparison mask, a > b
+ *   DSPV_AND/OR     - AND and OR of two comparison masks
+ *   DSPV_SEL        - a where the mask is set, else b
+ */
+
+#if defined(DSPV_MVE)
+#  define DSPV_LEN            4
+#  define dspv_t              float32x4_t
+#  define dspv_mask_t         mve_pred16_t
+#  define DSPV_LOAD(p)        vld1q_f32(p)
+#  define DSPV_STORE(p, v)    vst1q_f32(p, v)
+#  define DSPV_DUP(x)         vdupq_n_f32(x)
+#  define DSPV_ADD(a, b)      vaddq_f32(a, b)
+#  define DSPV_SUB(a, b)      vsubq_f32(a, b)
+#  define DSPV_MUL(a, b)      vmulq_f32(a, b)
+#  define DSPV_MIN(a, b)      vminnmq_f32(a, b)
+#  define DSPV_MAX(a, b)      vmaxnmq_f32(a, b)
+#  define DSPV_GT(a, b)       vcmpgtq_f32(a, b)
+#  define DSPV_AND(m, n)      ((m) & (n))
+#  define DSPV_OR(m, n)       ((m) | (n))
+#  define DSPV_SEL(m, a, b)   vpselq_f32(a, b, m)
+#elif defined(DSPV_NEON)
+#  define DSPV_LEN            4
+#  define dspv_t              float32x4_t
+#  define dspv_mask_t         uint32x4_t
+#  define DSPV_LOAD(p)        vld1q_f32(p)
+#  define DSPV_STORE(p, v)    vst1q_f32(p, v)
+#  define DSPV_DUP(x)         vdupq_n_f32(x)
+#  define DSPV_ADD(a, b)      vaddq_f32(a, b)
+#  define DSPV_SUB(a, b)      vsubq_f32(a, b)
+#  define DSPV_MUL(a, b)      vmulq_f32(a, b)
+#  define DSPV_MIN(a, b)      vminq_f32(a, b)
+#  define DSPV_MAX(a, b)      vmaxq_f32(a, b)
+#  define DSPV_GT(a, b)       vcgtq_f32(a, b)
+#  define DSPV_AND(m, n)      vandq_u32(m, n)
+#  define DSPV_OR(m, n)       vorrq_u32(m, n)
+#  define DSPV_SEL(m, a, b)   vbslq_f32(m, a, b)
+#elif defined(DSPV_SSE)
+#  define DSPV_LEN            4
+#  define dspv_t              __m128
+#  define dspv_mask_t         __m128
+#  define DSPV_LOAD(p)        _mm_loadu_ps(p)
+#  define DSPV_STORE(p, v)    _mm_storeu_ps(p, v)
+#  define DSPV_DUP(x)         _mm_set1_ps(x)
+#  define DSPV_ADD(a, b)      _mm_add_ps(a, b)
+#  define DSPV_SUB(a, b)      _mm_sub_ps(a, b)
+#  define DSPV_MUL(a, b)      _mm_mul_ps(a, b)
+#  define DSPV_MIN(a, b)      _mm_min_ps(a, b)
+#  define DSPV_MAX(a, b)      _mm_max_ps(a, b)
+#  define DSPV_GT(a, b)       _mm_cmpgt_ps(a, b)
+#  define DSPV_AND(m, n)      _mm_and_ps(m, n)
+#  define DSPV_OR(m, n)       _mm_or_ps(m, n)
+#  define DSPV_SEL(m, a, b)   _mm_or_ps(_mm_and_ps(m, a), \
+                                        _mm_andnot_ps(m, b))
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clarke_transform_batch
+ *
+ * Description:
+ *   Clarke transform (abc frame -> ab frame) of n channels, see
+ *   clarke_transform().  The C components are not used and may be NULL.
+ *   The output may overwrite the input.
+ *
+ * Input Parameters:
+ *   abc - (in) pointer to the abc frames
+ *   ab  - (out) pointer to the alpha-beta frames
+ *   n   - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void clarke_transform_batch(FAR const struct abc_batch_f32_s *abc,
+                            FAR struct ab_batch_f32_s *ab, size_t n)
+{
+  FAR const float *ia;
+  FAR const float *ib;
+  FAR float *oa;
+  FAR float *ob;
+  size_t i = 0;
+
+  LIBDSP_DEBUGASSERT(abc != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+  ia = abc->a;
+  ib = abc->b;
+  oa = ab->a;
+  ob = ab->b;
+
+#ifdef DSPV_LEN
+  for (; i + DSPV_LEN <= n; i += DSPV_LEN)
+    {
+      dspv_t a = DSPV_LOAD(&ia[i]);
+      dspv_t b = DSPV_LOAD(&ib[i]);
+
+      DSPV_STORE(&oa[i], a);
+      DSPV_STORE(&ob[i], DSPV_ADD(DSPV_MUL(a, DSPV_DUP(ONE_BY_SQRT3_F)),
+                                  DSPV_MUL(b, DSPV_DUP(TWO_BY_SQRT3_F))));
+    }
+#endif
+
+  for (; i < n; i++)
+    {
+      float a = ia[i];
+      float b = ib[i];
+
+      oa[i] = a;
+      ob[i] = ONE_BY_SQRT3_F*a + TWO_BY_SQRT3_F*b;
+    }
+}
+
+/****************************************************************************
+ * Name: inv_clarke_transform_batch
+ *
+ * Description:
+ *   Inverse Clarke transform (ab frame -> abc frame) of n channels, see
+ *   inv_clarke_transform().  The output may overwrite the input.
+ *
+ * Input Parameters:
+ *   ab  - (in) pointer to the alpha-beta frames
+ *   abc - (out) pointer to the abc frames
+ *   n   - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_clarke_transform_batch(FAR const struct ab_batch_f32_s *ab,
+                                FAR struct abc_batch_f32_s *abc, size_t n)
+{
+  FAR const float *ia;
+  FAR const float *ib;
+  FAR float *oa;
+  FAR float *ob;
+  FAR float *oc;
+  size_t i = 0;
+
+  LIBDSP_DEBUGASSERT(ab != NULL);
+  LIBDSP_DEBUGASSERT(abc != NULL);
+
+  ia = ab->a;
+  ib = ab->b;
+  oa = abc->a;
+  ob = abc->b;
+  oc = abc->c;
+
+#ifdef DSPV_LEN
+  for (; i + DSPV_LEN <= n; i += DSPV_LEN)
+    {
+      dspv_t a = DSPV_LOAD(&ia[i]);
+      dspv_t b = DSPV_LOAD(&ib[i]);
+      dspv_t vb = DSPV_ADD(DSPV_MUL(a, DSPV_DUP(-0.5f)),
+                           DSPV_MUL(b, DSPV_DUP(SQRT3_BY_TWO_F)));
+
+      DSPV_STORE(&oa[i], a);
+      DSPV_STORE(&ob[i], vb);
+      DSPV_STORE(&oc[i], DSPV_SUB(DSPV_SUB(DSPV_DUP(0.0f), a), vb));
+    }
+#endif
+
+  for (; i < n; i++)
+    {
+      float a = ia[i];
+      float b = -0.5f*a + SQRT3_BY_TWO_F*ib[i];
+
+      oa[i] = a;
+      ob[i] = b;
+      oc[i] = -a - b;
+    }
+}
+
+/****************************************************************************
+ * Name: park_transform_batch
+ *
+ * Description:
+ *   Park transform (ab frame -> dq frame) of n channels, see
+ *   park_transform().  The output may overwrite the input.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angles
+ *   ab    - (in) pointer to the alpha-beta frames
+ *   dq    - (out) pointer to the direct-quadrature frames
+ *   n     - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void park_transform_batch(FAR const struct phase_angle_batch_f32_s *angle,
+                          FAR const struct ab_batch_f32_s *ab,
+                          FAR struct dq_batch_f32_s *dq, size_t n)
+{
+  FAR const float *sn;
+  FAR const float *cs;
+  FAR const float *ia;
+  FAR const float *ib;
+  FAR float *od;
+  FAR float *oq;
+  size_t i = 0;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+
+  sn = angle->sin;
+  cs = angle->cos;
+  ia = ab->a;
+  ib = ab->b;
+  od = dq->d;
+  oq = dq->q;
+
+#ifdef DSPV_LEN
+  for (; i + DSPV_LEN <= n; i += DSPV_LEN)
+    {
+      dspv_t s = DSPV_LOAD(&sn[i]);
+      dspv_t c = DSPV_LOAD(&cs[i]);
+      dspv_t a = DSPV_LOAD(&ia[i]);
+      dspv_t b = DSPV_LOAD(&ib[i]);
+
+      DSPV_STORE(&od[i], DSPV_ADD(DSPV_MUL(c, a), DSPV_MUL(s, b)));
+      DSPV_STORE(&oq[i], DSPV_SUB(DSPV_MUL(c, b), DSPV_MUL(s, a)));
+    }
+#endif
+
+  for (; i < n; i++)
+    {
+      float s = sn[i];
+      float c = cs[i];
+      float a = ia[i];
+      float b = ib[i];
+
+      od[i] = c * a + s * b;
+      oq[i] = c * b - s * a;
+    }
+}
+
+/****************************************************************************
+ * Name: inv_park_transform_batch
+ *
+ * Description:
+ *   Inverse Park transform (dq frame -> ab frame) of n channels, see
+ *   inv_park_transform().  The output may overwrite the input.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angles
+ *   dq    - (in) pointer to the direct-quadrature frames
+ *   ab    - (out) pointer to the alpha-beta frames
+ *   n     - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_park_transform_batch(
+  FAR const struct phase_angle_batch_f32_s *angle,
+  FAR const struct dq_batch_f32_s *dq, FAR struct ab_batch_f32_s *ab,
+  size_t n)
+{
+  FAR const float *sn;
+  FAR const float *cs;
+  FAR const float *id;
+  FAR const float *iq;
+  FAR float *oa;
+  FAR float *ob;
+  size_t i = 0;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+  sn = angle->sin;
+  cs = angle->cos;
+  id = dq->d;
+  iq = dq->q;
+  oa = ab->a;
+  ob = ab->b;
+
+#ifdef DSPV_LEN
+  for (; i + DSPV_LEN <= n; i += DSPV_LEN)
+    {
+      dspv_t s = DSPV_LOAD(&sn[i]);
+      dspv_t c = DSPV_LOAD(&cs[i]);
+      dspv_t d = DSPV_LOAD(&id[i]);
+      dspv_t q = DSPV_LOAD(&iq[i]);
+
+      DSPV_STORE(&oa[i], DSPV_SUB(DSPV_MUL(c, d), DSPV_MUL(s, q)));
+      DSPV_STORE(&ob[i], DSPV_ADD(DSPV_MUL(c, q), DSPV_MUL(s, d)));
+    }
+#endif
+
+  for (; i < n; i++)
+    {
+      float s = sn[i];
+      float c = cs[i];
+      float d = id[i];
+      float q = iq[i];
+
+      oa[i] = c * d - s * q;
+      ob[i] = c * q + s * d;
+    }
+}
+
+/****************************************************************************
+ * Name: svm3_batch
+ *
+ * Description:
+ *   Space vector modulation of n channels, giving the same duty cycles as
+ *   svm3() without finding the sector:  the phase voltages are centered
+ *   between the bus rails by subtracting the mean of their maximum and
+ *   their minimum (min-max injection), which is what the alternate-reverse
+ *   null vector of svm3() does.
+ *
+ *     d_x = 0.5 + (v_x - (max(v) + min(v)) / 2) / sqrt(3)
+ *
+ *   where v is the inverse Clarke transform of v_ab.  The output is not
+ *   saturated, as for svm3().  In svm3_current_correct() terms, the phase
+ *   not to be sampled is the one with the largest duty cycle.
+ *
+ * Input Parameters:
+ *   v_ab - (in) pointer to the modulation voltage vectors in alpha-beta
+ *          frame, normalized to magnitude (0.0 - 1.0)
+ *   duty - (out) pointer to the duty cycles for phases U (a), V (b) and
+ *          W (c)
+ *   n    - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void svm3_batch(FAR const struct ab_batch_f32_s *v_ab,
+                FAR struct abc_batch_f32_s *duty, size_t n)
+{
+  FAR const float *ia;
+  FAR const float *ib;
+  FAR float *du;
+  FAR float *dv;
+  FAR float *dw;
+  size_t i = 0;
+
+  LIBDSP_DEBUGASSERT(v_ab != NULL);
+  LIBDSP_DEBUGASSERT(duty != NULL);
+
+  ia = v_ab->a;
+  ib = v_ab->b;
+  du = duty->a;
+  dv = duty->b;
+  dw = duty->c;
+
+  /* The phase voltages are computed already divided by sqrt(3) */
+
+#ifdef DSPV_LEN
+  for (; i + DSPV_LEN <= n; i += DSPV_LEN)
+    {
+      dspv_t a = DSPV_MUL(DSPV_LOAD(&ia[i]), DSPV_DUP(ONE_BY_SQRT3_F));
+      dspv_t b = DSPV_MUL(DSPV_LOAD(&ib[i]), DSPV_DUP(0.5f));
+      dspv_t h = DSPV_MUL(a, DSPV_DUP(-0.5f));
+      dspv_t u = a;
+      dspv_t v = DSPV_ADD(h, b);
+      dspv_t w = DSPV_SUB(h, b);
+      dspv_t mid = DSPV_MUL(DSPV_ADD(DSPV_MAX(DSPV_MAX(u, v), w),
+                                     DSPV_MIN(DSPV_MIN(u, v), w)),
+                            DSPV_DUP(0.5f));
+
+      mid = DSPV_SUB(DSPV_DUP(0.5f), mid);
+      DSPV_STORE(&du[i], DSPV_ADD(u, mid));
+      DSPV_STORE(&dv[i], DSPV_ADD(v, mid));
+      DSPV_STORE(&dw[i], DSPV_ADD(w, mid));
+    }
+#endif
+
+  for (; i < n; i++)
+    {
+      float a = ia[i] * ONE_BY_SQRT3_F;
+      float b = ib[i] * 0.5f;
+      float u = a;
+      float v = -0.5f * a + b;
+      float w = -0.5f * a - b;
+      float max = u > v ? u : v;
+      float min = u < v ? u : v;
+      float mid;
+
+      max = max > w ? max : w;
+      min = min < w ? min : w;
+      mid = 0.5f - (max + min) * 0.5f;
+
+      du[i] = u + mid;
+      dv[i] = v + mid;
+      dw[i] = w + mid;
+    }
+}
+
+/****************************************************************************
+ * Name: pi_controller_batch
+ *
+ * Description:
+ *   PI controllers of n channels, see pi_controller() with saturation and
+ *   anti-windup enabled.
+ *
+ * Input Parameters:
+ *   pi  - (in/out) pointer to the PI controllers data
+ *   err - (in) current controller errors
+ *   out - (out) controller outputs, may overwrite the errors
+ *   n   - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pi_controller_batch(FAR struct pi_batch_f32_s *pi,
+                         FAR const float *err, FAR float *out, size_t n)
+{
+  FAR const float *kp;
+  FAR const float *ki;
+  FAR const float *kc;
+  FAR const float *mn;
+  FAR const float *mx;
+  FAR float *part;
+  FAR float *aw;
+  bool ireset;
+  size_t i = 0;
+
+  LIBDSP_DEBUGASSERT(pi != NULL);
+  LIBDSP_DEBUGASSERT(err != NULL);
+  LIBDSP_DEBUGASSERT(out != NULL);
+
+  kp     = pi->KP;
+  ki     = pi->KI;
+  kc     = pi->KC;
+  mn     = pi->min;
+  mx     = pi->max;
+  part   = pi->part;
+  aw     = pi->aw;
+  ireset = pi->ireset_en;
+
+#ifdef DSPV_LEN
+  for (; i + DSPV_LEN <= n; i += DSPV_LEN)
+    {
+      dspv_t e = DSPV_LOAD(&err[i]);
+      dspv_t lo = DSPV_LOAD(&mn[i]);
+      dspv_t hi = DSPV_LOAD(&mx[i]);
+      dspv_t p = DSPV_ADD(DSPV_LOAD(&part[i]),
+                          DSPV_MUL(DSPV_LOAD(&ki[i]),
+                                   DSPV_SUB(e, DSPV_LOAD(&aw[i]))));
+      dspv_t tmp = DSPV_ADD(DSPV_MUL(DSPV_LOAD(&kp[i]), e), p);
+      dspv_t o = DSPV_MIN(DSPV_MAX(tmp, lo), hi);
+
+      if (ireset)
+        {
+          /* Reset the integral part if saturated the error's way */
+
+          dspv_t zero = DSPV_DUP(0.0f);
+          dspv_mask_t reset =
+            DSPV_OR(DSPV_AND(DSPV_GT(tmp, hi), DSPV_GT(e, zero)),
+                    DSPV_AND(DSPV_GT(lo, tmp), DSPV_GT(zero, e)));
+
+          p = DSPV_SEL(reset, zero, p);
+        }
+
+      DSPV_STORE(&part[i], p);
+      DSPV_STORE(&aw[i], DSPV_MUL(DSPV_LOAD(&kc[i]), DSPV_SUB(tmp, o)));
+      DSPV_STORE(&out[i], o);
+    }
+#endif
+
+  for (; i < n; i++)
+    {
+      float e = err[i];
+      float p = part[i] + ki[i] * (e - aw[i]);
+      float tmp = kp[i] * e + p;
+      float o = tmp;
+
+      if (tmp > mx[i])
+        {
+          if (ireset && e > 0.0f)
+            {
+              p = 0.0f;
+            }
+
+          o = mx[i];
+        }
+      else if (tmp < mn[i])
+        {
+          if (ireset && e < 0.0f)
+            {
+              p = 0.0f;
+            }
+
+          o = mn[i];
+        }
+
+      part[i] = p;
+      aw[i]   = kc[i] * (tmp - o);
+      out[i]  = o;
+    }
+}
@@ -0,0 +1,373 @@
+/****************************************************************************
+ * libs/libdsp/lib_batch_b16.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dspb16.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/* The b16 twins of lib_batch.c.  A fixed-point multiplication needs a
+ * 64-bit product, the channels are processed one at a time.
+ */
+
+/****************************************************************************
+ * Name: clarke_transform_batch_b16
+ *
+ * Description:
+ *   Clarke transform (abc frame -> ab frame) of n channels, see
+ *   clarke_transform_b16().  The C components are not used and may be
+ *   NULL.  The output may overwrite the input.
+ *
+ * Input Parameters:
+ *   abc - (in) pointer to the abc frames
+ *   ab  - (out) pointer to the alpha-beta frames
+ *   n   - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void clarke_transform_batch_b16(FAR const struct abc_batch_b16_s *abc,
+                                FAR struct ab_batch_b16_s *ab, size_t n)
+{
+  FAR const b16_t *ia;
+  FAR const b16_t *ib;
+  FAR b16_t *oa;
+  FAR b16_t *ob;
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(abc != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+  ia = abc->a;
+  ib = abc->b;
+  oa = ab->a;
+  ob = ab->b;
+
+  for (i = 0; i < n; i++)
+    {
+      b16_t a = ia[i];
+      b16_t b = ib[i];
+
+      oa[i] = a;
+      ob[i] = (b16mulb16(ONE_BY_SQRT3_B16, a) +
+               b16mulb16(TWO_BY_SQRT3_B16, b));
+    }
+}
+
+/****************************************************************************
+ * Name: inv_clarke_transform_batch_b16
+ *
+ * Description:
+ *   Inverse Clarke transform (ab frame -> abc frame) of n channels, see
+ *   inv_clarke_transform_b16().  The output may overwrite the input.
+ *
+ * Input Parameters:
+ *   ab  - (in) pointer to the alpha-beta frames
+ *   abc - (out) pointer to the abc frames
+ *   n   - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_clarke_transform_batch_b16(FAR const struct ab_batch_b16_s *ab,
+                                    FAR struct abc_batch_b16_s *abc,
+                                    size_t n)
+{
+  FAR const b16_t *ia;
+  FAR const b16_t *ib;
+  FAR b16_t *oa;
+  FAR b16_t *ob;
+  FAR b16_t *oc;
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(ab != NULL);
+  LIBDSP_DEBUGASSERT(abc != NULL);
+
+  ia = ab->a;
+  ib = ab->b;
+  oa = abc->a;
+  ob = abc->b;
+  oc = abc->c;
+
+  for (i = 0; i < n; i++)
+    {
+      b16_t a = ia[i];
+      b16_t b = (b16mulb16(-b16HALF, a) +
+                 b16mulb16(SQRT3_BY_TWO_B16, ib[i]));
+
+      oa[i] = a;
+      ob[i] = b;
+      oc[i] = -a - b;
+    }
+}
+
+/****************************************************************************
+ * Name: park_transform_batch_b16
+ *
+ * Description:
+ *   Park transform (ab frame -> dq frame) of n channels, see
+ *   park_transform_b16().  The output may overwrite the input.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angles
+ *   ab    - (in) pointer to the alpha-beta frames
+ *   dq    - (out) pointer to the direct-quadrature frames
+ *   n     - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void park_transform_batch_b16(
+  FAR const struct phase_angle_batch_b16_s *angle,
+  FAR const struct ab_batch_b16_s *ab, FAR struct dq_batch_b16_s *dq,
+  size_t n)
+{
+  FAR const b16_t *sn;
+  FAR const b16_t *cs;
+  FAR const b16_t *ia;
+  FAR const b16_t *ib;
+  FAR b16_t *od;
+  FAR b16_t *oq;
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+
+  sn = angle->sin;
+  cs = angle->cos;
+  ia = ab->a;
+  ib = ab->b;
+  od = dq->d;
+  oq = dq->q;
+
+  for (i = 0; i < n; i++)
+    {
+      b16_t s = sn[i];
+      b16_t c = cs[i];
+      b16_t a = ia[i];
+      b16_t b = ib[i];
+
+      od[i] = b16mulb16(c, a) + b16mulb16(s, b);
+      oq[i] = b16mulb16(c, b) - b16mulb16(s, a);
+    }
+}
+
+/****************************************************************************
+ * Name: inv_park_transform_batch_b16
+ *
+ * Description:
+ *   Inverse Park transform (dq frame -> ab frame) of n channels, see
+ *   inv_park_transform_b16().  The output may overwrite the input.
+ *
+ * Input Parameters:
+ *   angle - (in) pointer to the phase angles
+ *   dq    - (in) pointer to the direct-quadrature frames
+ *   ab    - (out) pointer to the alpha-beta frames
+ *   n     - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inv_park_transform_batch_b16(
+  FAR const struct phase_angle_batch_b16_s *angle,
+  FAR const struct dq_batch_b16_s *dq, FAR struct ab_batch_b16_s *ab,
+  size_t n)
+{
+  FAR const b16_t *sn;
+  FAR const b16_t *cs;
+  FAR const b16_t *id;
+  FAR const b16_t *iq;
+  FAR b16_t *oa;
+  FAR b16_t *ob;
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(angle != NULL);
+  LIBDSP_DEBUGASSERT(dq != NULL);
+  LIBDSP_DEBUGASSERT(ab != NULL);
+
+  sn = angle->sin;
+  cs = angle->cos;
+  id = dq->d;
+  iq = dq->q;
+  oa = ab->a;
+  ob = ab->b;
+
+  for (i = 0; i < n; i++)
+    {
+      b16_t s = sn[i];
+      b16_t c = cs[i];
+      b16_t d = id[i];
+      b16_t q = iq[i];
+
+      oa[i] = b16mulb16(c, d) - b16mulb16(s, q);
+      ob[i] = b16mulb16(c, q) + b16mulb16(s, d);
+    }
+}
+
+/****************************************************************************
+ * Name: svm3_batch_b16
+ *
+ * Description:
+ *   Space vector modulation of n channels, see svm3_batch().
+ *
+ * Input Parameters:
+ *   v_ab - (in) pointer to the modulation voltage vectors in alpha-beta
+ *          frame, normalized to magnitude (0.0 - 1.0)
+ *   duty - (out) pointer to the duty cycles for phases U (a), V (b) and
+ *          W (c)
+ *   n    - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void svm3_batch_b16(FAR const struct ab_batch_b16_s *v_ab,
+                    FAR struct abc_batch_b16_s *duty, size_t n)
+{
+  FAR const b16_t *ia;
+  FAR const b16_t *ib;
+  FAR b16_t *du;
+  FAR b16_t *dv;
+  FAR b16_t *dw;
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(v_ab != NULL);
+  LIBDSP_DEBUGASSERT(duty != NULL);
+
+  ia = v_ab->a;
+  ib = v_ab->b;
+  du = duty->a;
+  dv = duty->b;
+  dw = duty->c;
+
+  /* The phase voltages are computed already divided by sqrt(3) */
+
+  for (i = 0; i < n; i++)
+    {
+      b16_t u = b16mulb16(ia[i], ONE_BY_SQRT3_B16);
+      b16_t b = ib[i] / 2;
+      b16_t v = -u / 2 + b;
+      b16_t w = -u / 2 - b;
+      b16_t max = u > v ? u : v;
+      b16_t min = u < v ? u : v;
+      b16_t mid;
+
+      max = max > w ? max : w;
+      min = min < w ? min : w;
+      mid = b16HALF - (max + min) / 2;
+
+      du[i] = u + mid;
+      dv[i] = v + mid;
+      dw[i] = w + mid;
+    }
+}
+
+/****************************************************************************
+ * Name: pi_controller_batch_b16
+ *
+ * Description:
+ *   PI controllers of n channels, see pi_controller_b16() with saturation
+ *   and anti-windup enabled.
+ *
+ * Input Parameters:
+ *   pi  - (in/out) pointer to the PI controllers data
+ *   err - (in) current controller errors
+ *   out - (out) controller outputs, may overwrite the errors
+ *   n   - (in) number of channels
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pi_controller_batch_b16(FAR struct pi_batch_b16_s *pi,
+                             FAR const b16_t *err, FAR b16_t *out, size_t n)
+{
+  FAR const b16_t *kp;
+  FAR const b16_t *ki;
+  FAR const b16_t *kc;
+  FAR const b16_t *mn;
+  FAR const b16_t *mx;
+  FAR b16_t *part;
+  FAR b16_t *aw;
+  bool ireset;
+  size_t i;
+
+  LIBDSP_DEBUGASSERT(pi != NULL);
+  LIBDSP_DEBUGASSERT(err != NULL);
+  LIBDSP_DEBUGASSERT(out != NULL);
+
+  kp     = pi->KP;
+  ki     = pi->KI;
+  kc     = pi->KC;
+  mn     = pi->min;
+  mx     = pi->max;
+  part   = pi->part;
+  aw     = pi->aw;
+  ireset = pi->ireset_en;
+
+  for (i = 0; i < n; i++)
+    {
+      b16_t e = err[i];
+      b16_t p = part[i] + b16mulb16(ki[i], e - aw[i]);
+      b16_t tmp = b16mulb16(kp[i], e) + p;
+      b16_t o = tmp;
+
+      if (tmp > mx[i])
+        {
+          if (ireset && e > 0)
+            {
+              p = 0;
+            }
+
+          o = mx[i];
+        }
+      else if (tmp < mn[i])
+        {
+          if (ireset && e < 0)
+            {
+              p = 0;
+            }
+
+          o = mn[i];
+        }
+
+      part[i] = p;
+      aw[i]   = b16mulb16(kc[i], tmp - o);
+      out[i]  = o;
+    }
+}
@@ -380,6 +380,7 @@ FAR struct iob_s *iob_alloc_dynamic(uint16_t size)
       iob->io_free    = iob_free_dynamic; /* Customer free callback */
       iob->io_data    = (FAR uint8_t *)ROUNDUP((uintptr_t)(iob + 1),
                                                CONFIG_IOB_ALIGNMENT);
+      iob->io_freearg = iob->io_data;
     }
 
   return iob;
@@ -424,6 +425,7 @@ FAR struct iob_s *iob_alloc_with_data(FAR void *data, uint16_t size,
       iob->io_bufsize = size;    /* Total length of the iob buffer */
       iob->io_pktlen  = 0;       /* Total length of the packet */
       iob->io_free    = free_cb; /* Customer free callback */
+      iob->io_freearg = data;    /* Argument of the free callback */
       iob->io_data    = data;
     }
 
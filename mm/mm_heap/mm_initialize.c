@@ -270,6 +270,7 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
    */
 
   nxmutex_init(&heap->mm_lock);
+  nxmutex_set_adaptive(&heap->mm_lock, true);
 
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
 #  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
@@ -992,6 +992,7 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
    */
 
   nxmutex_init(&heap->mm_lock);
+  nxmutex_set_adaptive(&heap->mm_lock, true);
 
   /* Add the initial region of memory to the heap */
 
@@ -123,6 +123,10 @@
  *                        retransmissions. (TCP only)
  *                   OUT: Not used
  *
+ *   NET_ERRQUEUE     IN: A MSG_ZEROCOPY completion was queued on the error
+ *                        queue of the socket.  (TCP and UDP only)
+ *                   OUT: Not used
+ *
  * Device Specific Events:  These are events that may be notified through
  * callback lists residing in the network device structure.
  *
@@ -193,7 +197,9 @@
 #define TCP_TIMEDOUT       (1 << 9)
 #define TCP_WAITALL        (1 << 10)
 
-/* Bits 10-11: Unused, available */
+/* Bit 11: Socket error queue event */
+
+#define NET_ERRQUEUE       (1 << 11)
 
 /* Bit 12: Device specific event bits */
 
@@ -1212,7 +1212,7 @@ static int inet_listen(FAR struct socket *psock, int backlog)
 
           conn->lport = tcp_selectport(PF_INET,
                                 (FAR const union ip_addr_u *)
-                                &conn->u.ipv4.laddr, 0);
+                                &conn->u.ipv4.laddr, 0, 0);
         }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -1227,7 +1227,7 @@ static int inet_listen(FAR struct socket *psock, int backlog)
 
           conn->lport = tcp_selectport(PF_INET6,
                                 (FAR const union ip_addr_u *)
-                                conn->u.ipv6.laddr, 0);
+                                conn->u.ipv6.laddr, 0, 0);
         }
 #endif /* CONFIG_NET_IPv6 */
     }
@@ -1543,7 +1543,7 @@ static int inet_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
    * by the caller).
    */
 
-  ret = psock_tcp_accept(psock, addr, addrlen, &newsock->s_conn);
+  ret = psock_tcp_accept(psock, addr, addrlen, &newsock->s_conn, flags);
   if (ret < 0)
     {
       nerr("ERROR: psock_tcp_accept failed: %d\n", ret);
@@ -170,7 +170,8 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
 
       /* Was the socket opened non-blocking? */
 
-      if (_SS_ISNONBLOCK(server->lc_conn.s_flags))
+      if (_SS_ISNONBLOCK(server->lc_conn.s_flags) ||
+          (flags & SOCK_ACCEPT_DONTWAIT) != 0)
         {
           /* Yes.. return EAGAIN */
 
@@ -47,6 +47,7 @@
 #include "netlink/netlink.h"
 #include "route/route.h"
 #include "usrsock/usrsock.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Public Functions
@@ -143,11 +144,23 @@ void net_initialize(void)
   udp_initialize();
 #endif
 
+#ifdef CONFIG_NET_UDP_REUSEPORT_SELFTEST
+  /* Check the SO_REUSEPORT datagram distribution once the OS is up */
+
+  udp_reuseport_selftest();
+#endif
+
 #ifdef CONFIG_NET_USRSOCK
   /* Initialize the user-space socket API */
 
   usrsock_initialize();
 #endif
+
+#ifdef CONFIG_NET_SEND_ZEROCOPY_SELFTEST
+  /* Check the reporting of the MSG_ZEROCOPY completions */
+
+  net_zc_selftest();
+#endif
 }
 
 #endif /* CONFIG_NET */
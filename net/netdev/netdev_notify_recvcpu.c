@@ -26,6 +26,7 @@
 
 #include <assert.h>
 #include <debug.h>
+#include <string.h>
 
 #include "netdev/netdev.h"
 
@@ -390,6 +391,58 @@ static uint32_t compute_hash(hashcal_algo_e hash_algo,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: netdev_rss_hash
+ *
+ * Description:
+ *   Calculate the hash of a flow, the same one as that provided to the
+ *   driver with SIOCNOTIFYRECVCPU.
+ *
+ * Input Parameters:
+ *   domain   - The layer 3 protocol, PF_INET/PF_INET6
+ *   src_addr - The local address
+ *   src_port - The local port
+ *   dst_addr - The remote address
+ *   dst_port - The remote port
+ *
+ * Returned Value:
+ *  The hash value
+ *
+ ****************************************************************************/
+
+uint32_t netdev_rss_hash(uint8_t domain,
+                         FAR const void *src_addr, uint16_t src_port,
+                         FAR const void *dst_addr, uint16_t dst_port)
+{
+  return compute_hash(HASHCAL_ALGO_CRC32, HASHCAL_TYPE_4TUPLE, domain,
+                      src_addr, src_port, dst_addr, dst_port);
+}
+
+/****************************************************************************
+ * Name: netdev_rss_porthash
+ *
+ * Description:
+ *   Calculate the hash of all the flows to a local port, the one provided
+ *   to the driver with SIOCNOTIFYRECVCPU for the sockets that are not bound
+ *   to both a local and a remote address.
+ *
+ * Input Parameters:
+ *   domain   - The layer 3 protocol, PF_INET/PF_INET6
+ *   src_port - The local port
+ *
+ * Returned Value:
+ *  The hash value
+ *
+ ****************************************************************************/
+
+uint32_t netdev_rss_porthash(uint8_t domain, uint16_t src_port)
+{
+  static const uint32_t unspec[4];
+
+  return compute_hash(HASHCAL_ALGO_CRC32, HASHCAL_TYPE_4TUPLE, domain,
+                      unspec, src_port, unspec, 0);
+}
+
 /****************************************************************************
  * Name: netdev_notify_recvcpu
  *
@@ -417,16 +470,28 @@ void netdev_notify_recvcpu(FAR struct net_driver_s *dev,
 {
   if (dev != NULL && dev->d_ioctl != NULL)
     {
-      uint32_t hash = compute_hash(HASHCAL_ALGO_CRC32,
-                                   HASHCAL_TYPE_4TUPLE,
-                                   domain,
-                                   src_addr, src_port,
-                                   dst_addr, dst_port);
+      static const uint32_t unspec[4];
+      size_t addrlen = domain == PF_INET ? sizeof(in_addr_t) :
+                                           sizeof(net_ipv6addr_t);
       struct netdev_rss_s arg;
       int ret;
 
+      /* A socket bound to INADDR_ANY/in6addr_any, or not connected,
+       * receives the flows of any address to its port:  steer them all.
+       */
+
+      if (memcmp(src_addr, unspec, addrlen) == 0 ||
+          memcmp(dst_addr, unspec, addrlen) == 0)
+        {
+          arg.hash = netdev_rss_porthash(domain, src_port);
+        }
+      else
+        {
+          arg.hash = netdev_rss_hash(domain, src_addr, src_port,
+                                     dst_addr, dst_port);
+        }
+
       arg.cpu = cpu;
-      arg.hash = hash;
 
       ret = dev->d_ioctl(dev, SIOCNOTIFYRECVCPU,
                          (unsigned long)(uintptr_t)&arg);
@@ -56,6 +56,27 @@
 #  define NETSTAT_IPv6_IDX 1
 #endif
 
+/* The per-CPU lines of the receive packet steering follow all the other
+ * lines, so their index is the total number of those.
+ */
+
+#if defined(CONFIG_NETDEV_STATISTICS) && defined(CONFIG_NETDEV_RPS) && \
+    defined(CONFIG_DESIGNATED_INITIALIZERS)
+#  define NETSTAT_RPS_LINES 1
+#  ifdef CONFIG_NET_IPv6
+#    ifdef CONFIG_NETDEV_MULTIPLE_IPv6
+#      define NETSTAT_IPv6_LINES (CONFIG_NETDEV_MAX_IPv6_ADDR + 1)
+#    else
+#      define NETSTAT_IPv6_LINES 2
+#    endif
+#  elif !defined(CONFIG_NET_IPv4)
+#    define NETSTAT_IPv6_LINES 1 /* The blank line */
+#  else
+#    define NETSTAT_IPv6_LINES 0
+#  endif
+#  define NETSTAT_RPS_IDX (NETSTAT_IPv6_IDX + NETSTAT_IPv6_LINES + 8)
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -82,6 +103,11 @@ static int netprocfs_txstatistics_header(
 static int netprocfs_txstatistics(FAR struct netprocfs_file_s *netfile);
 static int netprocfs_errors(FAR struct netprocfs_file_s *netfile);
 #endif /* CONFIG_NETDEV_STATISTICS */
+#ifdef NETSTAT_RPS_LINES
+static int netprocfs_rpsstatistics_header(
+    FAR struct netprocfs_file_s *netfile);
+static int netprocfs_rpsstatistics(FAR struct netprocfs_file_s *netfile);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -118,6 +144,12 @@ static const linegen_t g_netstat_linegen[] =
   netprocfs_txstatistics,
   netprocfs_errors
 #endif /* CONFIG_NETDEV_STATISTICS */
+
+#ifdef NETSTAT_RPS_LINES
+  , netprocfs_rpsstatistics_header
+  , [NETSTAT_RPS_IDX ... NETSTAT_RPS_IDX + CONFIG_SMP_NCPUS - 1]
+  = netprocfs_rpsstatistics
+#endif
 };
 
 #define NSTAT_LINES (sizeof(g_netstat_linegen) / sizeof(linegen_t))
@@ -578,6 +610,44 @@ static int netprocfs_errors(FAR struct netprocfs_file_s *netfile)
 }
 #endif /* CONFIG_NETDEV_STATISTICS */
 
+/****************************************************************************
+ * Name: netprocfs_rpsstatistics_header
+ ****************************************************************************/
+
+#ifdef NETSTAT_RPS_LINES
+static int netprocfs_rpsstatistics_header(
+    FAR struct netprocfs_file_s *netfile)
+{
+  DEBUGASSERT(netfile != NULL);
+
+  return snprintf(netfile->line, NET_LINELEN,
+                  "\tRPS: %-4s %-8s %-8s %-8s %-8s\n",
+                  "CPU", "Queued", "Input", "Dropped", "Flow");
+}
+#endif /* NETSTAT_RPS_LINES */
+
+/****************************************************************************
+ * Name: netprocfs_rpsstatistics
+ ****************************************************************************/
+
+#ifdef NETSTAT_RPS_LINES
+static int netprocfs_rpsstatistics(FAR struct netprocfs_file_s *netfile)
+{
+  FAR struct netdev_statistics_s *stats;
+  int cpu = netfile->lineno - NETSTAT_RPS_IDX;
+
+  DEBUGASSERT(netfile != NULL && netfile->dev != NULL);
+  stats = &netfile->dev->d_statistics;
+
+  return snprintf(netfile->line, NET_LINELEN,
+                  "\t     %-4d %08lx %08lx %08lx %08lx\n", cpu,
+                  (unsigned long)stats->rps_queued[cpu],
+                  (unsigned long)stats->rps_processed[cpu],
+                  (unsigned long)stats->rps_dropped[cpu],
+                  (unsigned long)stats->rps_flow[cpu]);
+}
+#endif /* NETSTAT_RPS_LINES */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -863,7 +863,8 @@ static int rpmsg_socket_accept(FAR struct socket *psock,
         }
       else
         {
-          if (_SS_ISNONBLOCK(server->sconn.s_flags))
+          if (_SS_ISNONBLOCK(server->sconn.s_flags) ||
+              (flags & SOCK_ACCEPT_DONTWAIT) != 0)
             {
               ret = -EAGAIN;
               break;
@@ -72,7 +72,8 @@
  *   not marked as non-blocking, psock_accept blocks the caller until a
  *   connection is present. If the socket is marked non-blocking and no
  *   pending connections are present on the queue, psock_accept returns
- *   EAGAIN.
+ *   EAGAIN.  So does it with SOCK_ACCEPT_DONTWAIT in flags, for the
+ *   kernel users that must not block on a shared listening socket.
  *
  * Input Parameters:
  *   psock    Reference to the listening socket structure
@@ -154,8 +154,14 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
                            * periodic transmission of probes */
       case SO_OOBINLINE:  /* Leaves received out-of-band data inline */
       case SO_REUSEADDR:  /* Allow reuse of local addresses */
+#ifdef CONFIG_NET_REUSEPORT
+      case SO_REUSEPORT:  /* Allow load-balanced reuse of local ports */
+#endif
 #ifdef CONFIG_NET_TIMESTAMP
       case SO_TIMESTAMP:  /* Generates a timestamp for each incoming packet */
+#endif
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+      case SO_ZEROCOPY:   /* Allow MSG_ZEROCOPY sends */
 #endif
         {
           sockopt_t optionset;
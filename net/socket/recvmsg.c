@@ -34,6 +34,7 @@
 #include <nuttx/net/net.h>
 
 #include "socket/socket.h"
+#include "utils/utils.h"
 
 #ifdef CONFIG_NET
 
@@ -112,7 +113,18 @@ ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
   msg_control         = msg->msg_control;
   msg_controllen      = msg->msg_controllen;
 
-  ret = psock->s_sockif->si_recvmsg(psock, msg, flags);
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+  /* The error queue only holds the MSG_ZEROCOPY completions */
+
+  if ((flags & MSG_ERRQUEUE) != 0)
+    {
+      ret = net_zc_recverr(psock, msg);
+    }
+  else
+#endif
+    {
+      ret = psock->s_sockif->si_recvmsg(psock, msg, flags);
+    }
 
   /* Recover the pointer and calculate the cmsg's true data length */
 
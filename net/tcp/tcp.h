@@ -114,6 +114,41 @@
 
 #endif
 
+#define TCP_TSTAMP            0x20U /* Timestamps option enabled */
+
+/* Space taken by the Timestamps option in every segment once negotiated:
+ * two NOPs for alignment followed by the 10 byte option (RFC 7323,
+ * Appendix A).
+ */
+
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+#  define TCP_OPT_TS_ALIGNED_LEN  12
+#  define TCP_TSOPT_SIZE(conn) \
+     (((conn)->flags & TCP_TSTAMP) != 0 ? TCP_OPT_TS_ALIGNED_LEN : 0)
+#else
+#  define TCP_TSOPT_SIZE(conn)    0
+#endif
+
+/* Increments a size inc and holds at max value rather than rollover. */
+
+#define CC_CWND_INC(wnd, inc) \
+ do { \
+  if ((uint32_t)((wnd) + (inc)) >= (wnd)) \
+    { \
+      (wnd) = (uint32_t)((wnd) + (inc)); \
+    } \
+  else \
+    { \
+      (wnd) = (uint32_t)-1; \
+    } \
+ } while(0)
+
+/* Millisecond clock used by the congestion control algorithms and as the
+ * TSval clock of the Timestamps option.
+ */
+
+#define TCP_CLOCK_MS()          ((uint32_t)TICK2MSEC(clock_systime_ticks()))
+
 /* The Max Range count of TCP Selective ACKs */
 
 #define TCP_SACK_RANGES_MAX   4
@@ -176,6 +211,75 @@ struct tcp_sack_s
   uint32_t right;   /* Right edge of the SACK */
 };
 
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+/* Congestion control algorithm operations.
+ *
+ * The common logic in tcp_cc.c detects duplicate ACKs and drives fast
+ * retransmit and fast recovery (RFC 6582).  An algorithm only decides how
+ * the congestion window grows and how far it is reduced after a loss.
+ */
+
+struct tcp_cc_ops_s
+{
+  FAR const char *name;
+
+  /* Initialize the private state of a new connection.  cwnd and ssthresh
+   * already hold the RFC 5681 initial values (optional).
+   */
+
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+
+  /* 'acked' bytes of new data were acknowledged outside of fast recovery */
+
+  CODE void (*cong_avoid)(FAR struct tcp_conn_s *conn, uint32_t acked);
+
+  /* Return the new ssthresh after a loss was detected */
+
+  CODE uint32_t (*ssthresh)(FAR struct tcp_conn_s *conn);
+
+  /* A new RTT sample in milliseconds is available (optional) */
+
+  CODE void (*rtt_sample)(FAR struct tcp_conn_s *conn, uint32_t rtt);
+};
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+/* CUBIC private state (RFC 8312) */
+
+struct tcp_cubic_s
+{
+  uint32_t w_max;         /* cwnd before the last reduction (bytes) */
+  uint32_t w_last_max;    /* w_max before the last reduction (bytes) */
+  uint32_t w_est;         /* Reno friendly window estimate (bytes) */
+  uint32_t epoch_start;   /* Start of the current epoch (msec), 0: none */
+  uint32_t k;             /* Time to reach w_max again (msec) */
+};
+#endif
+
+#ifdef CONFIG_NET_TCP_CC_BBR
+/* BBR private state.  The bottleneck bandwidth is the maximum delivery
+ * rate seen over the last TCP_BBR_BW_RTTS rounds.
+ */
+
+#define TCP_BBR_BW_RTTS 10
+
+struct tcp_bbr_s
+{
+  uint8_t  mode;          /* STARTUP, DRAIN, PROBE_BW or PROBE_RTT */
+  uint8_t  cycle_idx;     /* Index in the PROBE_BW pacing gain cycle */
+  uint8_t  full_bw_cnt;   /* Rounds without significant bw growth */
+  uint8_t  bw_idx;        /* Slot of the max bandwidth filter */
+  uint32_t bw[TCP_BBR_BW_RTTS]; /* Delivery rate per round (bytes/sec) */
+  uint32_t full_bw;       /* Bandwidth at the last growth check */
+  uint32_t min_rtt;       /* Minimum RTT seen (msec), 0: no sample */
+  uint32_t min_rtt_stamp; /* When min_rtt was measured (msec) */
+  uint32_t delivered;     /* Total bytes delivered */
+  uint32_t rnd_delivered; /* 'delivered' at the start of the round */
+  uint32_t rnd_stamp;     /* Start of the current round (msec) */
+  uint32_t probe_rtt_done; /* End of the PROBE_RTT phase (msec) */
+};
+#endif
+#endif /* CONFIG_NET_TCP_CC_NEWRENO */
+
 struct tcp_conn_s
 {
   /* Common prologue of all connection structures. */
@@ -252,6 +356,28 @@ struct tcp_conn_s
   uint32_t cwnd;          /* The Congestion window */
   uint32_t max_cwnd;      /* The Congestion window maximum value */
   uint32_t ssthresh;      /* The Slow start threshold */
+
+  /* Congestion control algorithm and its private state */
+
+  FAR const struct tcp_cc_ops_s *cc_ops;
+  union
+  {
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+    struct tcp_cubic_s cubic;
+#endif
+#ifdef CONFIG_NET_TCP_CC_BBR
+    struct tcp_bbr_s   bbr;
+#endif
+    uint32_t           dummy;
+  } cc;
+#endif
+#ifdef CONFIG_NET_TCP_CC_PACING
+  uint32_t pacing_rate;   /* Pacing rate in bytes per second, 0: none */
+  uint32_t pacing_next;   /* Time when the next segment is due (usec) */
+  struct   work_s pacework; /* Resumes transmission when pacing allows */
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+  uint32_t ts_recent;     /* Most recent TSval received, to be echoed */
 #endif
 #ifdef CONFIG_NET_TCP_WINDOW_SCALE
   uint32_t snd_wnd;       /* Sequence and acknowledgement numbers of last
@@ -639,7 +765,8 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
  * Description:
  *   If the port number is zero; select an unused port for the connection.
  *   If the port number is non-zero, verify that no other connection has
- *   been created with this port number.
+ *   been created with this port number, except those sharing it with
+ *   SO_REUSEPORT in opt.
  *
  * Returned Value:
  *   Selected or verified port number in network order on success, a negated
@@ -652,7 +779,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
 
 int tcp_selectport(uint8_t domain,
                    FAR const union ip_addr_u *ipaddr,
-                   uint16_t portno);
+                   uint16_t portno, sockopt_t opt);
 
 /****************************************************************************
  * Name: tcp_bind
@@ -1050,7 +1177,10 @@ void tcp_stop_timer(FAR struct tcp_conn_s *conn);
  * Name: tcp_findlistener
  *
  * Description:
- *   Return the connection listener for connections on this port (if any)
+ *   Return the connection listener for connections on this port (if any).
+ *   If several listeners share the port through SO_REUSEPORT, one of them
+ *   is selected by a hash of the remote address (uaddr) and remote port
+ *   (rport).
  *
  * Assumptions:
  *   The network is locked
@@ -1059,11 +1189,11 @@ void tcp_stop_timer(FAR struct tcp_conn_s *conn);
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
 FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
-                                        uint16_t portno,
+                                        uint16_t portno, uint16_t rport,
                                         uint8_t domain);
 #else
 FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
-                                        uint16_t portno);
+                                        uint16_t portno, uint16_t rport);
 #endif
 
 /****************************************************************************
@@ -1543,6 +1673,7 @@ int tcp_backlogdelete(FAR struct tcp_conn_s *conn,
  *   addrlen  Input: allocated size of 'addr'
  *            Return: returned size of 'addr'
  *   newconn  The new, accepted TCP connection structure
+ *   flags    SOCK_ACCEPT_DONTWAIT not to wait for a connection
  *
  * Returned Value:
  *   Returns zero (OK) on success or a negated errno value on failure.
@@ -1555,7 +1686,7 @@ int tcp_backlogdelete(FAR struct tcp_conn_s *conn,
  ****************************************************************************/
 
 int psock_tcp_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
-                     FAR socklen_t *addrlen, FAR void **newconn);
+                     FAR socklen_t *addrlen, FAR void **newconn, int flags);
 
 /****************************************************************************
  * Name: psock_tcp_recvfrom
@@ -2308,6 +2439,134 @@ void tcp_cc_update(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp);
  ****************************************************************************/
 
 void tcp_cc_recv_ack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp);
+
+/****************************************************************************
+ * Name: tcp_cc_rto
+ *
+ * Description:
+ *   Update the congestion control variables after a retransmission
+ *   time-out (RFC 5681, Section 3.1).
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_rto(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_cc_rtt_sample
+ *
+ * Description:
+ *   Pass a new round-trip time sample to the congestion control algorithm.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   rtt    - The measured round-trip time in milliseconds
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_rtt_sample(FAR struct tcp_conn_s *conn, uint32_t rtt);
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name.  The
+ *   selection takes effect immediately; a connection that is already
+ *   established restarts from the initial window of the new algorithm.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   name   - The name of the algorithm ("newreno", "cubic", "bbr")
+ *
+ * Returned Value:
+ *   OK on success, -ENOENT if the algorithm is not available.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name);
+
+/****************************************************************************
+ * Name: tcp_cc_name
+ *
+ * Description:
+ *   Return the name of the congestion control algorithm of a connection.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   The name of the algorithm used by the connection.
+ *
+ ****************************************************************************/
+
+FAR const char *tcp_cc_name(FAR struct tcp_conn_s *conn);
+
+/* Algorithm operations provided by tcp_cc_cubic.c and tcp_cc_bbr.c */
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+extern const struct tcp_cc_ops_s g_tcp_cc_cubic;
+#endif
+
+#ifdef CONFIG_NET_TCP_CC_BBR
+extern const struct tcp_cc_ops_s g_tcp_cc_bbr;
+#endif
+#endif /* CONFIG_NET_TCP_CC_NEWRENO */
+
+/****************************************************************************
+ * Name: tcp_pacing_check
+ *
+ * Description:
+ *   Check whether the pacing rate allows another segment to be sent now.
+ *   If it does not, the transmission is resumed later by a delayed work.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   true if a segment may be sent now.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC_PACING
+bool tcp_pacing_check(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_pacing_sent
+ *
+ * Description:
+ *   Account a segment of 'len' bytes that was just sent against the pacing
+ *   rate of the connection.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   len    - The number of payload bytes sent
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_pacing_sent(FAR struct tcp_conn_s *conn, uint32_t len);
 #endif
 
 #ifdef __cplusplus
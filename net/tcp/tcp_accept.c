@@ -201,6 +201,7 @@ static int accept_eventhandler(FAR struct tcp_conn_s *listener,
  *   addrlen  Input: allocated size of 'addr', Return: returned size of
  *            'addr'
  *   newconn  The new, accepted TCP connection structure
+ *   flags    SOCK_ACCEPT_DONTWAIT not to wait for a connection
  *
  * Returned Value:
  *   Returns zero (OK) on success or a negated errno value on failure.
@@ -213,7 +214,7 @@ static int accept_eventhandler(FAR struct tcp_conn_s *listener,
  ****************************************************************************/
 
 int psock_tcp_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
-                     FAR socklen_t *addrlen, FAR void **newconn)
+                     FAR socklen_t *addrlen, FAR void **newconn, int flags)
 {
   FAR struct tcp_conn_s *conn;
   struct accept_s state;
@@ -241,7 +242,8 @@ int psock_tcp_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
    * return EAGAIN if there is no pending connection in the backlog.
    */
 
-  else if (_SS_ISNONBLOCK(conn->sconn.s_flags))
+  else if (_SS_ISNONBLOCK(conn->sconn.s_flags) ||
+           (flags & SOCK_ACCEPT_DONTWAIT) != 0)
     {
       return -EAGAIN;
     }
@@ -24,8 +24,13 @@
  * Included Files
  ****************************************************************************/
 
+#include <string.h>
+#include <errno.h>
 #include <debug.h>
 
+#include <netinet/tcp.h>
+
+#include "netdev/netdev.h"
 #include "tcp/tcp.h"
 
 /****************************************************************************
@@ -60,24 +65,144 @@
     } \
  } while(0)
 
-/* Increments a size inc and holds at max value rather than rollover. */
+/* The algorithm used by connections that did not select one explicitly */
 
-#define CC_CWND_INC(wnd, inc) \
- do { \
-  if ((uint32_t)((wnd) + (inc)) >= (wnd)) \
-    { \
-      (wnd) = (uint32_t)((wnd) + (inc)); \
-    } \
-  else \
-    { \
-      (wnd) = (uint32_t)-1; \
-    } \
- } while(0)
+#if defined(CONFIG_NET_TCP_CC_DEFAULT_BBR)
+#  define TCP_CC_DEFAULT (&g_tcp_cc_bbr)
+#elif defined(CONFIG_NET_TCP_CC_DEFAULT_CUBIC)
+#  define TCP_CC_DEFAULT (&g_tcp_cc_cubic)
+#else
+#  define TCP_CC_DEFAULT (&g_tcp_cc_newreno)
+#endif
+
+#define TCP_CC_OPS(conn) \
+  ((conn)->cc_ops != NULL ? (conn)->cc_ops : TCP_CC_DEFAULT)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   uint32_t acked);
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct tcp_cc_ops_s g_tcp_cc_newreno =
+{
+  "newreno",                /* name */
+  NULL,                     /* init */
+  tcp_newreno_cong_avoid,   /* cong_avoid */
+  tcp_newreno_ssthresh,     /* ssthresh */
+  NULL                      /* rtt_sample */
+};
+
+/* All available algorithms, looked up by name by tcp_cc_select() */
+
+static FAR const struct tcp_cc_ops_s *const g_tcp_cc_algs[] =
+{
+  &g_tcp_cc_newreno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  &g_tcp_cc_cubic,
+#endif
+#ifdef CONFIG_NET_TCP_CC_BBR
+  &g_tcp_cc_bbr,
+#endif
+};
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_newreno_cong_avoid
+ *
+ * Description:
+ *   Grow the congestion window by slow start or congestion avoidance.
+ *
+ ****************************************************************************/
+
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   uint32_t acked)
+{
+  uint32_t increase;
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      /* slow start (RFC 5681):
+       * Grow cwnd exponentially by maxseg(smss) per ACK.
+       */
+
+      increase = acked > 0 ? MIN(acked, conn->mss) : conn->mss;
+
+      CC_CWND_INC(conn->cwnd, increase);
+      ninfo("update slow start cwnd to %u\n", conn->cwnd);
+    }
+  else
+    {
+      /* cong avoid (RFC 5681):
+       * Grow cwnd linearly by approximately maxseg per RTT using
+       * maxseg^2 / cwnd per ACK as the increment.
+       * If cwnd > maxseg^2, fix the cwnd increment at 1 byte to
+       * avoid capping cwnd.
+       */
+
+      increase = MAX((conn->mss * conn->mss / conn->cwnd), 1);
+
+      CC_CWND_INC(conn->cwnd, increase);
+      conn->cwnd = MIN(conn->cwnd, conn->max_cwnd);
+      ninfo("update congestion avoidance cwnd to %u\n", conn->cwnd);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_newreno_ssthresh
+ *
+ * Description:
+ *   ssthresh = max (FlightSize / 2, 2*SMSS) referring to rfc5681
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  return MAX(conn->tx_unacked / 2, 2 * conn->mss);
+}
+
+#ifdef CONFIG_NET_TCP_CC_PACING
+/****************************************************************************
+ * Name: tcp_pacing_worker
+ *
+ * Description:
+ *   The pacing delay of a connection expired, poll it again if it is still
+ *   active:  it may have been freed since the work was queued.
+ *
+ ****************************************************************************/
+
+static void tcp_pacing_worker(FAR void *arg)
+{
+  FAR struct tcp_conn_s *conn = NULL;
+
+  net_lock();
+
+  while ((conn = tcp_nextconn(conn)) != NULL)
+    {
+      if (conn == arg)
+        {
+          if (conn->pacing_rate != 0 && conn->dev != NULL)
+            {
+              netdev_txnotify_dev(conn->dev);
+            }
+
+          break;
+        }
+    }
+
+  net_unlock();
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -103,6 +228,8 @@
 
 void tcp_cc_init(FAR struct tcp_conn_s *conn)
 {
+  FAR const struct tcp_cc_ops_s *ops = TCP_CC_OPS(conn);
+
   CC_INIT_CWND(conn->cwnd, conn->mss);
 
   /* RFC 5681 recommends setting ssthresh arbitrarily high and
@@ -117,6 +244,16 @@ void tcp_cc_init(FAR struct tcp_conn_s *conn)
 
   conn->ssthresh = 2 * TCP_IPV4_DEFAULT_MSS;
   conn->dupacks = 0;
+
+  memset(&conn->cc, 0, sizeof(conn->cc));
+  if (ops->init != NULL)
+    {
+      ops->init(conn);
+    }
+
+#ifdef CONFIG_NET_TCP_CC_PACING
+  conn->pacing_next = 0;
+#endif
 }
 
 /****************************************************************************
@@ -140,15 +277,16 @@ void tcp_cc_init(FAR struct tcp_conn_s *conn)
 
 void tcp_cc_update(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
 {
-  /* After Fast retransmitted, set ssthresh to the maximum of
-   * the unacked and the 2*SMSS, and enter to Fast Recovery.
-   * ssthresh = max (FlightSize / 2, 2*SMSS) referring to rfc5681
+  FAR const struct tcp_cc_ops_s *ops = TCP_CC_OPS(conn);
+
+  /* After Fast retransmitted, let the algorithm reduce ssthresh and
+   * enter to Fast Recovery.
    * cwnd=ssthresh + 3*SMSS  referring to rfc5681
    */
 
   if (conn->flags & TCP_INFT)
     {
-      conn->ssthresh = MAX(conn->tx_unacked / 2, 2 * conn->mss);
+      conn->ssthresh = ops->ssthresh(conn);
       conn->cwnd = conn->ssthresh + 3 * conn->mss;
 
       conn->flags &= ~TCP_INFT;
@@ -156,7 +294,8 @@ void tcp_cc_update(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
     }
 
   /* Update the cc parameters in the TCP_SYN_RCVD and TCP_SYN_SENT states
-   * when the tcp connection is established.
+   * when the tcp connection is established.  The MSS is final now, so the
+   * algorithm starts over from its initial window.
    */
 
   else
@@ -165,6 +304,12 @@ void tcp_cc_update(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
       CC_INIT_CWND(conn->cwnd, conn->mss);
       conn->max_cwnd = conn->snd_wnd;
       conn->ssthresh = MAX(conn->snd_wnd, conn->ssthresh);
+
+      memset(&conn->cc, 0, sizeof(conn->cc));
+      if (ops->init != NULL)
+        {
+          ops->init(conn);
+        }
     }
 }
 
@@ -265,38 +410,226 @@ void tcp_cc_recv_ack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
             }
         }
 
-      /* Update the congestion control variables (cwnd and ssthresh). */
+      /* Let the algorithm update the congestion window. */
 
       if (conn->tcpstateflags >= TCP_ESTABLISHED)
         {
-          uint32_t increase;
+          TCP_CC_OPS(conn)->cong_avoid(conn, acked);
+        }
+    }
+}
 
-          if (conn->cwnd < conn->ssthresh)
-            {
-              /* slow start (RFC 5681):
-               * Grow cwnd exponentially by maxseg(smss) per ACK.
-               */
+/****************************************************************************
+ * Name: tcp_cc_rto
+ *
+ * Description:
+ *   Update the congestion control variables after a retransmission
+ *   time-out (RFC 5681, Section 3.1).
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
 
-              increase = acked > 0 ? MIN(acked, conn->mss) : conn->mss;
+void tcp_cc_rto(FAR struct tcp_conn_s *conn)
+{
+  /* If conn is TCP_INFR, it should enter to slow start */
 
-              CC_CWND_INC(conn->cwnd, increase);
-              ninfo("update slow start cwnd to %u\n", conn->cwnd);
-            }
-          else
-            {
-              /* cong avoid (RFC 5681):
-               * Grow cwnd linearly by approximately maxseg per RTT using
-               * maxseg^2 / cwnd per ACK as the increment.
-               * If cwnd > maxseg^2, fix the cwnd increment at 1 byte to
-               * avoid capping cwnd.
-               */
+  conn->flags &= ~TCP_INFR;
+
+  /* update the max_cwnd */
+
+  conn->max_cwnd = (conn->max_cwnd + 7 * conn->cwnd) >> 3;
+
+  /* reset cwnd and ssthresh, refers to RFC5861. */
+
+  conn->ssthresh = TCP_CC_OPS(conn)->ssthresh(conn);
+  conn->cwnd = conn->mss;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_rtt_sample
+ *
+ * Description:
+ *   Pass a new round-trip time sample to the congestion control algorithm.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   rtt    - The measured round-trip time in milliseconds
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_rtt_sample(FAR struct tcp_conn_s *conn, uint32_t rtt)
+{
+  FAR const struct tcp_cc_ops_s *ops = TCP_CC_OPS(conn);
+
+  if (ops->rtt_sample != NULL)
+    {
+      ops->rtt_sample(conn, rtt);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name.  The
+ *   selection takes effect immediately; a connection that is already
+ *   established keeps its cwnd and ssthresh, only the state of the
+ *   algorithm is initialized.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   name   - The name of the algorithm ("newreno", "cubic", "bbr")
+ *
+ * Returned Value:
+ *   OK on success, -ENOENT if the algorithm is not available.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name)
+{
+  int i;
 
-              increase = MAX((conn->mss * conn->mss / conn->cwnd), 1);
+  for (i = 0; i < nitems(g_tcp_cc_algs); i++)
+    {
+      if (strncmp(g_tcp_cc_algs[i]->name, name, TCP_CA_NAME_MAX) == 0)
+        {
+          FAR const struct tcp_cc_ops_s *old = TCP_CC_OPS(conn);
 
-              CC_CWND_INC(conn->cwnd, increase);
-              conn->cwnd = MIN(conn->cwnd, conn->max_cwnd);
-              ninfo("update congestion avoidance cwnd to %u\n", conn->cwnd);
+          conn->cc_ops = g_tcp_cc_algs[i];
+          if (old != conn->cc_ops)
+            {
+#ifdef CONFIG_NET_TCP_CC_PACING
+              conn->pacing_rate = 0;
+              conn->pacing_next = 0;
+#endif
+              memset(&conn->cc, 0, sizeof(conn->cc));
+              if (conn->cc_ops->init != NULL)
+                {
+                  conn->cc_ops->init(conn);
+                }
             }
+
+          return OK;
         }
     }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_name
+ *
+ * Description:
+ *   Return the name of the congestion control algorithm of a connection.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   The name of the algorithm used by the connection.
+ *
+ ****************************************************************************/
+
+FAR const char *tcp_cc_name(FAR struct tcp_conn_s *conn)
+{
+  return TCP_CC_OPS(conn)->name;
+}
+
+#ifdef CONFIG_NET_TCP_CC_PACING
+/****************************************************************************
+ * Name: tcp_pacing_check
+ *
+ * Description:
+ *   Check whether the pacing rate allows another segment to be sent now.
+ *   If it does not, the transmission is resumed later by a delayed work.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   true if a segment may be sent now.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool tcp_pacing_check(FAR struct tcp_conn_s *conn)
+{
+  int32_t delay;
+
+  if (conn->pacing_rate == 0)
+    {
+      return true;
+    }
+
+  delay = (int32_t)(conn->pacing_next -
+                    (uint32_t)TICK2USEC(clock_systime_ticks()));
+  if (delay <= 0)
+    {
+      return true;
+    }
+
+  if (work_available(&conn->pacework))
+    {
+      work_queue(LPWORK, &conn->pacework, tcp_pacing_worker, conn,
+                 MAX(USEC2TICK(delay), 1));
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_pacing_sent
+ *
+ * Description:
+ *   Account a segment of 'len' bytes that was just sent against the pacing
+ *   rate of the connection.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   len    - The number of payload bytes sent
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_pacing_sent(FAR struct tcp_conn_s *conn, uint32_t len)
+{
+  uint32_t now;
+
+  if (conn->pacing_rate == 0)
+    {
+      return;
+    }
+
+  /* Do not let an idle period build up credit for a burst */
+
+  now = (uint32_t)TICK2USEC(clock_systime_ticks());
+  if ((int32_t)(conn->pacing_next - now) < 0)
+    {
+      conn->pacing_next = now;
+    }
+
+  conn->pacing_next += (uint32_t)((uint64_t)len * USEC_PER_SEC /
+                                  conn->pacing_rate);
 }
+#endif /* CONFIG_NET_TCP_CC_PACING */
@@ -0,0 +1,384 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_bbr.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <debug.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* BBR modes */
+
+#define BBR_STARTUP         0  /* Ramp up to fill the pipe */
+#define BBR_DRAIN           1  /* Drain the queue created in STARTUP */
+#define BBR_PROBE_BW        2  /* Cruise at the bottleneck bandwidth */
+#define BBR_PROBE_RTT       3  /* Drain the queue to refresh min_rtt */
+
+/* Gains are scaled by 256 */
+
+#define BBR_UNIT            256
+#define BBR_HIGH_GAIN       739   /* 2/ln(2) */
+#define BBR_DRAIN_GAIN      88    /* 1/BBR_HIGH_GAIN */
+#define BBR_CWND_GAIN       512
+
+/* STARTUP ends once the bandwidth did not grow by 25% in 3 rounds */
+
+#define BBR_FULL_BW_THRESH  320
+#define BBR_FULL_BW_CNT     3
+
+/* min_rtt is refreshed by a 200 msec PROBE_RTT every 10 seconds */
+
+#define BBR_MIN_RTT_WIN     10000
+#define BBR_PROBE_RTT_TIME  200
+
+#define BBR_CYCLE_LEN       8
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void bbr_init(FAR struct tcp_conn_s *conn);
+static void bbr_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked);
+static uint32_t bbr_ssthresh(FAR struct tcp_conn_s *conn);
+static void bbr_rtt_sample(FAR struct tcp_conn_s *conn, uint32_t rtt);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* PROBE_BW pacing gains: probe for more bandwidth for one round, drain
+ * the queue this may have built in the next one, then cruise.
+ */
+
+static const uint16_t g_bbr_cycle_gain[BBR_CYCLE_LEN] =
+{
+  BBR_UNIT * 5 / 4, BBR_UNIT * 3 / 4, BBR_UNIT, BBR_UNIT,
+  BBR_UNIT, BBR_UNIT, BBR_UNIT, BBR_UNIT
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_bbr =
+{
+  "bbr",                    /* name */
+  bbr_init,                 /* init */
+  bbr_cong_avoid,           /* cong_avoid */
+  bbr_ssthresh,             /* ssthresh */
+  bbr_rtt_sample            /* rtt_sample */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bbr_max_bw
+ *
+ * Description:
+ *   Return the bottleneck bandwidth estimate, the maximum delivery rate of
+ *   the last TCP_BBR_BW_RTTS rounds.
+ *
+ ****************************************************************************/
+
+static uint32_t bbr_max_bw(FAR struct tcp_bbr_s *bbr)
+{
+  uint32_t bw = 0;
+  int i;
+
+  for (i = 0; i < TCP_BBR_BW_RTTS; i++)
+    {
+      bw = MAX(bw, bbr->bw[i]);
+    }
+
+  return bw;
+}
+
+/****************************************************************************
+ * Name: bbr_bdp
+ *
+ * Description:
+ *   Return the estimated bandwidth-delay product in bytes scaled by 'gain'.
+ *
+ ****************************************************************************/
+
+static uint32_t bbr_bdp(FAR struct tcp_bbr_s *bbr, uint32_t bw,
+                        uint32_t gain)
+{
+  uint64_t bdp = (uint64_t)bw * bbr->min_rtt / MSEC_PER_SEC;
+
+  return (uint32_t)MIN(bdp * gain / BBR_UNIT, UINT32_MAX);
+}
+
+/****************************************************************************
+ * Name: bbr_enter_probe_bw
+ ****************************************************************************/
+
+static void bbr_enter_probe_bw(FAR struct tcp_bbr_s *bbr, uint32_t now)
+{
+  bbr->mode = BBR_PROBE_BW;
+
+  /* Start at a random phase, but not in the draining one */
+
+  bbr->cycle_idx = now % (BBR_CYCLE_LEN - 1);
+  if (bbr->cycle_idx > 0)
+    {
+      bbr->cycle_idx++;
+    }
+}
+
+/****************************************************************************
+ * Name: bbr_round_end
+ *
+ * Description:
+ *   Take a delivery rate sample once per round trip and advance the state
+ *   machine.
+ *
+ ****************************************************************************/
+
+static void bbr_round_end(FAR struct tcp_conn_s *conn, uint32_t now)
+{
+  FAR struct tcp_bbr_s *bbr = &conn->cc.bbr;
+  uint32_t elapsed = now - bbr->rnd_stamp;
+  uint32_t bw;
+
+  bbr->bw[bbr->bw_idx] = (uint32_t)MIN((uint64_t)(bbr->delivered -
+                                        bbr->rnd_delivered) *
+                                       MSEC_PER_SEC / elapsed, UINT32_MAX);
+  bbr->bw_idx = (bbr->bw_idx + 1) % TCP_BBR_BW_RTTS;
+  bbr->rnd_delivered = bbr->delivered;
+  bbr->rnd_stamp = now;
+
+  bw = bbr_max_bw(bbr);
+
+  switch (bbr->mode)
+    {
+      case BBR_STARTUP:
+        if ((uint64_t)bw * BBR_UNIT >=
+            (uint64_t)bbr->full_bw * BBR_FULL_BW_THRESH)
+          {
+            bbr->full_bw = bw;
+            bbr->full_bw_cnt = 0;
+          }
+        else if (++bbr->full_bw_cnt >= BBR_FULL_BW_CNT)
+          {
+            bbr->mode = BBR_DRAIN;
+            ninfo("bbr: pipe full at %" PRIu32 " B/s\n", bw);
+          }
+        break;
+
+      case BBR_PROBE_BW:
+        bbr->cycle_idx = (bbr->cycle_idx + 1) % BBR_CYCLE_LEN;
+        break;
+
+      default:
+        break;
+    }
+}
+
+/****************************************************************************
+ * Name: bbr_init
+ ****************************************************************************/
+
+static void bbr_init(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_bbr_s *bbr = &conn->cc.bbr;
+
+  bbr->mode = BBR_STARTUP;
+  bbr->rnd_stamp = TCP_CLOCK_MS();
+}
+
+/****************************************************************************
+ * Name: bbr_cong_avoid
+ *
+ * Description:
+ *   Update the path model with the newly delivered data and size cwnd
+ *   (and the pacing rate) from it.
+ *
+ ****************************************************************************/
+
+static void bbr_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  FAR struct tcp_bbr_s *bbr = &conn->cc.bbr;
+  uint32_t now = TCP_CLOCK_MS();
+  uint32_t pacing_gain;
+  uint32_t cwnd_gain;
+  uint32_t target;
+  uint32_t bw;
+
+  bbr->delivered += acked;
+
+  if (bbr->min_rtt == 0)
+    {
+      /* No RTT sample yet (e.g. the peer does not support timestamps),
+       * so there is no model either: grow as in slow start.
+       */
+
+      CC_CWND_INC(conn->cwnd, MIN(acked, conn->mss));
+      return;
+    }
+
+  if (now - bbr->rnd_stamp >= bbr->min_rtt)
+    {
+      bbr_round_end(conn, now);
+    }
+
+  bw = bbr_max_bw(bbr);
+
+  if (bbr->mode == BBR_DRAIN &&
+      conn->tx_unacked <= bbr_bdp(bbr, bw, BBR_UNIT))
+    {
+      bbr_enter_probe_bw(bbr, now);
+    }
+
+  if (bbr->mode == BBR_PROBE_RTT &&
+      (int32_t)(now - bbr->probe_rtt_done) >= 0)
+    {
+      bbr->min_rtt_stamp = now;
+      if (bbr->full_bw_cnt >= BBR_FULL_BW_CNT)
+        {
+          bbr_enter_probe_bw(bbr, now);
+        }
+      else
+        {
+          bbr->mode = BBR_STARTUP;
+        }
+    }
+
+  switch (bbr->mode)
+    {
+      case BBR_STARTUP:
+        pacing_gain = BBR_HIGH_GAIN;
+        cwnd_gain   = BBR_HIGH_GAIN;
+        break;
+
+      case BBR_DRAIN:
+        pacing_gain = BBR_DRAIN_GAIN;
+        cwnd_gain   = BBR_HIGH_GAIN;
+        break;
+
+      case BBR_PROBE_BW:
+        pacing_gain = g_bbr_cycle_gain[bbr->cycle_idx];
+        cwnd_gain   = BBR_CWND_GAIN;
+        break;
+
+      default:
+        pacing_gain = BBR_UNIT;
+        cwnd_gain   = BBR_UNIT;
+        break;
+    }
+
+#ifdef CONFIG_NET_TCP_CC_PACING
+  conn->pacing_rate = (uint32_t)MIN((uint64_t)bw * pacing_gain / BBR_UNIT,
+                                    UINT32_MAX);
+#else
+  UNUSED(pacing_gain);
+#endif
+
+  if (bw == 0)
+    {
+      /* The first round is not over yet */
+
+      CC_CWND_INC(conn->cwnd, MIN(acked, conn->mss));
+      return;
+    }
+
+  /* Allow for delayed and stretched ACKs with 3 extra segments */
+
+  target = bbr_bdp(bbr, bw, cwnd_gain) + 3 * conn->mss;
+  target = MAX(target, 4 * conn->mss);
+
+  if (bbr->mode == BBR_PROBE_RTT)
+    {
+      conn->cwnd = MIN(conn->cwnd, 4 * conn->mss);
+    }
+  else if (bbr->full_bw_cnt < BBR_FULL_BW_CNT)
+    {
+      /* Never shrink cwnd while still looking for the pipe size */
+
+      if (conn->cwnd < target)
+        {
+          CC_CWND_INC(conn->cwnd, acked);
+        }
+    }
+  else
+    {
+      CC_CWND_INC(conn->cwnd, acked);
+      conn->cwnd = MIN(conn->cwnd, target);
+    }
+}
+
+/****************************************************************************
+ * Name: bbr_ssthresh
+ *
+ * Description:
+ *   BBR does not reduce its model on a loss; the fast recovery logic keeps
+ *   cwnd and resumes at the same window once the loss is repaired.
+ *
+ ****************************************************************************/
+
+static uint32_t bbr_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  return MAX(conn->cwnd, 2 * conn->mss);
+}
+
+/****************************************************************************
+ * Name: bbr_rtt_sample
+ *
+ * Description:
+ *   Track the minimum RTT over a BBR_MIN_RTT_WIN window and enter PROBE_RTT
+ *   when it was not refreshed in time.
+ *
+ ****************************************************************************/
+
+static void bbr_rtt_sample(FAR struct tcp_conn_s *conn, uint32_t rtt)
+{
+  FAR struct tcp_bbr_s *bbr = &conn->cc.bbr;
+  uint32_t now = TCP_CLOCK_MS();
+  bool expired;
+
+  expired = bbr->min_rtt != 0 &&
+            now - bbr->min_rtt_stamp > BBR_MIN_RTT_WIN;
+
+  if (bbr->min_rtt == 0 || rtt <= bbr->min_rtt || expired)
+    {
+      bbr->min_rtt = rtt;
+      bbr->min_rtt_stamp = now;
+    }
+
+  if (expired && bbr->mode != BBR_PROBE_RTT)
+    {
+      bbr->mode = BBR_PROBE_RTT;
+      bbr->probe_rtt_done = now + BBR_PROBE_RTT_TIME;
+    }
+}
@@ -0,0 +1,237 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_cubic.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <inttypes.h>
+#include <debug.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Multiplicative decrease factor beta_cubic = 0.7, scaled by 1024 */
+
+#define CUBIC_BETA         717
+#define CUBIC_BETA_SCALE   1024
+
+/* Additive increase factor of the Reno friendly estimate,
+ * 3 * (1 - beta) / (1 + beta) = 0.529, scaled by 1024
+ */
+
+#define CUBIC_ALPHA        542
+
+/* The time origin of the cubic function (msec) is limited so that the
+ * cube of it cannot overflow.
+ */
+
+#define CUBIC_MAX_DT       100000
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void cubic_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked);
+static uint32_t cubic_ssthresh(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_cubic =
+{
+  "cubic",                  /* name */
+  NULL,                     /* init */
+  cubic_cong_avoid,         /* cong_avoid */
+  cubic_ssthresh,           /* ssthresh */
+  NULL                      /* rtt_sample */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cubic_cbrt
+ *
+ * Description:
+ *   Integer cube root, rounded down.
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+  uint64_t y = 0;
+  int s;
+
+  for (s = 63; s >= 0; s -= 3)
+    {
+      uint64_t b;
+
+      y <<= 1;
+      b = 3 * y * (y + 1) + 1;
+      if ((x >> s) >= b)
+        {
+          x -= b << s;
+          y++;
+        }
+    }
+
+  return (uint32_t)y;
+}
+
+/****************************************************************************
+ * Name: cubic_ssthresh
+ *
+ * Description:
+ *   A congestion event happened: remember the window it happened at and
+ *   reduce the window by beta_cubic (RFC 8312, Section 4.5 and 4.6).
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->cc.cubic;
+
+  cubic->epoch_start = 0;
+
+  /* Fast convergence: release bandwidth to new flows if the window did
+   * not even reach the previous saturation point.
+   */
+
+  if (conn->cwnd < cubic->w_last_max)
+    {
+      cubic->w_last_max = conn->cwnd;
+      cubic->w_max = (uint32_t)((uint64_t)conn->cwnd *
+                                (CUBIC_BETA_SCALE + CUBIC_BETA) /
+                                (2 * CUBIC_BETA_SCALE));
+    }
+  else
+    {
+      cubic->w_last_max = conn->cwnd;
+      cubic->w_max = conn->cwnd;
+    }
+
+  return MAX((uint32_t)((uint64_t)conn->cwnd * CUBIC_BETA /
+                        CUBIC_BETA_SCALE), 2 * conn->mss);
+}
+
+/****************************************************************************
+ * Name: cubic_cong_avoid
+ *
+ * Description:
+ *   Grow the window along W(t) = C * (t - K)^3 + W_max, or along the
+ *   Reno friendly estimate if that one is larger (RFC 8312, Section 4.1
+ *   to 4.3).
+ *
+ ****************************************************************************/
+
+static void cubic_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->cc.cubic;
+  uint32_t now = TCP_CLOCK_MS();
+  uint32_t inc = 0;
+  uint32_t limit;
+  int64_t target;
+  int64_t dt;
+
+  /* A window larger than the receive window of the peer is of no use, and
+   * bounding it keeps the cubic growth from overflowing on long lived
+   * flows.
+   */
+
+  limit = MAX((uint32_t)conn->snd_wnd, 2 * conn->mss);
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      /* Slow start is the same as for NewReno */
+
+      inc = MIN(acked, conn->mss);
+      goto out;
+    }
+
+  if (cubic->epoch_start == 0)
+    {
+      /* Start a new epoch, 0 is reserved for "no epoch" */
+
+      cubic->epoch_start = now != 0 ? now : 1;
+      cubic->w_est = conn->cwnd;
+
+      if (conn->cwnd < cubic->w_max)
+        {
+          /* K = cbrt(W_max * (1 - beta) / C), with C = 0.4 segments per
+           * second^3 and K in milliseconds.
+           */
+
+          cubic->k = cubic_cbrt((uint64_t)(cubic->w_max - conn->cwnd) *
+                                2500000000ull / conn->mss);
+        }
+      else
+        {
+          cubic->k = 0;
+          cubic->w_max = conn->cwnd;
+        }
+    }
+
+  /* Target window one RTT ahead, approximated by the current time */
+
+  dt = (int64_t)(uint32_t)(now - cubic->epoch_start) - cubic->k;
+  dt = MIN(MAX(dt, -CUBIC_MAX_DT), CUBIC_MAX_DT);
+
+  target = (int64_t)cubic->w_max +
+           dt * dt * dt / 1000 * 4 * conn->mss / 10000000;
+
+  if (target > conn->cwnd)
+    {
+      /* Reach the target within one RTT, but at most grow by 50% */
+
+      inc = (uint32_t)MIN((uint64_t)(target - conn->cwnd) * acked /
+                          conn->cwnd, acked / 2);
+    }
+
+  /* TCP friendly region: never be slower than standard TCP */
+
+  cubic->w_est += (uint32_t)((uint64_t)conn->mss * acked * CUBIC_ALPHA /
+                             CUBIC_BETA_SCALE / conn->cwnd);
+  cubic->w_est  = MIN(cubic->w_est, limit);
+
+  if (cubic->w_est > conn->cwnd)
+    {
+      inc = MAX(inc, (uint32_t)((uint64_t)(cubic->w_est - conn->cwnd) *
+                                acked / conn->cwnd));
+    }
+
+out:
+  if (conn->cwnd < limit)
+    {
+      conn->cwnd = (uint32_t)MIN((uint64_t)conn->cwnd + inc, limit);
+    }
+
+  ninfo("cubic cwnd %" PRIu32 " w_max %" PRIu32 "\n",
+        conn->cwnd, cubic->w_max);
+}
@@ -71,6 +71,7 @@
 #include "icmpv6/icmpv6.h"
 #include "nat/nat.h"
 #include "netdev/netdev.h"
+#include "socket/socket.h"
 #include "utils/utils.h"
 
 /****************************************************************************
@@ -81,6 +82,14 @@
 #  define CONFIG_NET_TCP_MAX_CONNS 0
 #endif
 
+/* The socket options of a connection checked when binding its port */
+
+#ifdef CONFIG_NET_SOCKOPTS
+#  define TCP_SOCKOPTS(conn) ((conn)->sconn.s_options)
+#else
+#  define TCP_SOCKOPTS(conn) 0
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -109,13 +118,20 @@ static dq_queue_t g_active_tcp_connections;
  *   Primary uses: (1) to determine if a port number is available, (2) to
  *   To identify the socket that will accept new connections on a local port.
  *
+ *   opt are the options of the socket asking for the port:  with
+ *   SO_REUSEPORT, the connections with the same option and the same local
+ *   address do not conflict, they form a group sharing the port.
+ *
  ****************************************************************************/
 
 static FAR struct tcp_conn_s *
   tcp_listener(uint8_t domain, FAR const union ip_addr_u *ipaddr,
-               uint16_t portno)
+               uint16_t portno, sockopt_t opt)
 {
   FAR struct tcp_conn_s *conn = NULL;
+#ifdef CONFIG_NET_REUSEPORT
+  bool reuseport = _SO_GETOPT(opt, SO_REUSEPORT);
+#endif
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
@@ -142,6 +158,15 @@ static FAR struct tcp_conn_s *
           if (domain == PF_INET)
 #endif /* CONFIG_NET_IPv6 */
             {
+#ifdef CONFIG_NET_REUSEPORT
+              if (reuseport &&
+                  _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT) &&
+                  net_ipv4addr_cmp(conn->u.ipv4.laddr, ipaddr->ipv4))
+                {
+                  continue;
+                }
+#endif
+
               if (net_ipv4addr_cmp(conn->u.ipv4.laddr, ipaddr->ipv4) ||
                   net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY))
                 {
@@ -157,6 +182,15 @@ static FAR struct tcp_conn_s *
           else
 #endif /* CONFIG_NET_IPv4 */
             {
+#ifdef CONFIG_NET_REUSEPORT
+              if (reuseport &&
+                  _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT) &&
+                  net_ipv6addr_cmp(conn->u.ipv6.laddr, ipaddr->ipv6))
+                {
+                  continue;
+                }
+#endif
+
               if (net_ipv6addr_cmp(conn->u.ipv6.laddr, ipaddr->ipv6) ||
                   net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr))
                 {
@@ -366,7 +400,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
   port = tcp_selectport(PF_INET,
                        (FAR const union ip_addr_u *)&addr->sin_addr.s_addr,
-                       addr->sin_port);
+                       addr->sin_port, TCP_SOCKOPTS(conn));
   if (port < 0)
     {
       nerr("ERROR: tcp_selectport failed: %d\n", port);
@@ -466,7 +500,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
   port = tcp_selectport(PF_INET6,
                 (FAR const union ip_addr_u *)addr->sin6_addr.in6_u.u6_addr16,
-                addr->sin6_port);
+                addr->sin6_port, TCP_SOCKOPTS(conn));
   if (port < 0)
     {
       nerr("ERROR: tcp_selectport failed: %d\n", port);
@@ -516,6 +550,8 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
  * Input Parameters:
  *   portno -- the selected port number in network order. Zero means no port
  *     selected.
+ *   opt -- the options of the socket binding the port, SO_REUSEPORT lets
+ *     it share the port with other such sockets.  Zero if there is none.
  *
  * Returned Value:
  *   Selected or verified port number in network order on success, a negated
@@ -533,7 +569,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
 int tcp_selectport(uint8_t domain,
                    FAR const union ip_addr_u *ipaddr,
-                   uint16_t portno)
+                   uint16_t portno, sockopt_t opt)
 {
   static uint16_t g_last_tcp_port;
 
@@ -566,7 +602,7 @@ int tcp_selectport(uint8_t domain,
               return -EADDRINUSE;
             }
         }
-      while (tcp_listener(domain, ipaddr, portno)
+      while (tcp_listener(domain, ipaddr, portno, 0)
 #ifdef CONFIG_NET_NAT
              || nat_port_inuse(domain, IP_PROTO_TCP, ipaddr, portno)
 #endif
@@ -578,7 +614,7 @@ int tcp_selectport(uint8_t domain,
        * connection is using this local port.
        */
 
-      if (tcp_listener(domain, ipaddr, portno)
+      if (tcp_listener(domain, ipaddr, portno, opt)
 #ifdef CONFIG_NET_NAT
           || nat_port_inuse(domain, IP_PROTO_TCP, ipaddr, portno)
 #endif
@@ -835,6 +871,16 @@ void tcp_free(FAR struct tcp_conn_s *conn)
 
   tcp_stop_timer(conn);
 
+#ifdef CONFIG_NET_TCP_CC_PACING
+  /* Cancel the pending pacing work.  With no pacing rate, it cannot be
+   * queued again, and a work already running finds that the connection is
+   * no longer active.
+   */
+
+  conn->pacing_rate = 0;
+  work_cancel(LPWORK, &conn->pacework);
+#endif
+
   /* Make sure monitor is stopped. */
 
   tcp_stop_monitor(conn, TCP_CLOSE);
@@ -903,6 +949,12 @@ void tcp_free(FAR struct tcp_conn_s *conn)
     }
 #endif
 
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+  /* Zero-copy sends still held by a driver complete silently */
+
+  net_zc_detach(&conn->sconn);
+#endif
+
   /* Mark the connection available. */
 
   conn->tcpstateflags = TCP_CLOSED;
@@ -1104,6 +1156,9 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
       conn->snd_bufs         = listener->snd_bufs;
 #endif
       conn->mss              = listener->mss;
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+      conn->cc_ops           = listener->cc_ops;
+#endif
 
       /* Fill in the necessary fields for the new connection. */
 
@@ -1271,7 +1326,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
           port = tcp_selectport(PF_INET,
                                 (FAR const union ip_addr_u *)
-                                &conn->u.ipv4.laddr, 0);
+                                &conn->u.ipv4.laddr, 0, 0);
         }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -1286,7 +1341,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
           port = tcp_selectport(PF_INET6,
                                 (FAR const union ip_addr_u *)
-                                conn->u.ipv6.laddr, 0);
+                                conn->u.ipv6.laddr, 0, 0);
         }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -615,6 +615,14 @@ static void tcp_parse_option(FAR struct net_driver_s *dev,
         {
           conn->flags    |= TCP_SACK;
         }
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+      else if (opt == TCP_OPT_TS &&
+               IPDATA(tcpiplen + 1 + i) == TCP_OPT_TS_LEN)
+        {
+          conn->ts_recent = tcp_getsequence(&IPDATA(tcpiplen + 2 + i));
+          conn->flags    |= TCP_TSTAMP;
+        }
 #endif
       else
         {
@@ -634,7 +642,98 @@ static void tcp_parse_option(FAR struct net_driver_s *dev,
 
       i += IPDATA(tcpiplen + 1 + i);
     }
+
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+  /* Every segment will carry the Timestamps option from now on */
+
+  if ((conn->flags & TCP_TSTAMP) != 0)
+    {
+      conn->mss -= TCP_OPT_TS_ALIGNED_LEN;
+    }
+#endif
+}
+
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+/****************************************************************************
+ * Name: tcp_parse_timestamp
+ *
+ * Description:
+ *   Parse the Timestamps option of a segment on a connection that
+ *   negotiated it: remember the TSval to be echoed and take an RTT sample
+ *   from the echoed TSecr (RFC 7323, Section 4.1).
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure containing the received packet
+ *   conn   - The TCP connection of interest
+ *   iplen  - Length of the IP header
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_parse_timestamp(FAR struct net_driver_s *dev,
+                                FAR struct tcp_conn_s *conn,
+                                unsigned int iplen)
+{
+  FAR struct tcp_hdr_s *tcp = IPBUF(iplen);
+  unsigned int tcpiplen = iplen + TCP_HDRLEN;
+  unsigned int optlen = ((tcp->tcpoffset >> 4) - 5) << 2;
+  unsigned int i;
+  uint8_t opt;
+
+  for (i = 0; i + 1 < optlen; )
+    {
+      opt = IPDATA(tcpiplen + i);
+      if (opt == TCP_OPT_END)
+        {
+          break;
+        }
+      else if (opt == TCP_OPT_NOOP)
+        {
+          i++;
+          continue;
+        }
+      else if (opt == TCP_OPT_TS &&
+               IPDATA(tcpiplen + 1 + i) == TCP_OPT_TS_LEN &&
+               i + TCP_OPT_TS_LEN <= optlen)
+        {
+          uint32_t tsval = tcp_getsequence(&IPDATA(tcpiplen + 2 + i));
+          uint32_t tsecr = tcp_getsequence(&IPDATA(tcpiplen + 6 + i));
+
+          /* Only move ts_recent forward */
+
+          if (TCP_SEQ_GTE(tsval, conn->ts_recent))
+            {
+              conn->ts_recent = tsval;
+            }
+
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+          /* Only ACKs of new data give a valid RTT sample */
+
+          if ((tcp->flags & TCP_ACK) != 0 && tsecr != 0 &&
+              TCP_SEQ_GT(tcp_getsequence(tcp->ackno), conn->last_ackno))
+            {
+              tcp_cc_rtt_sample(conn, MAX(TCP_CLOCK_MS() - tsecr, 1));
+            }
+#else
+          UNUSED(tsecr);
+#endif
+
+          break;
+        }
+      else if (IPDATA(tcpiplen + 1 + i) == 0)
+        {
+          break;
+        }
+
+      i += IPDATA(tcpiplen + 1 + i);
+    }
 }
+#endif
 
 /****************************************************************************
  * Name: tcp_clear_zero_probe
@@ -695,7 +794,6 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   FAR struct tcp_conn_s *conn = NULL;
   FAR struct tcp_hdr_s *tcp;
   union ip_binding_u uaddr;
-  unsigned int tcpiplen;
   uint16_t tmp16;
   uint16_t flags;
   uint16_t result;
@@ -713,16 +811,6 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   tcp = IPBUF(iplen);
 
-  /* Get the size of the IP header and the TCP header.
-   *
-   * REVISIT:  TCP header is *not* a constant!  It can be larger if the
-   * TCP header includes options.  The constant TCP_HDRLEN should be
-   * replaced with the macro TCP_OPT_HDRLEN(n) which will calculate the
-   * correct header length in all cases.
-   */
-
-  tcpiplen = iplen + TCP_HDRLEN;
-
 #ifdef CONFIG_NET_TCP_CHECKSUMS
   /* Start of TCP input header processing code. */
 
@@ -781,6 +869,7 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 #  endif
         {
           net_ipv6addr_copy(&uaddr.ipv6.laddr, IPv6BUF->destipaddr);
+          net_ipv6addr_copy(&uaddr.ipv6.raddr, IPv6BUF->srcipaddr);
         }
 #endif
 
@@ -791,13 +880,16 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
         {
           net_ipv4addr_copy(uaddr.ipv4.laddr,
                             net_ip4addr_conv32(IPv4BUF->destipaddr));
+          net_ipv4addr_copy(uaddr.ipv4.raddr,
+                            net_ip4addr_conv32(IPv4BUF->srcipaddr));
         }
 #endif
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-      if ((conn = tcp_findlistener(&uaddr, tmp16, domain)) != NULL)
+      if ((conn = tcp_findlistener(&uaddr, tmp16, tcp->srcport,
+                                   domain)) != NULL)
 #else
-      if ((conn = tcp_findlistener(&uaddr, tmp16)) != NULL)
+      if ((conn = tcp_findlistener(&uaddr, tmp16, tcp->srcport)) != NULL)
 #endif
         {
           if (!tcp_backlogavailable(conn))
@@ -920,6 +1012,7 @@ found:
 #  endif
             {
               net_ipv6addr_copy(&uaddr.ipv6.laddr, IPv6BUF->destipaddr);
+              net_ipv6addr_copy(&uaddr.ipv6.raddr, IPv6BUF->srcipaddr);
             }
 #endif
 
@@ -930,13 +1023,16 @@ found:
             {
               net_ipv4addr_copy(uaddr.ipv4.laddr,
                                 net_ip4addr_conv32(IPv4BUF->destipaddr));
+              net_ipv4addr_copy(uaddr.ipv4.raddr,
+                                net_ip4addr_conv32(IPv4BUF->srcipaddr));
             }
 #endif
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-          listener = tcp_findlistener(&uaddr, conn->lport, domain);
+          listener = tcp_findlistener(&uaddr, conn->lport, conn->rport,
+                                      domain);
 #else
-          listener = tcp_findlistener(&uaddr, conn->lport);
+          listener = tcp_findlistener(&uaddr, conn->lport, conn->rport);
 #endif
 
           /* We must free this TCP connection structure; this connection
@@ -1210,7 +1306,7 @@ found:
                    * E.g. a keep-alive segment.
                    */
 
-                  tcp_send(dev, conn, TCP_ACK, tcpiplen);
+                  tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
                   return;
                 }
             }
@@ -1223,7 +1319,7 @@ found:
 #endif
               if ((conn->tcpstateflags & TCP_STATE_MASK) <= TCP_ESTABLISHED)
                 {
-                  tcp_send(dev, conn, TCP_ACK, tcpiplen);
+                  tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
                   return;
                 }
             }
@@ -1232,6 +1328,13 @@ found:
 
   tcp_clear_zero_probe(conn, tcp);
 
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+  if ((conn->flags & TCP_TSTAMP) != 0 && (tcp->tcpoffset & 0xf0) > 0x50)
+    {
+      tcp_parse_timestamp(dev, conn, iplen);
+    }
+#endif
+
   /* Update the connection's window size */
 
   if ((tcp->flags & TCP_ACK) != 0 &&
@@ -1450,7 +1553,7 @@ found:
                 conn->sndseq_max    = tcp_getsequence(conn->sndseq) + 1;
 #endif
                 ninfo("TCP state: TCP_LAST_ACK\n");
-                tcp_send(dev, conn, TCP_FIN | TCP_ACK, tcpiplen);
+                tcp_send(dev, conn, TCP_FIN | TCP_ACK, tcpip_hdrsize(conn));
               }
             else
               {
@@ -1631,7 +1734,7 @@ found:
 
             net_incr32(conn->rcvseq, 1); /* ack FIN */
             tcp_callback(dev, conn, TCP_CLOSE);
-            tcp_send(dev, conn, TCP_ACK, tcpiplen);
+            tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
             return;
           }
         else if ((flags & TCP_ACKDATA) != 0 && conn->tx_unacked == 0)
@@ -1678,7 +1781,7 @@ found:
 
             net_incr32(conn->rcvseq, 1); /* ack FIN */
             tcp_callback(dev, conn, TCP_CLOSE);
-            tcp_send(dev, conn, TCP_ACK, tcpiplen);
+            tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
             return;
           }
 
@@ -1703,7 +1806,7 @@ found:
         goto drop;
 
       case TCP_TIME_WAIT:
-        tcp_send(dev, conn, TCP_ACK, tcpiplen);
+        tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
         return;
 
       case TCP_CLOSING:
@@ -55,7 +55,9 @@
 
 #include "devif/devif.h"
 #include "inet/inet.h"
+#include "socket/socket.h"
 #include "tcp/tcp.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Private Data
@@ -82,13 +84,17 @@ static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
 FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
-                                        uint16_t portno,
+                                        uint16_t portno, uint16_t rport,
                                         uint8_t domain)
 #else
 FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
-                                        uint16_t portno)
+                                        uint16_t portno, uint16_t rport)
 #endif
 {
+#ifdef CONFIG_NET_REUSEPORT
+  FAR struct tcp_conn_s *group[CONFIG_NET_MAX_LISTENPORTS];
+  int ngroup = 0;
+#endif
   int ndx;
 
   /* Examine each connection structure in each slot of the listener list */
@@ -116,6 +122,18 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
                 {
                   /* Yes.. we found a listener on this port */
 
+#ifdef CONFIG_NET_REUSEPORT
+                  if (_SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT))
+                    {
+                      /* It is one of a SO_REUSEPORT group, collect all
+                       * members before selecting one.
+                       */
+
+                      group[ngroup++] = conn;
+                      continue;
+                    }
+#endif
+
                   return conn;
                 }
             }
@@ -131,6 +149,18 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
                 {
                   /* Yes.. we found a listener on this port */
 
+#ifdef CONFIG_NET_REUSEPORT
+                  if (_SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT))
+                    {
+                      /* It is one of a SO_REUSEPORT group, collect all
+                       * members before selecting one.
+                       */
+
+                      group[ngroup++] = conn;
+                      continue;
+                    }
+#endif
+
                   return conn;
                 }
             }
@@ -138,6 +168,40 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
         }
     }
 
+#ifdef CONFIG_NET_REUSEPORT
+  /* Distribute the connections among the members of the SO_REUSEPORT
+   * group by a hash of the remote address and port.  All segments of the
+   * same handshake then find the same listener.
+   */
+
+  if (ngroup > 0)
+    {
+      uint32_t hash;
+
+#ifdef CONFIG_NET_IPv6
+#  ifdef CONFIG_NET_IPv4
+      if (domain == PF_INET6)
+#  endif
+        {
+          hash = net_flowhash(uaddr->ipv6.raddr, sizeof(net_ipv6addr_t),
+                              rport, portno);
+        }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#  ifdef CONFIG_NET_IPv6
+      else
+#  endif
+        {
+          hash = net_flowhash(&uaddr->ipv4.raddr, sizeof(in_addr_t),
+                              rport, portno);
+        }
+#endif
+
+      return group[hash % ngroup];
+    }
+#endif
+
   /* No listener for this port */
 
   return NULL;
@@ -191,6 +255,7 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
 
 int tcp_listen(FAR struct tcp_conn_s *conn)
 {
+  FAR struct tcp_conn_s *listener;
   int ndx;
   int ret;
 
@@ -203,10 +268,23 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
   /* First, check if there is already a socket listening on this port */
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-  if (tcp_islistener(&conn->u, conn->lport, conn->domain))
+  listener = tcp_findlistener(&conn->u, conn->lport, 0, conn->domain);
 #else
-  if (tcp_islistener(&conn->u, conn->lport))
+  listener = tcp_findlistener(&conn->u, conn->lport, 0);
 #endif
+
+#ifdef CONFIG_NET_REUSEPORT
+  /* Several listeners may share the port if all of them set SO_REUSEPORT */
+
+  if (listener != NULL &&
+      _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT) &&
+      _SO_GETOPT(listener->sconn.s_options, SO_REUSEPORT))
+    {
+      listener = NULL;
+    }
+#endif
+
+  if (listener != NULL)
     {
       /* Yes, then we must refuse this request */
 
@@ -256,12 +334,12 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
 bool tcp_islistener(FAR union ip_binding_u *uaddr, uint16_t portno,
                     uint8_t domain)
 {
-  return tcp_findlistener(uaddr, portno, domain) != NULL;
+  return tcp_findlistener(uaddr, portno, 0, domain) != NULL;
 }
 #else
 bool tcp_islistener(FAR union ip_binding_u *uaddr, uint16_t portno)
 {
-  return tcp_findlistener(uaddr, portno) != NULL;
+  return tcp_findlistener(uaddr, portno, 0) != NULL;
 }
 #endif
 
@@ -288,9 +366,9 @@ int tcp_accept_connection(FAR struct net_driver_s *dev,
    */
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-  listener = tcp_findlistener(&conn->u, portno, conn->domain);
+  listener = tcp_findlistener(&conn->u, portno, conn->rport, conn->domain);
 #else
-  listener = tcp_findlistener(&conn->u, portno);
+  listener = tcp_findlistener(&conn->u, portno, conn->rport);
 #endif
   if (listener != NULL)
     {
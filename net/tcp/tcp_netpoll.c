@@ -40,6 +40,7 @@
 #include "socket/socket.h"
 #include "inet/inet.h"
 #include "tcp/tcp.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Private Functions
@@ -94,6 +95,15 @@ static uint16_t tcp_poll_eventhandler(FAR struct net_driver_s *dev,
           eventset |= POLLOUT;
         }
 
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+      /* A MSG_ZEROCOPY completion is waiting on the error queue */
+
+      if ((flags & NET_ERRQUEUE) != 0)
+        {
+          eventset |= POLLERR;
+        }
+#endif
+
       /* Check for a loss of connection events. */
 
       if ((flags & TCP_DISCONN_EVENTS) != 0)
@@ -262,6 +272,10 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
   cb->priv  = info;
   cb->event = tcp_poll_eventhandler;
 
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+  cb->flags |= NET_ERRQUEUE;
+#endif
+
   if ((fds->events & POLLOUT) != 0)
     {
       cb->flags |= TCP_POLL;
@@ -354,6 +368,13 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       eventset |= POLLWRNORM;
     }
 
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+  if (net_zc_pending(&conn->sconn))
+    {
+      eventset |= POLLERR;
+    }
+#endif
+
   /* Check if any requested events are already in effect */
 
   poll_notify(&fds, 1, eventset);
@@ -258,6 +258,37 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
 #endif
 }
 
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+/****************************************************************************
+ * Name: tcp_timestamp_option
+ *
+ * Description:
+ *   Write the Timestamps option, preceded by two NOPs for alignment
+ *   (RFC 7323, Appendix A).
+ *
+ * Input Parameters:
+ *   optdata - Where to write the option
+ *   conn    - The TCP connection structure holding connection information
+ *
+ * Returned Value:
+ *   The number of bytes written.
+ *
+ ****************************************************************************/
+
+static int tcp_timestamp_option(FAR uint8_t *optdata,
+                                FAR struct tcp_conn_s *conn)
+{
+  optdata[0] = TCP_OPT_NOOP;
+  optdata[1] = TCP_OPT_NOOP;
+  optdata[2] = TCP_OPT_TS;
+  optdata[3] = TCP_OPT_TS_LEN;
+  tcp_setsequence(&optdata[4], TCP_CLOCK_MS());
+  tcp_setsequence(&optdata[8], conn->ts_recent);
+
+  return TCP_OPT_TS_ALIGNED_LEN;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -297,38 +328,61 @@ void tcp_send(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   tcp->flags = flags;
   dev->d_len = len;
 
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+  /* The space of the Timestamps option is already accounted for in len,
+   * tcpip_hdrsize() includes it.
+   */
+
+  if ((conn->flags & TCP_TSTAMP) != 0)
+    {
+      tcp_timestamp_option(tcp->optdata, conn);
+    }
+#endif
+
 #ifdef CONFIG_NET_TCP_SELECTIVE_ACK
   if ((conn->flags & TCP_SACK) && (flags == TCP_ACK) && conn->nofosegs > 0)
     {
-      int optlen = conn->nofosegs * sizeof(struct tcp_sack_s);
+      FAR uint8_t *optdata = tcp->optdata + TCP_TSOPT_SIZE(conn);
+      int nsacks = conn->nofosegs;
+      int optlen;
       int i;
 
-      tcp->optdata[0] = TCP_OPT_NOOP;
-      tcp->optdata[1] = TCP_OPT_NOOP;
-      tcp->optdata[2] = TCP_OPT_SACK;
-      tcp->optdata[3] = TCP_OPT_SACK_PERM_LEN + optlen;
+      /* The SACK blocks have to fit in the remaining option space */
+
+      if (TCP_TSOPT_SIZE(conn) > 0 && nsacks > TCP_SACK_RANGES_MAX - 1)
+        {
+          nsacks = TCP_SACK_RANGES_MAX - 1;
+        }
+
+      optlen = nsacks * sizeof(struct tcp_sack_s);
+
+      optdata[0] = TCP_OPT_NOOP;
+      optdata[1] = TCP_OPT_NOOP;
+      optdata[2] = TCP_OPT_SACK;
+      optdata[3] = TCP_OPT_SACK_PERM_LEN + optlen;
 
       optlen += 4;
 
-      for (i = 0; i < conn->nofosegs; i++)
+      for (i = 0; i < nsacks; i++)
         {
           ninfo("TCP SACK [%d]"
                 "[%" PRIu32 " : %" PRIu32 " : %" PRIu32 "]\n", i,
                 conn->ofosegs[i].left, conn->ofosegs[i].right,
                 TCP_SEQ_SUB(conn->ofosegs[i].right, conn->ofosegs[i].left));
-          tcp_setsequence(&tcp->optdata[4 + i * 2 * sizeof(uint32_t)],
+          tcp_setsequence(&optdata[4 + i * 2 * sizeof(uint32_t)],
                           conn->ofosegs[i].left);
-          tcp_setsequence(&tcp->optdata[4 + (i * 2 + 1) * sizeof(uint32_t)],
+          tcp_setsequence(&optdata[4 + (i * 2 + 1) * sizeof(uint32_t)],
                           conn->ofosegs[i].right);
         }
 
       dev->d_len += optlen;
-      tcp->tcpoffset = ((TCP_HDRLEN + optlen) / 4) << 4;
+      tcp->tcpoffset = ((TCP_HDRLEN + TCP_TSOPT_SIZE(conn) + optlen) / 4)
+                       << 4;
     }
   else
 #endif /* CONFIG_NET_TCP_SELECTIVE_ACK */
     {
-      tcp->tcpoffset = (TCP_HDRLEN / 4) << 4;
+      tcp->tcpoffset = ((TCP_HDRLEN + TCP_TSOPT_SIZE(conn)) / 4) << 4;
     }
 
   tcp_sendcommon(dev, conn, tcp);
@@ -607,9 +661,11 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
   tcp = tcp_header(dev);
 
-  /* Set the packet length for the TCP Maximum Segment Size */
+  /* Set the packet length for the TCP Maximum Segment Size, the options
+   * are added below.
+   */
 
-  dev->d_len = tcpip_hdrsize(conn);
+  dev->d_len = tcpip_hdrsize(conn) - TCP_TSOPT_SIZE(conn);
 
   /* Set the packet length for the TCP Maximum Segment Size */
 
@@ -662,6 +718,14 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
     }
 #endif
 
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+  if (tcp->flags == TCP_SYN ||
+      ((tcp->flags == (TCP_ACK | TCP_SYN)) && (conn->flags & TCP_TSTAMP)))
+    {
+      optlen += tcp_timestamp_option(&tcp->optdata[optlen], conn);
+    }
+#endif
+
   tcp->tcpoffset         = ((TCP_HDRLEN + optlen) / 4) << 4;
   dev->d_len            += optlen;
 
@@ -733,9 +797,8 @@ void tcp_send_txnotify(FAR struct socket *psock,
 
 uint16_t tcpip_hdrsize(FAR struct tcp_conn_s *conn)
 {
-  uint16_t hdrsize = sizeof(struct tcp_hdr_s);
+  uint16_t hdrsize = sizeof(struct tcp_hdr_s) + TCP_TSOPT_SIZE(conn);
 
-  UNUSED(conn);
   return net_ip_domain_select(conn->domain,
                               sizeof(struct ipv4_hdr_s) + hdrsize,
                               sizeof(struct ipv6_hdr_s) + hdrsize);
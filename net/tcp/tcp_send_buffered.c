@@ -1040,6 +1040,15 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           uint32_t remaining_snd_wnd;
           int ret;
 
+#ifdef CONFIG_NET_TCP_CC_PACING
+          /* Wait until the pacing rate allows the next segment */
+
+          if (!tcp_pacing_check(conn))
+            {
+              return flags;
+            }
+#endif
+
           sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
           if (sndlen > conn->mss)
             {
@@ -1123,6 +1132,10 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           conn->tx_unacked += sndlen;
           conn->sent       += sndlen;
 
+#ifdef CONFIG_NET_TCP_CC_PACING
+          tcp_pacing_sent(conn, sndlen);
+#endif
+
           /* Below prediction will become true,
            * unless retransmission occurrence
            */
@@ -1316,6 +1329,9 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
   FAR struct tcp_conn_s *conn;
   FAR struct tcp_wrbuffer_s *wrb;
   FAR const uint8_t *cp;
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+  FAR struct net_zcrec_s *zcrec = NULL;
+#endif
   unsigned int timeout;
   ssize_t    result = 0;
   bool       nonblock;
@@ -1379,6 +1395,18 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
   BUF_DUMP("psock_tcp_send", buf, len);
 
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+  /* A MSG_ZEROCOPY send references the user buffer from the write buffers
+   * until the data is acknowledged.
+   */
+
+  if ((flags & MSG_ZEROCOPY) != 0 &&
+      _SO_GETOPT(conn->sconn.s_options, SO_ZEROCOPY))
+    {
+      zcrec = net_zc_begin(&conn->sconn);
+    }
+#endif
+
   cp = buf;
   while (len > 0)
     {
@@ -1487,6 +1515,9 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
           wrb = (FAR struct tcp_wrbuffer_s *)sq_tail(&conn->write_q);
           if (wrb != NULL && TCP_WBSENT(wrb) == 0 && TCP_WBNRTX(wrb) == 0 &&
               TCP_WBPKTLEN(wrb) < max_wrb_size &&
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+              zcrec == NULL &&
+#endif
               (TCP_WBPKTLEN(wrb) % conn->mss) != 0)
             {
               wrb = (FAR struct tcp_wrbuffer_s *)sq_remlast(&conn->write_q);
@@ -1535,6 +1566,25 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
               chunk_len = max_wrb_size - off;
             }
 
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+          /* Reference the user data instead of copying it.  The wrb is
+           * always a new one here, so its IOB is simply replaced.
+           */
+
+          if (zcrec != NULL)
+            {
+              iob = net_zc_iobchain(zcrec, cp, chunk_len);
+              if (iob != NULL)
+                {
+                  DEBUGASSERT(off == 0);
+                  iob_free_chain(wrb->wb_iob);
+                  wrb->wb_iob  = iob;
+                  chunk_result = chunk_len;
+                  break;
+                }
+            }
+#endif
+
           /* Copy the user data into the write buffer.  We cannot wait for
            * buffer space.
            */
@@ -1672,6 +1722,13 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
       goto errout;
     }
 
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+  if (zcrec != NULL)
+    {
+      net_zc_end(zcrec, true);
+    }
+#endif
+
   /* Return the number of bytes actually sent */
 
   return result;
@@ -1680,6 +1737,13 @@ errout_with_lock:
   net_unlock();
 
 errout:
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+  if (zcrec != NULL)
+    {
+      net_zc_end(zcrec, result > 0);
+    }
+#endif
+
   if (result > 0)
     {
       return result;
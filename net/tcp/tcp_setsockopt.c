@@ -28,6 +28,7 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -260,6 +261,21 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
           }
         break;
 
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+      case TCP_CONGESTION: /* Congestion control algorithm */
+        {
+          char name[TCP_CA_NAME_MAX];
+          size_t len = MIN(value_len, sizeof(name) - 1);
+
+          /* The name need not be NUL terminated */
+
+          memcpy(name, value, len);
+          name[len] = '\0';
+          ret = tcp_cc_select(conn, name);
+        }
+        break;
+#endif
+
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
         ret = -ENOPROTOOPT;
@@ -536,9 +536,10 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
 
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
                   listener = tcp_findlistener(&conn->u, conn->lport,
-                                              conn->domain);
+                                              conn->rport, conn->domain);
 #else
-                  listener = tcp_findlistener(&conn->u, conn->lport);
+                  listener = tcp_findlistener(&conn->u, conn->lport,
+                                              conn->rport);
 #endif
                   if (listener != NULL)
                     {
@@ -652,22 +653,9 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
                     tcp_rexmit(dev, conn, result);
 
 #ifdef CONFIG_NET_TCP_CC_NEWRENO
-                    /* If conn is TCP_INFR, it should enter to slow start */
-
-                    if (conn->flags & TCP_INFR)
-                      {
-                        conn->flags &= ~TCP_INFR;
-                      }
-
-                    /* update the max_cwnd */
-
-                    conn->max_cwnd = (conn->max_cwnd + 7 * conn->cwnd) >> 3;
-
-                    /* reset cwnd and ssthresh, refers to RFC5861. */
+                    /* Enter slow start again, refers to RFC5681. */
 
-                    conn->ssthresh =
-                                    MAX(conn->tx_unacked / 2, 2 * conn->mss);
-                    conn->cwnd = conn->mss;
+                    tcp_cc_rto(conn);
 #endif
                     goto done;
 
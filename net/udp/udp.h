@@ -1024,6 +1024,20 @@ void udp_sendbuffer_notify(FAR struct udp_conn_s *conn);
 
 uint16_t udpip_hdrsize(FAR struct udp_conn_s *conn);
 
+/****************************************************************************
+ * Name: udp_reuseport_selftest
+ *
+ * Description:
+ *   Start a kernel thread that checks, over the loopback device, how
+ *   unicast datagrams are spread among the members of a SO_REUSEPORT
+ *   group.  The result is reported to the syslog.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_REUSEPORT_SELFTEST
+void udp_reuseport_selftest(void);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
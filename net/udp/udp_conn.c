@@ -113,6 +113,8 @@ static dq_queue_t g_active_udp_connections;
  *   portno - The port to use in the lookup
  *   opt    - The option from another conn to match the conflict conn
  *              SO_REUSEADDR: If both sockets have this, they never confilct.
+ *              SO_REUSEPORT: If both sockets have this, they may share the
+ *                            port.
  *
  * Assumptions:
  *   This function must be called with the network locked.
@@ -127,6 +129,9 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
 #ifdef CONFIG_NET_SOCKOPTS
   bool skip_reusable = _SO_GETOPT(opt, SO_REUSEADDR);
 #endif
+#ifdef CONFIG_NET_REUSEPORT
+  bool skip_reuseport = _SO_GETOPT(opt, SO_REUSEPORT);
+#endif
 
   /* Now search each connection structure. */
 
@@ -143,6 +148,17 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
         }
 #endif
 
+#ifdef CONFIG_NET_REUSEPORT
+      /* Sockets with SO_REUSEPORT set on both sides form a group sharing
+       * the same port, incoming datagrams are distributed among them.
+       */
+
+      if (skip_reuseport && _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT))
+        {
+          continue;
+        }
+#endif
+
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
        * reference to the connection structure.  INADDR_ANY is a special
@@ -648,6 +664,12 @@ void udp_free(FAR struct udp_conn_s *conn)
   udp_sendbuffer_notify(conn);
 #endif /* CONFIG_NET_SEND_BUFSIZE */
 
+#endif
+
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+  /* Zero-copy sends still held by a driver complete silently */
+
+  net_zc_detach(&conn->sconn);
 #endif
 
   /* Free the connection. */
@@ -55,6 +55,8 @@
 #include <nuttx/net/netstats.h>
 
 #include "devif/devif.h"
+#include "inet/inet.h"
+#include "socket/socket.h"
 #include "utils/utils.h"
 #include "udp/udp.h"
 #include "icmp/icmp.h"
@@ -111,6 +113,174 @@ static bool udp_is_broadcast(FAR struct net_driver_s *dev)
 }
 #endif
 
+/****************************************************************************
+ * Name: udp_reuseport_member, udp_reuseport_exact and udp_reuseport_same
+ *
+ * Description:
+ *   A SO_REUSEPORT group is made of the connection-less sockets with the
+ *   option bound to the same local address and port.  The sockets bound to
+ *   a specific address are preferred to those bound to INADDR_ANY or
+ *   in6addr_any.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_REUSEPORT
+static bool udp_reuseport_member(FAR struct udp_conn_s *conn)
+{
+  return _SO_GETOPT(conn->sconn.s_options, SO_REUSEPORT) &&
+         !_UDP_ISCONNECTMODE(conn->flags);
+}
+
+static bool udp_reuseport_exact(FAR struct udp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv6
+#  ifdef CONFIG_NET_IPv4
+  if (conn->domain == PF_INET6)
+#  endif
+    {
+      return !net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#  ifdef CONFIG_NET_IPv6
+  else
+#  endif
+    {
+      return !net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY);
+    }
+#endif
+}
+
+static bool udp_reuseport_same(FAR struct udp_conn_s *conn1,
+                               FAR struct udp_conn_s *conn2)
+{
+  if (conn1->domain != conn2->domain)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_IPv6
+#  ifdef CONFIG_NET_IPv4
+  if (conn1->domain == PF_INET6)
+#  endif
+    {
+      return net_ipv6addr_cmp(conn1->u.ipv6.laddr, conn2->u.ipv6.laddr);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#  ifdef CONFIG_NET_IPv6
+  else
+#  endif
+    {
+      return net_ipv4addr_cmp(conn1->u.ipv4.laddr, conn2->u.ipv4.laddr);
+    }
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: udp_reuseport_select
+ *
+ * Description:
+ *   If the connection found for a unicast datagram is a member of a
+ *   SO_REUSEPORT group, select the member that should receive it by a hash
+ *   of the source address and port.  Datagrams of the same flow are always
+ *   delivered to the same socket.  A group bound to the destination
+ *   address of the datagram is preferred to one bound to any address.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure containing the received UDP packet
+ *   conn - The first connection matching the packet
+ *   udp  - A pointer to the UDP header in the packet
+ *
+ * Returned Value:
+ *   The connection that should receive the packet.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_REUSEPORT
+static FAR struct udp_conn_s *
+udp_reuseport_select(FAR struct net_driver_s *dev,
+                     FAR struct udp_conn_s *conn,
+                     FAR struct udp_hdr_s *udp)
+{
+  FAR struct udp_conn_s *first;
+  FAR struct udp_conn_s *next;
+  uint32_t hash;
+  int ngroup = 0;
+
+  /* Connection mode sockets are matched by their peer and never shared */
+
+  if (!udp_reuseport_member(conn))
+    {
+      return conn;
+    }
+
+  /* The group bound to the destination address wins over the wildcard */
+
+  first = conn;
+  if (!udp_reuseport_exact(conn))
+    {
+      for (next = udp_active(dev, conn, udp); next != NULL;
+           next = udp_active(dev, next, udp))
+        {
+          if (!_UDP_ISCONNECTMODE(next->flags) && udp_reuseport_exact(next))
+            {
+              first = next;
+              break;
+            }
+        }
+
+      if (!udp_reuseport_member(first))
+        {
+          return first;
+        }
+    }
+
+  for (next = first; next != NULL; next = udp_active(dev, next, udp))
+    {
+      if (udp_reuseport_member(next) && udp_reuseport_same(next, first))
+        {
+          ngroup++;
+        }
+    }
+
+#ifdef CONFIG_NET_IPv6
+#  ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#  endif
+    {
+      hash = net_flowhash(IPv6BUF->srcipaddr, sizeof(net_ipv6addr_t),
+                          udp->srcport, udp->destport);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#  ifdef CONFIG_NET_IPv6
+  else
+#  endif
+    {
+      hash = net_flowhash(IPv4BUF->srcipaddr, sizeof(in_addr_t),
+                          udp->srcport, udp->destport);
+    }
+#endif
+
+  hash %= ngroup;
+  for (next = first; next != NULL; next = udp_active(dev, next, udp))
+    {
+      if (udp_reuseport_member(next) && udp_reuseport_same(next, first) &&
+          hash-- == 0)
+        {
+          return next;
+        }
+    }
+
+  return first;
+}
+#endif
+
 /****************************************************************************
  * Name: udp_input_conn
  *
@@ -326,6 +496,17 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
             }
 #endif
 
+#ifdef CONFIG_NET_REUSEPORT
+          /* A unicast datagram goes to one member of a SO_REUSEPORT group */
+
+#  ifdef CONFIG_NET_BROADCAST
+          if (!udp_is_broadcast(dev))
+#  endif
+            {
+              conn = udp_reuseport_select(dev, conn, udp);
+            }
+#endif
+
           /* We can deliver the packet directly to the last listener. */
 
           ret = udp_input_conn(dev, conn, udpiplen);
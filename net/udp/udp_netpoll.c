@@ -38,6 +38,7 @@
 #include "netdev/netdev.h"
 #include "socket/socket.h"
 #include "udp/udp.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Private Functions
@@ -85,6 +86,15 @@ static uint16_t udp_poll_eventhandler(FAR struct net_driver_s *dev,
           eventset |= POLLIN;
         }
 
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+      /* A MSG_ZEROCOPY completion is waiting on the error queue */
+
+      if ((flags & NET_ERRQUEUE) != 0)
+        {
+          eventset |= POLLERR;
+        }
+#endif
+
       /* Check for loss of connection events. */
 
       if ((flags & NETDEV_DOWN) != 0)
@@ -192,6 +202,10 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
   cb->priv  = info;
   cb->event = udp_poll_eventhandler;
 
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+  cb->flags |= NET_ERRQUEUE;
+#endif
+
   if ((fds->events & POLLOUT) != 0)
     {
       cb->flags |= UDP_POLL;
@@ -224,6 +238,13 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       eventset |= POLLWRNORM;
     }
 
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+  if (net_zc_pending(&conn->sconn))
+    {
+      eventset |= POLLERR;
+    }
+#endif
+
   /* Check if any requested events are already in effect */
 
   poll_notify(&fds, 1, eventset);
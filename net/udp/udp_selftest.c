@@ -0,0 +1,352 @@
+/****************************************************************************
+ * net/udp/udp_selftest.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <syslog.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <nuttx/kthread.h>
+#include <nuttx/signal.h>
+#include <nuttx/net/net.h>
+
+#include "udp/udp.h"
+
+#ifdef CONFIG_NET_UDP_REUSEPORT_SELFTEST
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The group has UDP_SELFTEST_NMEMBERS members bound to 127.0.0.1 and one
+ * more bound to INADDR_ANY, all on UDP_SELFTEST_PORT.  UDP_SELFTEST_NFLOWS
+ * source ports send to it, one after the other, so that no more than one
+ * sender and one queued datagram exist at any time.
+ */
+
+#define UDP_SELFTEST_NMEMBERS  3
+#define UDP_SELFTEST_WILDCARD  UDP_SELFTEST_NMEMBERS
+#define UDP_SELFTEST_NFLOWS    64
+#define UDP_SELFTEST_PORT      5470
+#define UDP_SELFTEST_SPORT     5500
+
+/* Wait up to one second for a datagram to arrive */
+
+#define UDP_SELFTEST_NPOLLS    100
+#define UDP_SELFTEST_POLLUS    10000
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: udp_selftest_open
+ *
+ * Description:
+ *   Open a UDP socket and bind it to addr:port, setting SO_REUSEPORT first
+ *   if requested.
+ *
+ ****************************************************************************/
+
+static int udp_selftest_open(FAR struct socket *psock, in_addr_t addr,
+                             uint16_t port, bool reuseport)
+{
+  struct sockaddr_in sin;
+  int one = 1;
+  int ret;
+
+  ret = psock_socket(PF_INET, SOCK_DGRAM, 0, psock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (reuseport)
+    {
+      ret = psock_setsockopt(psock, SOL_SOCKET, SO_REUSEPORT,
+                             &one, sizeof(one));
+      if (ret < 0)
+        {
+          goto errout;
+        }
+    }
+
+  memset(&sin, 0, sizeof(sin));
+  sin.sin_family      = AF_INET;
+  sin.sin_port        = HTONS(port);
+  sin.sin_addr.s_addr = addr;
+
+  ret = psock_bind(psock, (FAR const struct sockaddr *)&sin, sizeof(sin));
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  return OK;
+
+errout:
+  psock_close(psock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: udp_selftest_send
+ *
+ * Description:
+ *   Send the one byte datagram 'flow' to the group from source port
+ *   UDP_SELFTEST_SPORT + flow.
+ *
+ ****************************************************************************/
+
+static int udp_selftest_send(uint8_t flow)
+{
+  struct sockaddr_in sin;
+  struct socket sock;
+  ssize_t nsent;
+  int ret;
+
+  ret = udp_selftest_open(&sock, HTONL(INADDR_LOOPBACK),
+                          UDP_SELFTEST_SPORT + flow, false);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  memset(&sin, 0, sizeof(sin));
+  sin.sin_family      = AF_INET;
+  sin.sin_port        = HTONS(UDP_SELFTEST_PORT);
+  sin.sin_addr.s_addr = HTONL(INADDR_LOOPBACK);
+
+  nsent = psock_sendto(&sock, &flow, 1, 0,
+                       (FAR const struct sockaddr *)&sin, sizeof(sin));
+  psock_close(&sock);
+
+  return nsent < 0 ? (int)nsent : OK;
+}
+
+/****************************************************************************
+ * Name: udp_selftest_recv
+ *
+ * Description:
+ *   Wait for the next datagram on any socket of the group.  Returns the
+ *   index of the socket that received it and the flow it carries.
+ *
+ ****************************************************************************/
+
+static int udp_selftest_recv(FAR struct socket *group, FAR uint8_t *flow)
+{
+  ssize_t nrecv;
+  int retry;
+  int i;
+
+  for (retry = 0; retry < UDP_SELFTEST_NPOLLS; retry++)
+    {
+      for (i = 0; i <= UDP_SELFTEST_WILDCARD; i++)
+        {
+          nrecv = psock_recvfrom(&group[i], flow, 1, MSG_DONTWAIT,
+                                 NULL, NULL);
+          if (nrecv == 1)
+            {
+              return i;
+            }
+          else if (nrecv != -EAGAIN)
+            {
+              return nrecv < 0 ? (int)nrecv : -EIO;
+            }
+        }
+
+      nxsig_usleep(UDP_SELFTEST_POLLUS);
+    }
+
+  return -ETIMEDOUT;
+}
+
+/****************************************************************************
+ * Name: udp_selftest_run
+ *
+ * Description:
+ *   Send every flow twice.  The first round records which member receives
+ *   each flow, the second checks that the flow sticks to that member.
+ *
+ ****************************************************************************/
+
+static int udp_selftest_run(FAR struct socket *group)
+{
+  uint8_t owner[UDP_SELFTEST_NFLOWS];
+  int count[UDP_SELFTEST_NMEMBERS];
+  uint8_t flow;
+  int round;
+  int ret;
+  int i;
+
+  memset(count, 0, sizeof(count));
+
+  for (round = 0; round < 2; round++)
+    {
+      for (i = 0; i < UDP_SELFTEST_NFLOWS; i++)
+        {
+          ret = udp_selftest_send(i);
+          if (ret < 0)
+            {
+              nerr("ERROR: flow %d not sent: %d\n", i, ret);
+              return ret;
+            }
+
+          ret = udp_selftest_recv(group, &flow);
+          if (ret < 0 || flow != i)
+            {
+              nerr("ERROR: flow %d not received: %d\n", i, ret);
+              return ret < 0 ? ret : -EIO;
+            }
+
+          if (ret == UDP_SELFTEST_WILDCARD)
+            {
+              nerr("ERROR: flow %d reached the wildcard member\n", i);
+              return -EIO;
+            }
+
+          if (round == 0)
+            {
+              owner[i] = ret;
+              count[ret]++;
+            }
+          else if (owner[i] != ret)
+            {
+              nerr("ERROR: flow %d moved from %d to %d\n",
+                   i, owner[i], ret);
+              return -EIO;
+            }
+        }
+    }
+
+  for (i = 0; i < UDP_SELFTEST_NMEMBERS; i++)
+    {
+      syslog(LOG_INFO, "reuseport selftest: member %d got %d flows\n",
+             i, count[i]);
+      if (count[i] == 0)
+        {
+          nerr("ERROR: member %d received nothing\n", i);
+          return -EIO;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: udp_selftest_main
+ ****************************************************************************/
+
+static int udp_selftest_main(int argc, FAR char *argv[])
+{
+  struct socket group[UDP_SELFTEST_WILDCARD + 1];
+  int nopen;
+  int ret;
+
+  /* Bind the wildcard member first so that it is the first one found by
+   * the input lookup; the exact-address members must still win.
+   */
+
+  ret = udp_selftest_open(&group[UDP_SELFTEST_WILDCARD], HTONL(INADDR_ANY),
+                          UDP_SELFTEST_PORT, true);
+  if (ret < 0)
+    {
+      goto out;
+    }
+
+  for (nopen = 0; nopen < UDP_SELFTEST_NMEMBERS; nopen++)
+    {
+      ret = udp_selftest_open(&group[nopen], HTONL(INADDR_LOOPBACK),
+                              UDP_SELFTEST_PORT, true);
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  if (ret >= 0)
+    {
+      ret = udp_selftest_run(group);
+    }
+
+  while (nopen-- > 0)
+    {
+      psock_close(&group[nopen]);
+    }
+
+  psock_close(&group[UDP_SELFTEST_WILDCARD]);
+
+out:
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "reuseport selftest: FAILED %d\n", ret);
+    }
+  else
+    {
+      syslog(LOG_INFO, "reuseport selftest: PASSED\n");
+    }
+
+  return ret < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: udp_reuseport_selftest
+ *
+ * Description:
+ *   Start a kernel thread that checks, over the loopback device, how
+ *   unicast datagrams are spread among the members of a SO_REUSEPORT
+ *   group.  The thread only runs once the OS is up and the loopback device
+ *   has been registered.
+ *
+ ****************************************************************************/
+
+void udp_reuseport_selftest(void)
+{
+  int pid;
+
+  pid = kthread_create("reuseport_test", SCHED_PRIORITY_DEFAULT,
+                       CONFIG_DEFAULT_TASK_STACKSIZE, udp_selftest_main,
+                       NULL);
+  if (pid < 0)
+    {
+      nerr("ERROR: Failed to start the SO_REUSEPORT self-test: %d\n", pid);
+    }
+}
+
+#endif /* CONFIG_NET_UDP_REUSEPORT_SELFTEST */
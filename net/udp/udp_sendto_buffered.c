@@ -548,6 +548,10 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 {
   FAR struct udp_wrbuffer_s *wrb;
   FAR struct udp_conn_s *conn;
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+  FAR struct net_zcrec_s *zcrec = NULL;
+  FAR struct iob_s *zciob = NULL;
+#endif
   unsigned int timeout;
   uint16_t udpiplen;
   bool nonblock;
@@ -813,31 +817,56 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
       iob_reserve(wrb->wb_iob, CONFIG_NET_LL_GUARDSIZE);
       iob_update_pktlen(wrb->wb_iob, udpiplen, false);
 
-      /* Copy the user data into the write buffer.  We cannot wait for
-       * buffer space if the socket was opened non-blocking.
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+      /* A MSG_ZEROCOPY send chains IOBs that reference the user buffer
+       * after the headers, they are released once the driver has sent the
+       * datagram.
        */
 
-      if (nonblock)
+      if ((flags & MSG_ZEROCOPY) != 0 && len > 0 &&
+          _SO_GETOPT(conn->sconn.s_options, SO_ZEROCOPY))
+        {
+          zcrec = net_zc_begin(&conn->sconn);
+          if (zcrec != NULL)
+            {
+              zciob = net_zc_iobchain(zcrec, buf, len);
+            }
+        }
+
+      if (zciob != NULL)
         {
-          ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf,
-                              len, udpiplen, false);
+          iob_concat(wrb->wb_iob, zciob);
+          ret = OK;
         }
       else
+#endif
         {
-          unsigned int count;
-          int blresult;
-
-          /* iob_copyin might wait for buffers to be freed, but if
-           * network is locked this might never happen, since network
-           * driver is also locked, therefore we need to break the lock
+          /* Copy the user data into the write buffer.  We cannot wait for
+           * buffer space if the socket was opened non-blocking.
            */
 
-          blresult = net_breaklock(&count);
-          ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf,
-                           len, udpiplen, false);
-          if (blresult >= 0)
+          if (nonblock)
+            {
+              ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf,
+                                  len, udpiplen, false);
+            }
+          else
             {
-              net_restorelock(count);
+              unsigned int count;
+              int blresult;
+
+              /* iob_copyin might wait for buffers to be freed, but if
+               * network is locked this might never happen, since network
+               * driver is also locked, therefore we need to break the lock
+               */
+
+              blresult = net_breaklock(&count);
+              ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf,
+                               len, udpiplen, false);
+              if (blresult >= 0)
+                {
+                  net_restorelock(count);
+                }
             }
         }
 
@@ -846,6 +875,16 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
           goto errout_with_wrb;
         }
 
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+      /* The datagram is complete, the IOBs now hold the send */
+
+      if (zcrec != NULL)
+        {
+          net_zc_end(zcrec, true);
+          zcrec = NULL;
+        }
+#endif
+
       /* Dump I/O buffer chain */
 
       UDP_WBDUMP("I/O buffer chain", wrb, wrb->wb_iob->io_pktlen, 0);
@@ -892,6 +931,13 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
   return len;
 
 errout_with_wrb:
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+  if (zcrec != NULL)
+    {
+      net_zc_end(zcrec, false);
+    }
+#endif
+
   udp_wrbuffer_release(wrb);
 
 errout_with_lock:
@@ -305,7 +305,8 @@ int usrsock_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
 
       if (!(conn->flags & USRSOCK_EVENT_RECVFROM_AVAIL))
         {
-          if (_SS_ISNONBLOCK(conn->sconn.s_flags))
+          if (_SS_ISNONBLOCK(conn->sconn.s_flags) ||
+              (flags & SOCK_ACCEPT_DONTWAIT) != 0)
             {
               /* Nothing to receive from daemon side. */
 
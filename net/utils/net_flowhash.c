@@ -0,0 +1,98 @@
+/****************************************************************************
+ * net/utils/net_flowhash.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include "utils/utils.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* 32-bit FNV-1a parameters */
+
+#define FLOWHASH_OFFSET  0x811c9dc5u
+#define FLOWHASH_PRIME   0x01000193u
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline uint32_t net_flowhash_word(uint32_t hash, uint16_t word)
+{
+  hash = (hash ^ (word & 0xff)) * FLOWHASH_PRIME;
+  hash = (hash ^ (word >> 8)) * FLOWHASH_PRIME;
+  return hash;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_flowhash
+ *
+ * Description:
+ *   Compute a hash of a flow identified by the remote address and the
+ *   remote and local port numbers.  The same flow always yields the same
+ *   hash, so the value can be used to steer all packets of a flow to the
+ *   same socket or CPU.
+ *
+ * Input Parameters:
+ *   raddr   - The remote IP address (network order)
+ *   addrlen - Length of the remote address in bytes (4 or 16)
+ *   rport   - The remote port number (network order)
+ *   lport   - The local port number (network order)
+ *
+ * Returned Value:
+ *   The 32-bit flow hash.
+ *
+ ****************************************************************************/
+
+uint32_t net_flowhash(FAR const void *raddr, size_t addrlen,
+                      uint16_t rport, uint16_t lport)
+{
+  FAR const uint16_t *addr = raddr;
+  uint32_t hash = FLOWHASH_OFFSET;
+  size_t i;
+
+  for (i = 0; i < addrlen / sizeof(uint16_t); i++)
+    {
+      hash = net_flowhash_word(hash, addr[i]);
+    }
+
+  hash = net_flowhash_word(hash, rport);
+  hash = net_flowhash_word(hash, lport);
+
+  /* Final avalanche so that the low order bits are usable as an index */
+
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  return hash;
+}
@@ -0,0 +1,258 @@
+/****************************************************************************
+ * net/utils/net_zcselftest.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+#include <syslog.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/net/net.h>
+
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_SEND_ZEROCOPY_SELFTEST
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define ZC_NSENDS 7
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_zc_selftest_read
+ *
+ * Description:
+ *   Read one notification from the error queue and check that it covers
+ *   the ids lo..hi.  If lo is greater than hi, check that the error queue
+ *   is empty instead.
+ *
+ ****************************************************************************/
+
+static int net_zc_selftest_read(FAR struct socket *psock,
+                                uint32_t lo, uint32_t hi)
+{
+  uint8_t control[CMSG_SPACE(sizeof(struct sock_extended_err))];
+  FAR struct socket_conn_s *conn = psock->s_conn;
+  FAR struct sock_extended_err *serr;
+  struct msghdr msg;
+  int ret;
+
+  memset(&msg, 0, sizeof(msg));
+  memset(control, 0, sizeof(control));
+  msg.msg_control    = control;
+  msg.msg_controllen = sizeof(control);
+
+  ret = net_zc_recverr(psock, &msg);
+  if (lo > hi)
+    {
+      if (ret != -EAGAIN || net_zc_pending(conn))
+        {
+          nerr("ERROR: unexpected completion: %d\n", ret);
+          return -EIO;
+        }
+
+      return OK;
+    }
+
+  if (ret < 0)
+    {
+      nerr("ERROR: completion %" PRIu32 "..%" PRIu32 " missing: %d\n",
+           lo, hi, ret);
+      return ret;
+    }
+
+  serr = (FAR struct sock_extended_err *)
+         CMSG_DATA((FAR struct cmsghdr *)control);
+  if (serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY ||
+      serr->ee_info != lo || serr->ee_data != hi)
+    {
+      nerr("ERROR: got %" PRIu32 "..%" PRIu32
+           ", expected %" PRIu32 "..%" PRIu32 "\n",
+           serr->ee_info, serr->ee_data, lo, hi);
+      return -EIO;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: net_zc_selftest_run
+ *
+ * Description:
+ *   Complete the sends of a fake connection out of order and check the
+ *   notifications read back.
+ *
+ ****************************************************************************/
+
+static int net_zc_selftest_run(FAR struct socket *psock,
+                               FAR struct net_zcrec_s **rec)
+{
+  FAR struct socket_conn_s *conn = psock->s_conn;
+  int ret;
+  int i;
+
+  for (i = 0; i < ZC_NSENDS; i++)
+    {
+      rec[i] = net_zc_begin(conn);
+      if (rec[i] == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  /* 1 completes before 0:  it is reported alone, right away */
+
+  net_zc_end(rec[1], true);
+  rec[1] = NULL;
+  ret = net_zc_selftest_read(psock, 1, 1);
+  if (ret >= 0)
+    {
+      ret = net_zc_selftest_read(psock, 1, 0);
+    }
+
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* 2 then 0 complete before the read:  they are not consecutive */
+
+  net_zc_end(rec[2], true);
+  net_zc_end(rec[0], true);
+  rec[2] = NULL;
+  rec[0] = NULL;
+  ret = net_zc_selftest_read(psock, 0, 0);
+  if (ret >= 0)
+    {
+      ret = net_zc_selftest_read(psock, 2, 2);
+    }
+
+  if (ret >= 0)
+    {
+      ret = net_zc_selftest_read(psock, 1, 0);
+    }
+
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* 5, 4 then 3 complete before the read:  one range covers them */
+
+  net_zc_end(rec[5], true);
+  net_zc_end(rec[4], true);
+  net_zc_end(rec[3], true);
+  rec[5] = NULL;
+  rec[4] = NULL;
+  rec[3] = NULL;
+  ret = net_zc_selftest_read(psock, 3, 5);
+  if (ret >= 0)
+    {
+      ret = net_zc_selftest_read(psock, 1, 0);
+    }
+
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* 6 completes and is left unread for net_zc_detach() to drop */
+
+  net_zc_end(rec[6], true);
+  rec[6] = NULL;
+  if (!net_zc_pending(conn))
+    {
+      nerr("ERROR: completion 6 not pending\n");
+      return -EIO;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_zc_selftest
+ *
+ * Description:
+ *   Check the reporting of MSG_ZEROCOPY completions that arrive out of
+ *   order, on a connection that is not attached to any protocol.
+ *
+ ****************************************************************************/
+
+void net_zc_selftest(void)
+{
+  FAR struct net_zcrec_s *rec[ZC_NSENDS];
+  struct socket_conn_s conn;
+  struct socket sock;
+  int ret;
+  int i;
+
+  memset(&conn, 0, sizeof(conn));
+  memset(&sock, 0, sizeof(sock));
+  memset(rec, 0, sizeof(rec));
+  sock.s_domain = PF_INET;
+  sock.s_conn   = &conn;
+
+  ret = net_zc_selftest_run(&sock, rec);
+
+  /* Release the sends the run left behind and detach the connection, so
+   * that nothing refers to it any more.
+   */
+
+  for (i = 0; i < ZC_NSENDS; i++)
+    {
+      if (rec[i] != NULL)
+        {
+          net_zc_end(rec[i], true);
+        }
+    }
+
+  net_zc_detach(&conn);
+
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "zerocopy selftest: FAILED %d\n", ret);
+    }
+  else
+    {
+      syslog(LOG_INFO, "zerocopy selftest: PASSED\n");
+    }
+}
+
+#endif /* CONFIG_NET_SEND_ZEROCOPY_SELFTEST */
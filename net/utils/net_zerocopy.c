@@ -0,0 +1,543 @@
+/****************************************************************************
+ * net/utils/net_zerocopy.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/queue.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+
+#include "devif/devif.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One MSG_ZEROCOPY send.  It is referenced by every IOB that points into
+ * the user buffer, plus one reference held by the sender while the IOBs
+ * are being built.  The send completes when the last reference is gone,
+ * and the record then stays in the s_zcq of the socket, which is sorted by
+ * id, until the completion is read from the error queue.
+ */
+
+struct net_zcrec_s
+{
+  sq_entry_t node;                  /* Entry in the s_zcq of the socket */
+  FAR struct socket_conn_s *conn;   /* Owner, NULL once it is freed */
+  uint32_t   id;                    /* Sequence number of the send */
+  uint16_t   refs;                  /* Outstanding references */
+  bool       copied;                /* The data had to be copied */
+  bool       done;                  /* Completed, not yet reported */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* IOBs may be released from the driver context, so the records and the
+ * completion queues are protected with a spinlock rather than net_lock().
+ */
+
+static spinlock_t g_zc_lock = SP_UNLOCKED;
+
+/* The connections with a new completion, whose pollers are notified with
+ * NET_ERRQUEUE from the work queue:  the IOBs may be freed in interrupt
+ * context, where the callbacks of the connection cannot be run.
+ */
+
+static sq_queue_t g_zc_notifyq;
+static struct work_s g_zc_work;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_zc_release
+ *
+ * Description:
+ *   Drop one reference of a zero-copy send and queue its completion on
+ *   the error queue of the socket when it was the last one.  The sends may
+ *   complete in any order:  the record is only marked as done here and
+ *   net_zc_recverr() reports the runs of consecutive done ids.
+ *
+ * Assumptions:
+ *   g_zc_lock is held.  Returns the record to be freed by the caller
+ *   (outside of the lock), or NULL.
+ *
+ ****************************************************************************/
+
+static FAR struct net_zcrec_s *net_zc_release(FAR struct net_zcrec_s *rec,
+                                              bool report)
+{
+  FAR struct socket_conn_s *conn = rec->conn;
+
+  if (--rec->refs > 0)
+    {
+      return NULL;
+    }
+
+  if (conn == NULL)
+    {
+      return rec;
+    }
+
+  if (!report)
+    {
+      sq_rem(&rec->node, &conn->s_zcq);
+      return rec;
+    }
+
+  rec->done = true;
+  conn->s_zcdone++;
+
+  if (!conn->s_zcnotify)
+    {
+      conn->s_zcnotify = true;
+      sq_addlast(&conn->s_zcnode, &g_zc_notifyq);
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: net_zc_freelist
+ *
+ * Description:
+ *   Free a list of records removed from a socket under g_zc_lock.
+ *
+ ****************************************************************************/
+
+static void net_zc_freelist(FAR sq_queue_t *list)
+{
+  FAR sq_entry_t *node;
+
+  while ((node = sq_remfirst(list)) != NULL)
+    {
+      kmm_free(container_of(node, struct net_zcrec_s, node));
+    }
+}
+
+/****************************************************************************
+ * Name: net_zc_notifyworker
+ *
+ * Description:
+ *   Raise NET_ERRQUEUE on the connections with a new completion, which
+ *   wakes up their pollers with POLLERR.
+ *
+ ****************************************************************************/
+
+static void net_zc_notifyworker(FAR void *arg)
+{
+  FAR struct socket_conn_s *conn;
+  FAR sq_entry_t *node;
+  irqstate_t flags;
+
+  /* net_zc_detach() is called with the network locked, so a connection
+   * removed from the queue stays valid until the lock is released.
+   */
+
+  net_lock();
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&g_zc_lock);
+      node  = sq_remfirst(&g_zc_notifyq);
+      if (node != NULL)
+        {
+          conn = container_of(node, struct socket_conn_s, s_zcnode);
+          conn->s_zcnotify = false;
+        }
+
+      spin_unlock_irqrestore(&g_zc_lock, flags);
+
+      if (node == NULL)
+        {
+          break;
+        }
+
+      devif_conn_event(NULL, NET_ERRQUEUE, conn->list);
+    }
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: net_zc_notify
+ *
+ * Description:
+ *   Schedule the notification of the new completions, if any.
+ *
+ ****************************************************************************/
+
+static void net_zc_notify(void)
+{
+  if (!sq_empty(&g_zc_notifyq) && work_available(&g_zc_work))
+    {
+      work_queue(LPWORK, &g_zc_work, net_zc_notifyworker, NULL, 0);
+    }
+}
+
+/****************************************************************************
+ * Name: net_zc_iobfree
+ *
+ * Description:
+ *   The io_free callback of the IOBs that point into a user buffer.
+ *
+ ****************************************************************************/
+
+static void net_zc_iobfree(FAR void *arg)
+{
+  FAR struct net_zcrec_s *rec = arg;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_zc_lock);
+  rec = net_zc_release(rec, true);
+  spin_unlock_irqrestore(&g_zc_lock, flags);
+
+  net_zc_notify();
+  if (rec != NULL)
+    {
+      kmm_free(rec);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_zc_begin
+ *
+ * Description:
+ *   Start a MSG_ZEROCOPY send on a connection.
+ *
+ * Input Parameters:
+ *   conn - The connection that sends the data
+ *
+ * Returned Value:
+ *   The record of the send, or NULL if it could not be allocated, in which
+ *   case the data has to be copied as usual.
+ *
+ ****************************************************************************/
+
+FAR struct net_zcrec_s *net_zc_begin(FAR struct socket_conn_s *conn)
+{
+  FAR struct net_zcrec_s *rec;
+  irqstate_t flags;
+
+  rec = kmm_zalloc(sizeof(struct net_zcrec_s));
+  if (rec == NULL)
+    {
+      return NULL;
+    }
+
+  rec->conn = conn;
+  rec->refs = 1;
+
+  flags = spin_lock_irqsave(&g_zc_lock);
+  rec->id = conn->s_zcnext++;
+  sq_addlast(&rec->node, &conn->s_zcq);
+  spin_unlock_irqrestore(&g_zc_lock, flags);
+
+  return rec;
+}
+
+/****************************************************************************
+ * Name: net_zc_iobchain
+ *
+ * Description:
+ *   Build an IOB chain that references the user data instead of copying
+ *   it.  Each IOB of the chain holds a reference to the send.
+ *
+ * Input Parameters:
+ *   rec - The record returned by net_zc_begin()
+ *   buf - The user data
+ *   len - The length of the user data
+ *
+ * Returned Value:
+ *   The IOB chain with io_pktlen set to len, or NULL on allocation failure.
+ *   The send is then flagged as copied and the caller falls back to
+ *   iob_copyin().
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *net_zc_iobchain(FAR struct net_zcrec_s *rec,
+                                  FAR const void *buf, size_t len)
+{
+  FAR const uint8_t *data = buf;
+  FAR struct iob_s *head = NULL;
+  FAR struct iob_s *tail = NULL;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  uint16_t chunk;
+
+  while (len > 0)
+    {
+      chunk = len > UINT16_MAX ? UINT16_MAX : len;
+      iob   = iob_alloc_with_data((FAR void *)data, chunk, net_zc_iobfree);
+      if (iob == NULL)
+        {
+          rec->copied = true;
+          if (head != NULL)
+            {
+              iob_free_chain(head);
+            }
+
+          return NULL;
+        }
+
+      flags = spin_lock_irqsave(&g_zc_lock);
+      rec->refs++;
+      spin_unlock_irqrestore(&g_zc_lock, flags);
+
+      iob->io_freearg = rec;
+      iob->io_len     = chunk;
+
+      if (head == NULL)
+        {
+          head = iob;
+        }
+      else
+        {
+          tail->io_flink = iob;
+        }
+
+      head->io_pktlen += chunk;
+      tail  = iob;
+      data += chunk;
+      len  -= chunk;
+    }
+
+  return head;
+}
+
+/****************************************************************************
+ * Name: net_zc_end
+ *
+ * Description:
+ *   Drop the reference of the sender once all the IOBs of a send are
+ *   queued.
+ *
+ * Input Parameters:
+ *   rec    - The record returned by net_zc_begin()
+ *   queued - False if the send failed without queueing any data, the id is
+ *            then given back and nothing is reported.
+ *
+ ****************************************************************************/
+
+void net_zc_end(FAR struct net_zcrec_s *rec, bool queued)
+{
+  FAR struct socket_conn_s *conn;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_zc_lock);
+
+  conn = rec->conn;
+  if (!queued && rec->refs == 1 && conn != NULL &&
+      conn->s_zcnext == rec->id + 1)
+    {
+      conn->s_zcnext--;
+    }
+  else
+    {
+      queued = true;
+    }
+
+  rec = net_zc_release(rec, queued);
+  spin_unlock_irqrestore(&g_zc_lock, flags);
+
+  net_zc_notify();
+  if (rec != NULL)
+    {
+      kmm_free(rec);
+    }
+}
+
+/****************************************************************************
+ * Name: net_zc_detach
+ *
+ * Description:
+ *   Detach the pending zero-copy sends from a connection that is being
+ *   freed.  They complete silently, and the completions not yet reported
+ *   are dropped.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void net_zc_detach(FAR struct socket_conn_s *conn)
+{
+  FAR struct net_zcrec_s *rec;
+  sq_queue_t done;
+  irqstate_t flags;
+
+  sq_init(&done);
+
+  flags = spin_lock_irqsave(&g_zc_lock);
+  while ((rec = (FAR struct net_zcrec_s *)sq_remfirst(&conn->s_zcq))
+         != NULL)
+    {
+      if (rec->done)
+        {
+          sq_addlast(&rec->node, &done);
+        }
+      else
+        {
+          rec->conn = NULL;
+        }
+    }
+
+  if (conn->s_zcnotify)
+    {
+      sq_rem(&conn->s_zcnode, &g_zc_notifyq);
+      conn->s_zcnotify = false;
+    }
+
+  conn->s_zcdone = 0;
+  spin_unlock_irqrestore(&g_zc_lock, flags);
+
+  net_zc_freelist(&done);
+}
+
+/****************************************************************************
+ * Name: net_zc_recverr
+ *
+ * Description:
+ *   Read the completed zero-copy sends from the error queue of a socket,
+ *   i.e. recvmsg(MSG_ERRQUEUE).  As on Linux, one notification covers the
+ *   inclusive range of ids ee_info..ee_data, so a run of consecutive
+ *   completions is reported at once, starting from the lowest id.  A send
+ *   that completes after a later one is reported in its own notification.
+ *
+ * Input Parameters:
+ *   psock - The socket
+ *   msg   - Receives the IP_RECVERR/IPV6_RECVERR control message
+ *
+ * Returned Value:
+ *   Zero (no data) on success; -EAGAIN if no completion is pending;
+ *   -EINVAL if msg_control is too small.
+ *
+ ****************************************************************************/
+
+int net_zc_recverr(FAR struct socket *psock, FAR struct msghdr *msg)
+{
+  FAR struct socket_conn_s *conn = psock->s_conn;
+  FAR struct net_zcrec_s *next;
+  FAR struct net_zcrec_s *rec;
+  struct sock_extended_err serr;
+  sq_queue_t done;
+  irqstate_t flags;
+  int level = IPPROTO_IP;
+  int type = IP_RECVERR;
+
+#ifdef CONFIG_NET_IPv6
+  if (psock->s_domain == PF_INET6)
+    {
+      level = IPPROTO_IPV6;
+      type  = IPV6_RECVERR;
+    }
+#endif
+
+  if (conn == NULL)
+    {
+      return -EAGAIN;
+    }
+
+  memset(&serr, 0, sizeof(serr));
+  serr.ee_origin = SO_EE_ORIGIN_ZEROCOPY;
+  sq_init(&done);
+
+  flags = spin_lock_irqsave(&g_zc_lock);
+  if (!net_zc_pending(conn))
+    {
+      spin_unlock_irqrestore(&g_zc_lock, flags);
+      return -EAGAIN;
+    }
+
+  if (msg->msg_controllen < CMSG_SPACE(sizeof(serr)))
+    {
+      spin_unlock_irqrestore(&g_zc_lock, flags);
+      return -EINVAL;
+    }
+
+  /* Find the first done send, then take the done sends that follow it
+   * with consecutive ids.  The queue is sorted by id.
+   */
+
+  rec = (FAR struct net_zcrec_s *)sq_peek(&conn->s_zcq);
+  while (!rec->done)
+    {
+      rec = (FAR struct net_zcrec_s *)sq_next(&rec->node);
+    }
+
+  serr.ee_info = rec->id;
+  for (; ; )
+    {
+      next = (FAR struct net_zcrec_s *)sq_next(&rec->node);
+
+      serr.ee_data = rec->id;
+      if (rec->copied)
+        {
+          serr.ee_code = SO_EE_CODE_ZEROCOPY_COPIED;
+        }
+
+      sq_rem(&rec->node, &conn->s_zcq);
+      sq_addlast(&rec->node, &done);
+      conn->s_zcdone--;
+
+      if (next == NULL || !next->done || next->id != rec->id + 1)
+        {
+          break;
+        }
+
+      rec = next;
+    }
+
+  spin_unlock_irqrestore(&g_zc_lock, flags);
+
+  net_zc_freelist(&done);
+
+  cmsg_append(msg, level, type, &serr, sizeof(serr));
+  msg->msg_flags |= MSG_ERRQUEUE;
+  return 0;
+}
+
+#endif /* CONFIG_NET_SEND_ZEROCOPY */
@@ -350,6 +350,27 @@ void net_ipv6_pref2mask(net_ipv6addr_t mask, uint8_t preflen);
 FAR void *net_ipv6_payload(FAR struct ipv6_hdr_s *ipv6, FAR uint8_t *proto);
 #endif
 
+/****************************************************************************
+ * Name: net_flowhash
+ *
+ * Description:
+ *   Compute a hash of a flow identified by the remote address and the
+ *   remote and local port numbers.
+ *
+ * Input Parameters:
+ *   raddr   - The remote IP address (network order)
+ *   addrlen - Length of the remote address in bytes (4 or 16)
+ *   rport   - The remote port number (network order)
+ *   lport   - The local port number (network order)
+ *
+ * Returned Value:
+ *   The 32-bit flow hash.
+ *
+ ****************************************************************************/
+
+uint32_t net_flowhash(FAR const void *raddr, size_t addrlen,
+                      uint16_t rport, uint16_t lport);
+
 /****************************************************************************
  * Name: net_iob_concat
  *
@@ -561,6 +582,71 @@ uint16_t icmpv6_chksum(FAR struct net_driver_s *dev, unsigned int iplen);
 FAR void *cmsg_append(FAR struct msghdr *msg, int level, int type,
                       FAR void *value, int value_len);
 
+/****************************************************************************
+ * Name: net_zc_begin, net_zc_iobchain, net_zc_end
+ *
+ * Description:
+ *   Support of MSG_ZEROCOPY sends.  net_zc_begin() numbers a new send,
+ *   net_zc_iobchain() wraps the user data in IOBs that reference it and
+ *   net_zc_end() is called once the IOBs of the send are queued.  The send
+ *   completes when the last of its IOBs is freed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SEND_ZEROCOPY
+struct net_zcrec_s;
+struct socket;
+
+FAR struct net_zcrec_s *net_zc_begin(FAR struct socket_conn_s *conn);
+FAR struct iob_s *net_zc_iobchain(FAR struct net_zcrec_s *rec,
+                                  FAR const void *buf, size_t len);
+void net_zc_end(FAR struct net_zcrec_s *rec, bool queued);
+
+/****************************************************************************
+ * Name: net_zc_detach
+ *
+ * Description:
+ *   Detach the pending zero-copy sends from a connection being freed.
+ *
+ ****************************************************************************/
+
+void net_zc_detach(FAR struct socket_conn_s *conn);
+
+/****************************************************************************
+ * Name: net_zc_pending
+ *
+ * Description:
+ *   True if a completion is waiting on the error queue of a connection.
+ *
+ ****************************************************************************/
+
+#define net_zc_pending(conn) ((conn)->s_zcdone != 0)
+
+/****************************************************************************
+ * Name: net_zc_recverr
+ *
+ * Description:
+ *   Report the completed zero-copy sends, i.e. recvmsg(MSG_ERRQUEUE).
+ *   Returns zero on success or -EAGAIN if nothing completed.
+ *
+ ****************************************************************************/
+
+int net_zc_recverr(FAR struct socket *psock, FAR struct msghdr *msg);
+
+/****************************************************************************
+ * Name: net_zc_selftest
+ *
+ * Description:
+ *   Check the reporting of completions that arrive out of order and write
+ *   the result to the syslog.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SEND_ZEROCOPY_SELFTEST
+void net_zc_selftest(void);
+#endif
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -48,6 +48,20 @@
  ****************************************************************************/
 
 #if CONFIG_SCHED_CRITMONITOR_MAXTIME_THREAD >= 0
+static clock_t clock_thread_runtime(FAR struct tcb_s *tcb)
+{
+  irqstate_t flags;
+  clock_t runtime;
+
+  /* The time run since the thread was last resumed counts as well */
+
+  flags   = enter_critical_section();
+  runtime = nxsched_critmon_runtime(tcb);
+  leave_critical_section(flags);
+
+  return runtime;
+}
+
 static clock_t clock_process_runtime(FAR struct tcb_s *tcb)
 {
 # ifdef HAVE_GROUP_MEMBERS
@@ -58,18 +72,18 @@ static clock_t clock_process_runtime(FAR struct tcb_s *tcb)
 
   group = tcb->group;
 
-  flags = spin_lock_irqsave(NULL);
+  flags = enter_critical_section();
   sq_for_every(&group->tg_members, curr)
     {
       tcb = container_of(curr, struct tcb_s, member);
 
-      runtime += tcb->run_time;
+      runtime += nxsched_critmon_runtime(tcb);
     }
 
-  spin_unlock_irqrestore(NULL, flags);
+  leave_critical_section(flags);
   return runtime;
 # else  /* HAVE_GROUP_MEMBERS */
-  return tcb->run_time;
+  return clock_thread_runtime(tcb);
 # endif /* HAVE_GROUP_MEMBERS */
 }
 #endif
@@ -140,7 +154,7 @@ void nxclock_gettime(clockid_t clock_id, FAR struct timespec *tp)
             }
           else if (clock_type == CLOCK_THREAD_CPUTIME_ID)
             {
-              up_perf_convert(tcb->run_time, tp);
+              up_perf_convert(clock_thread_runtime(tcb), tp);
             }
         }
 #endif
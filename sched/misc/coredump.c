@@ -78,7 +78,9 @@ struct elf_dumpinfo_s
 
 static uint8_t g_running_regs[XCPTCONTEXT_SIZE] aligned_data(16);
 
-#ifdef CONFIG_BOARD_COREDUMP_COMPRESSION
+#ifdef CONFIG_BOARD_COREDUMP_COMPRESSION_LZ4
+static struct lib_lz4outstream_s  g_lz4stream;
+#elif defined(CONFIG_BOARD_COREDUMP_COMPRESSION)
 static struct lib_lzfoutstream_s  g_lzfstream;
 #endif
 
@@ -652,7 +654,13 @@ static void coredump_dump_syslog(pid_t pid)
   streamname = "hex";
 #endif
 
-#  ifdef CONFIG_BOARD_COREDUMP_COMPRESSION
+#  ifdef CONFIG_BOARD_COREDUMP_COMPRESSION_LZ4
+
+  /* Initialize LZ4 compression stream */
+
+  lib_lz4outstream(&g_lz4stream, stream);
+  stream = &g_lz4stream;
+#  elif defined(CONFIG_BOARD_COREDUMP_COMPRESSION)
 
   /* Initialize LZF compression stream */
 
@@ -696,7 +704,10 @@ static void coredump_dump_dev(pid_t pid)
       return;
     }
 
-#ifdef CONFIG_BOARD_COREDUMP_COMPRESSION
+#ifdef CONFIG_BOARD_COREDUMP_COMPRESSION_LZ4
+  lib_lz4outstream(&g_lz4stream, stream);
+  stream = &g_lz4stream;
+#elif defined(CONFIG_BOARD_COREDUMP_COMPRESSION)
   lib_lzfoutstream(&g_lzfstream, stream);
   stream = &g_lzfstream;
 #endif
@@ -78,6 +78,10 @@ struct list_node g_msgfree;
 
 struct list_node g_msgfreeirq;
 
+/* The g_msgfreelock protects the free lists */
+
+spinlock_t g_msgfreelock = SP_UNLOCKED;
+
 #endif
 
 /****************************************************************************
@@ -48,6 +48,7 @@
  *   allocated dynamically it will be deallocated.
  *
  * Input Parameters:
+ *   msgq  - The message queue the message was sent to
  *   mqmsg - message to free
  *
  * Returned Value:
@@ -55,7 +56,8 @@
  *
  ****************************************************************************/
 
-void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
+void nxmq_free_msg(FAR struct mqueue_inode_s *msgq,
+                   FAR struct mqueue_msg_s *mqmsg)
 {
   irqstate_t flags;
 
@@ -69,9 +71,9 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
        * list from interrupt handlers.
        */
 
-      flags = spin_lock_irqsave(NULL);
+      flags = spin_lock_irqsave(&g_msgfreelock);
       list_add_tail(&g_msgfree, &mqmsg->node);
-      spin_unlock_irqrestore(NULL, flags);
+      spin_unlock_irqrestore(&g_msgfreelock, flags);
     }
 
   /* If this is a message pre-allocated for interrupts,
@@ -84,9 +86,9 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
        * list from interrupt handlers.
        */
 
-      flags = spin_lock_irqsave(NULL);
+      flags = spin_lock_irqsave(&g_msgfreelock);
       list_add_tail(&g_msgfreeirq, &mqmsg->node);
-      spin_unlock_irqrestore(NULL, flags);
+      spin_unlock_irqrestore(&g_msgfreelock, flags);
     }
 
   /* Otherwise, deallocate it.  Note:  interrupt handlers
@@ -98,6 +100,21 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
     {
       kmm_free(mqmsg);
     }
+
+#ifdef CONFIG_MQ_PERQUEUE_MSGS
+  /* A message pre-allocated with the message queue goes back to the free
+   * list of the queue.
+   */
+
+  else if (mqmsg->type == MQ_ALLOC_QUEUE)
+    {
+      DEBUGASSERT(msgq != NULL);
+
+      flags = spin_lock_irqsave(&msgq->freelock);
+      list_add_head(&msgq->msgfree, &mqmsg->node);
+      spin_unlock_irqrestore(&msgq->freelock, flags);
+    }
+#endif
   else
     {
       DEBUGPANIC();
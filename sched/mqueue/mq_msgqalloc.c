@@ -68,6 +68,14 @@ int nxmq_alloc_msgq(FAR struct mq_attr *attr,
                     FAR struct mqueue_inode_s **pmsgq)
 {
   FAR struct mqueue_inode_s *msgq;
+  int16_t maxmsgs    = MQ_MAX_MSGS;
+  int16_t maxmsgsize = MQ_MAX_BYTES;
+  size_t size        = sizeof(struct mqueue_inode_s);
+#ifdef CONFIG_MQ_PERQUEUE_MSGS
+  FAR struct mqueue_msg_s *mqmsg;
+  FAR uint8_t *pool;
+  int i;
+#endif
 
   /* Check if the caller is attempting to allocate a message for messages
    * larger than the configured maximum message size.
@@ -79,26 +87,47 @@ int nxmq_alloc_msgq(FAR struct mq_attr *attr,
       return -EINVAL;
     }
 
+  if (attr)
+    {
+      maxmsgs    = (int16_t)attr->mq_maxmsg;
+      maxmsgsize = (int16_t)attr->mq_msgsize;
+    }
+
+#ifdef CONFIG_MQ_PERQUEUE_MSGS
+  /* The messages of the queue follow the queue structure */
+
+  size = ALIGN_UP(size, sizeof(uintptr_t)) +
+         maxmsgs * MQ_MSG_STRIDE(maxmsgsize);
+#endif
+
   /* Allocate memory for the new message queue. */
 
-  msgq = (FAR struct mqueue_inode_s *)
-    kmm_zalloc(sizeof(struct mqueue_inode_s));
+  msgq = (FAR struct mqueue_inode_s *)kmm_zalloc(size);
 
   if (msgq)
     {
       /* Initialize the new named message queue */
 
       list_initialize(&msgq->msglist);
-      if (attr)
-        {
-          msgq->maxmsgs    = (int16_t)attr->mq_maxmsg;
-          msgq->maxmsgsize = (int16_t)attr->mq_msgsize;
-        }
-      else
+      msgq->maxmsgs    = maxmsgs;
+      msgq->maxmsgsize = maxmsgsize;
+
+#ifdef CONFIG_MQ_PERQUEUE_MSGS
+      list_initialize(&msgq->msgfree);
+      spin_lock_init(&msgq->freelock);
+
+      pool = (FAR uint8_t *)msgq +
+             ALIGN_UP(sizeof(struct mqueue_inode_s), sizeof(uintptr_t));
+
+      for (i = 0; i < maxmsgs; i++)
         {
-          msgq->maxmsgs    = MQ_MAX_MSGS;
-          msgq->maxmsgsize = MQ_MAX_BYTES;
+          mqmsg       = (FAR struct mqueue_msg_s *)pool;
+          mqmsg->type = MQ_ALLOC_QUEUE;
+          mqmsg->msgq = msgq;
+          list_add_tail(&msgq->msgfree, &mqmsg->node);
+          pool       += MQ_MSG_STRIDE(maxmsgsize);
         }
+#endif
 
 #ifndef CONFIG_DISABLE_MQUEUE_NOTIFICATION
       msgq->ntpid = INVALID_PROCESS_ID;
@@ -112,8 +112,9 @@ static void nxmq_rcvtimeout(wdparm_t arg)
  *             message is received.
  *
  * Returned Value:
- *   On success, zero (OK) is returned.  A negated errno value is returned
- *   on any failure.
+ *   On success, zero (OK) is returned if the message was taken from the
+ *   queue, or one if it was handed over by the sender and never queued.
+ *   A negated errno value is returned on any failure.
  *
  * Assumptions:
  * - The caller has provided all validity checking of the input parameters
@@ -131,6 +132,7 @@ int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
 {
   FAR struct mqueue_msg_s *newmsg;
   FAR struct tcb_s *rtcb = this_task();
+  int ret = OK;
 
 #ifdef CONFIG_CANCELLATION_POINTS
   /* nxmq_wait_receive() is not a cancellation point, but it may be called
@@ -160,8 +162,7 @@ int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
 
   /* Get the message from the head of the queue */
 
-  while ((newmsg = (FAR struct mqueue_msg_s *)
-                   list_remove_head(&msgq->msglist)) == NULL)
+  while ((newmsg = nxmq_remove_queue(msgq)) == NULL)
     {
       msgq->cmn.nwaitnotempty++;
 
@@ -188,11 +189,21 @@ int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
       /* When we resume at this point, either (1) the message queue
        * is no longer empty, or (2) the wait has been interrupted by
        * a signal.  We can detect the latter case be examining the
-       * errno value (should be either EINTR or ETIMEDOUT).
+       * errno value (should be either EINTR or ETIMEDOUT).  The sender
+       * may also have handed its message over in the waitobj.
        */
 
+      if (rtcb->waitobj != NULL)
+        {
+          newmsg        = rtcb->waitobj;
+          rtcb->waitobj = NULL;
+          ret           = 1;
+          break;
+        }
+
       if (rtcb->errcode != OK)
         {
+          ret = -rtcb->errcode;
           break;
         }
     }
@@ -203,7 +214,45 @@ int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
     }
 
   *rcvmsg = newmsg;
-  return -rtcb->errcode;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nxmq_remove_queue
+ *
+ * Description:
+ *   Remove the highest priority message from the message queue.
+ *
+ * Input Parameters:
+ *   msgq    - Message queue descriptor
+ *
+ * Returned Value:
+ *   The message, or NULL if the queue is empty.
+ *
+ * Assumptions:
+ * - Interrupts should be disabled throughout this call.
+ *
+ ****************************************************************************/
+
+FAR struct mqueue_msg_s *nxmq_remove_queue(FAR struct mqueue_inode_s *msgq)
+{
+  FAR struct mqueue_msg_s *mqmsg;
+
+  mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&msgq->msglist);
+
+#ifdef CONFIG_MQ_PRIO_BUCKETS
+  /* The last message of its priority leaves the index */
+
+  if (mqmsg != NULL && msgq->priotail[mqmsg->priority] == &mqmsg->node)
+    {
+      unsigned int prio = mqmsg->priority;
+
+      msgq->priotail[prio] = NULL;
+      msgq->prioset[prio >> 5] &= ~(UINT32_C(1) << (prio & 31));
+    }
+#endif
+
+  return mqmsg;
 }
 
 /****************************************************************************
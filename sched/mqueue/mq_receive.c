@@ -181,7 +181,7 @@ ssize_t file_mq_timedreceive_internal(FAR struct file *mq, FAR char *msg,
 
   /* Get the message from the message queue */
 
-  mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&msgq->msglist);
+  mqmsg = nxmq_remove_queue(msgq);
   if (mqmsg == NULL)
     {
       if ((mq->f_oflags & O_NONBLOCK) != 0)
@@ -200,18 +200,22 @@ ssize_t file_mq_timedreceive_internal(FAR struct file *mq, FAR char *msg,
         }
     }
 
-  /* If we got message, then decrement the number of messages in
-   * the queue while we are still in the critical section
+  /* If we got message from the queue, then decrement the number of
+   * messages in the queue while we are still in the critical section.  A
+   * message handed over by the sender was never counted.
    */
 
-  if (msgq->nmsgs-- == msgq->maxmsgs)
+  if (ret == OK)
     {
-      nxmq_pollnotify(msgq, POLLOUT);
-    }
+      if (msgq->nmsgs-- == msgq->maxmsgs)
+        {
+          nxmq_pollnotify(msgq, POLLOUT);
+        }
 
-  /* Notify all threads waiting for a message in the message queue */
+      /* Notify all threads waiting for a message in the message queue */
 
-  nxmq_notify_receive(msgq);
+      nxmq_notify_receive(msgq);
+    }
 
   leave_critical_section(flags);
 
@@ -227,7 +231,7 @@ ssize_t file_mq_timedreceive_internal(FAR struct file *mq, FAR char *msg,
 
   /* Free the message structure */
 
-  nxmq_free_msg(mqmsg);
+  nxmq_free_msg(msgq, mqmsg);
 
   return ret;
 }
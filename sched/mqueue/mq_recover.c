@@ -86,4 +86,28 @@ void nxmq_recover(FAR struct tcb_s *tcb)
       DEBUGASSERT(msgq && msgq->cmn.nwaitnotfull > 0);
       msgq->cmn.nwaitnotfull--;
     }
+
+#ifndef CONFIG_DISABLE_MQUEUE
+  /* Was a message handed over to the task that it did not take yet?  A
+   * message pre-allocated with a message queue goes back to the free list
+   * of that queue, or its slot would be lost for good.
+   */
+
+  else if (tcb->waitobj != NULL && tcb->task_state != TSTATE_WAIT_SEM)
+    {
+      FAR struct mqueue_msg_s *mqmsg = tcb->waitobj;
+
+      tcb->waitobj = NULL;
+#ifdef CONFIG_MQ_PERQUEUE_MSGS
+      if (mqmsg->type == MQ_ALLOC_QUEUE)
+        {
+          nxmq_free_msg(mqmsg->msgq, mqmsg);
+        }
+      else
+#endif
+        {
+          nxmq_free_msg(NULL, mqmsg);
+        }
+    }
+#endif
 }
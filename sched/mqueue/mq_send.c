@@ -110,7 +110,8 @@ static int nxmq_verify_send(FAR FAR struct file *mq, FAR const char *msg,
  *
  * Description:
  *   The nxmq_alloc_msg function will get a free message for use by the
- *   operating system.  The message will be allocated from the g_msgfree
+ *   operating system.  The message will be allocated from the messages
+ *   pre-allocated with the message queue, if any, then from the g_msgfree
  *   list.
  *
  *   If the list is empty AND the message is NOT being allocated from the
@@ -124,7 +125,8 @@ static int nxmq_verify_send(FAR FAR struct file *mq, FAR const char *msg,
  *   handler will be notified.
  *
  * Input Parameters:
- *   None
+ *   msgq    - Message queue descriptor
+ *   msgsize - The length of the message in bytes
  *
  * Returned Value:
  *   A reference to the allocated msg structure.  On a failure to allocate,
@@ -132,16 +134,29 @@ static int nxmq_verify_send(FAR FAR struct file *mq, FAR const char *msg,
  *
  ****************************************************************************/
 
-static FAR struct mqueue_msg_s *nxmq_alloc_msg(uint16_t msgsize)
+static FAR struct mqueue_msg_s *
+nxmq_alloc_msg(FAR struct mqueue_inode_s *msgq, uint16_t msgsize)
 {
   FAR struct mqueue_msg_s *mqmsg;
   irqstate_t flags;
 
+#ifdef CONFIG_MQ_PERQUEUE_MSGS
+  /* Try to get the message from the messages of the queue */
+
+  flags = spin_lock_irqsave(&msgq->freelock);
+  mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&msgq->msgfree);
+  spin_unlock_irqrestore(&msgq->freelock, flags);
+  if (mqmsg != NULL)
+    {
+      return mqmsg;
+    }
+#endif
+
   /* Try to get the message from the generally available free list. */
 
-  flags = spin_lock_irqsave(NULL);
+  flags = spin_lock_irqsave(&g_msgfreelock);
   mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&g_msgfree);
-  spin_unlock_irqrestore(NULL, flags);
+  spin_unlock_irqrestore(&g_msgfreelock, flags);
   if (mqmsg == NULL)
     {
       /* If we were called from an interrupt handler, then try to get the
@@ -153,9 +168,9 @@ static FAR struct mqueue_msg_s *nxmq_alloc_msg(uint16_t msgsize)
         {
           /* Try the free list reserved for interrupt handlers */
 
-          flags = spin_lock_irqsave(NULL);
+          flags = spin_lock_irqsave(&g_msgfreelock);
           mqmsg = (FAR struct mqueue_msg_s *)list_remove_head(&g_msgfreeirq);
-          spin_unlock_irqrestore(NULL, flags);
+          spin_unlock_irqrestore(&g_msgfreelock, flags);
         }
 
       /* We were not called from an interrupt handler. */
@@ -184,61 +199,6 @@ static FAR struct mqueue_msg_s *nxmq_alloc_msg(uint16_t msgsize)
   return mqmsg;
 }
 
-/****************************************************************************
- * Name: nxmq_add_queue
- *
- * Description:
- *   This is internal, common logic shared by both [nx]mq_send and
- *   [nx]mq_timesend.  This function adds the specified message (msg) to the
- *   message queue (msgq).  Then it notifies any tasks that were waiting
- *   for message queue notifications setup by mq_notify.  And, finally, it
- *   awakens any tasks that were waiting for the message not empty event.
- *
- * Input Parameters:
- *   msgq   - Message queue descriptor
- *   msg    - Message to send
- *
- * Returned Value:
- *   This function always returns OK.
- *
- ****************************************************************************/
-
-static void nxmq_add_queue(FAR struct mqueue_inode_s *msgq,
-                           FAR struct mqueue_msg_s *mqmsg,
-                           unsigned int prio)
-{
-  FAR struct mqueue_msg_s *prev = NULL;
-  FAR struct mqueue_msg_s *next;
-
-  /* Insert the new message in the message queue
-   * Search the message list to find the location to insert the new
-   * message. Each is list is maintained in ascending priority order.
-   */
-
-  list_for_every_entry(&msgq->msglist, next, struct mqueue_msg_s, node)
-    {
-      if (prio > next->priority)
-        {
-          break;
-        }
-      else
-        {
-          prev = next;
-        }
-    }
-
-  /* Add the message at the right place */
-
-  if (prev)
-    {
-      list_add_after(&prev->node, &mqmsg->node);
-    }
-  else
-    {
-      list_add_head(&msgq->msglist, &mqmsg->node);
-    }
-}
-
 /****************************************************************************
  * Name: file_mq_timedsend_internal
  *
@@ -308,7 +268,7 @@ int file_mq_timedsend_internal(FAR struct file *mq, FAR const char *msg,
 
   /* Pre-allocate a message structure */
 
-  mqmsg = nxmq_alloc_msg(msglen);
+  mqmsg = nxmq_alloc_msg(msgq, msglen);
   if (!mqmsg)
     {
       return -ENOMEM;
@@ -343,9 +303,16 @@ int file_mq_timedsend_internal(FAR struct file *mq, FAR const char *msg,
         }
     }
 
+  /* If a task is waiting for the empty queue, give it the message */
+
+  if (nxmq_handoff_send(msgq, mqmsg))
+    {
+      goto out;
+    }
+
   /* Add the message to the message queue */
 
-  nxmq_add_queue(msgq, mqmsg, prio);
+  nxmq_add_queue(msgq, mqmsg);
 
   /* Increment the count of messages in the queue */
 
@@ -363,7 +330,7 @@ out:
 
   if (ret < 0)
     {
-      nxmq_free_msg(mqmsg);
+      nxmq_free_msg(msgq, mqmsg);
     }
 
   return ret;
@@ -31,6 +31,7 @@
 #include <fcntl.h>
 #include <mqueue.h>
 #include <string.h>
+#include <strings.h>
 #include <assert.h>
 #include <errno.h>
 #include <sched.h>
@@ -92,6 +93,86 @@ static void nxmq_sndtimeout(wdparm_t arg)
   leave_critical_section(flags);
 }
 
+/****************************************************************************
+ * Name: nxmq_prio_lowest
+ *
+ * Description:
+ *   Return the lowest priority of the messages in the queue that is
+ *   greater than or equal to 'prio', or -1 if there is none.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MQ_PRIO_BUCKETS
+static int nxmq_prio_lowest(FAR struct mqueue_inode_s *msgq,
+                            unsigned int prio)
+{
+  int word = prio >> 5;
+  uint32_t bits = msgq->prioset[word] & (UINT32_MAX << (prio & 31));
+
+  while (bits == 0)
+    {
+      if (++word >= MQ_PRIO_NWORDS)
+        {
+          return -1;
+        }
+
+      bits = msgq->prioset[word];
+    }
+
+  return (word << 5) + ffs((int)bits) - 1;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxmq_unblock_receiver
+ *
+ * Description:
+ *   Wake up the highest priority task waiting for the message queue to
+ *   become non-empty.  'mqmsg' is left in the waitobj of the task, it is
+ *   NULL if the task has to take a message from the queue by itself.
+ *
+ ****************************************************************************/
+
+static void nxmq_unblock_receiver(FAR struct mqueue_inode_s *msgq,
+                                  FAR struct mqueue_msg_s *mqmsg)
+{
+  FAR struct tcb_s *rtcb = this_task();
+  FAR struct tcb_s *btcb;
+
+  /* Find the highest priority task that is waiting for
+   * this queue to be non-empty in waitfornotempty
+   * list. leave_critical_section() should give us sufficient
+   * protection since interrupts should never cause a change
+   * in this list
+   */
+
+  btcb = (FAR struct tcb_s *)dq_remfirst(MQ_WNELIST(msgq->cmn));
+
+  /* If one was found, unblock it */
+
+  DEBUGASSERT(btcb);
+
+  if (WDOG_ISACTIVE(&btcb->waitdog))
+    {
+      wd_cancel(&btcb->waitdog);
+    }
+
+  msgq->cmn.nwaitnotempty--;
+
+  /* Indicate that the wait is over. */
+
+  btcb->waitobj = mqmsg;
+
+  /* Add the task to ready-to-run task list and
+   * perform the context switch if one is needed
+   */
+
+  if (nxsched_add_readytorun(btcb))
+    {
+      up_switch_context(btcb, rtcb);
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -217,6 +298,117 @@ int nxmq_wait_send(FAR struct mqueue_inode_s *msgq,
   return -rtcb->errcode;
 }
 
+/****************************************************************************
+ * Name: nxmq_add_queue
+ *
+ * Description:
+ *   This function adds the specified message (mqmsg) to the message queue
+ *   (msgq), after the messages of the same or a higher priority.
+ *
+ * Input Parameters:
+ *   msgq   - Message queue descriptor
+ *   mqmsg  - Message to add, its priority is set
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions/restrictions:
+ * - Executes within a critical section established by the caller.
+ *
+ ****************************************************************************/
+
+void nxmq_add_queue(FAR struct mqueue_inode_s *msgq,
+                    FAR struct mqueue_msg_s *mqmsg)
+{
+#ifdef CONFIG_MQ_PRIO_BUCKETS
+  unsigned int prio = mqmsg->priority;
+  int lowest;
+
+  /* The messages of one priority are contiguous in the list, insert after
+   * the last message of the lowest priority that is not below that of the
+   * message, or at the head if there is none.
+   */
+
+  lowest = nxmq_prio_lowest(msgq, prio);
+  if (lowest >= 0)
+    {
+      list_add_after(msgq->priotail[lowest], &mqmsg->node);
+    }
+  else
+    {
+      list_add_head(&msgq->msglist, &mqmsg->node);
+    }
+
+  msgq->priotail[prio] = &mqmsg->node;
+  msgq->prioset[prio >> 5] |= UINT32_C(1) << (prio & 31);
+#else
+  FAR struct mqueue_msg_s *prev = NULL;
+  FAR struct mqueue_msg_s *next;
+
+  /* Insert the new message in the message queue
+   * Search the message list to find the location to insert the new
+   * message. Each is list is maintained in ascending priority order.
+   */
+
+  list_for_every_entry(&msgq->msglist, next, struct mqueue_msg_s, node)
+    {
+      if (mqmsg->priority > next->priority)
+        {
+          break;
+        }
+      else
+        {
+          prev = next;
+        }
+    }
+
+  /* Add the message at the right place */
+
+  if (prev)
+    {
+      list_add_after(&prev->node, &mqmsg->node);
+    }
+  else
+    {
+      list_add_head(&msgq->msglist, &mqmsg->node);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: nxmq_handoff_send
+ *
+ * Description:
+ *   Hand a message directly over to the highest priority task waiting for
+ *   the message queue to become non-empty.  This is only possible if the
+ *   queue is empty:  the message never enters the queue, so it cannot be
+ *   taken by another receiver before the woken task runs, and the queue
+ *   does not become readable for poll() or mq_notify().
+ *
+ * Input Parameters:
+ *   msgq   - Message queue descriptor
+ *   mqmsg  - Message to send
+ *
+ * Returned Value:
+ *   true if the message was handed over, false if it must be queued.
+ *
+ * Assumptions/restrictions:
+ * - Executes within a critical section established by the caller.
+ *
+ ****************************************************************************/
+
+bool nxmq_handoff_send(FAR struct mqueue_inode_s *msgq,
+                       FAR struct mqueue_msg_s *mqmsg)
+{
+  if (msgq->nmsgs > 0 || msgq->cmn.nwaitnotempty <= 0)
+    {
+      return false;
+    }
+
+  nxmq_unblock_receiver(msgq, mqmsg);
+  return true;
+}
+
 /****************************************************************************
  * Name: nxmq_notify_send
  *
@@ -238,8 +430,6 @@ int nxmq_wait_send(FAR struct mqueue_inode_s *msgq,
 
 void nxmq_notify_send(FAR struct mqueue_inode_s *msgq)
 {
-  FAR struct tcb_s *btcb;
-
   /* Check if we need to notify any tasks that are attached to the
    * message queue
    */
@@ -271,39 +461,6 @@ void nxmq_notify_send(FAR struct mqueue_inode_s *msgq)
 
   if (msgq->cmn.nwaitnotempty > 0)
     {
-      FAR struct tcb_s *rtcb = this_task();
-
-      /* Find the highest priority task that is waiting for
-       * this queue to be non-empty in waitfornotempty
-       * list. leave_critical_section() should give us sufficient
-       * protection since interrupts should never cause a change
-       * in this list
-       */
-
-      btcb = (FAR struct tcb_s *)dq_remfirst(MQ_WNELIST(msgq->cmn));
-
-      /* If one was found, unblock it */
-
-      DEBUGASSERT(btcb);
-
-      if (WDOG_ISACTIVE(&btcb->waitdog))
-        {
-          wd_cancel(&btcb->waitdog);
-        }
-
-      msgq->cmn.nwaitnotempty--;
-
-      /* Indicate that the wait is over. */
-
-      btcb->waitobj = NULL;
-
-      /* Add the task to ready-to-run task list and
-       * perform the context switch if one is needed
-       */
-
-      if (nxsched_add_readytorun(btcb))
-        {
-          up_switch_context(btcb, rtcb);
-        }
+      nxmq_unblock_receiver(msgq, NULL);
     }
 }
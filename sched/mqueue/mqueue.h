@@ -37,7 +37,9 @@
 #include <mqueue.h>
 #include <sched.h>
 
+#include <nuttx/nuttx.h>
 #include <nuttx/mqueue.h>
+#include <nuttx/spinlock.h>
 
 #if defined(CONFIG_MQ_MAXMSGSIZE) && CONFIG_MQ_MAXMSGSIZE > 0
 
@@ -51,6 +53,10 @@
 
 #define MQ_MSG_SIZE(n) (sizeof(struct mqueue_msg_s) + (n) - 1)
 
+/* The stride of the messages pre-allocated with a message queue */
+
+#define MQ_MSG_STRIDE(n) ALIGN_UP(MQ_MSG_SIZE(n), sizeof(uintptr_t))
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -59,7 +65,8 @@ enum mqalloc_e
 {
   MQ_ALLOC_FIXED = 0,  /* Pre-allocated; never freed */
   MQ_ALLOC_DYN,        /* Dynamically allocated; free when unused */
-  MQ_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_IRQ,        /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_QUEUE       /* Preallocated with the message queue */
 };
 
 /* This structure describes one buffered POSIX message. */
@@ -67,6 +74,9 @@ enum mqalloc_e
 struct mqueue_msg_s
 {
   struct list_node node;   /* Link node to message */
+#ifdef CONFIG_MQ_PERQUEUE_MSGS
+  FAR struct mqueue_inode_s *msgq; /* Owner of a MQ_ALLOC_QUEUE message */
+#endif
   uint8_t type;            /* (Used to manage allocations) */
   uint8_t priority;        /* Priority of message */
 #if MQ_MAX_BYTES < 256
@@ -101,6 +111,12 @@ EXTERN struct list_node g_msgfree;
 
 EXTERN struct list_node g_msgfreeirq;
 
+/* The g_msgfreelock protects both free lists.  It is taken from interrupt
+ * handlers too, but only for the few instructions of a list operation.
+ */
+
+EXTERN spinlock_t g_msgfreelock;
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -114,7 +130,8 @@ void nxmq_initialize(void);
 
 /* mq_msgfree.c *************************************************************/
 
-void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg);
+void nxmq_free_msg(FAR struct mqueue_inode_s *msgq,
+                   FAR struct mqueue_msg_s *mqmsg);
 
 /* mq_waitirq.c *************************************************************/
 
@@ -126,6 +143,7 @@ int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
                       FAR struct mqueue_msg_s **rcvmsg,
                       FAR const struct timespec *abstime,
                       sclock_t ticks);
+FAR struct mqueue_msg_s *nxmq_remove_queue(FAR struct mqueue_inode_s *msgq);
 void nxmq_notify_receive(FAR struct mqueue_inode_s *msgq);
 
 /* mq_sndinternal.c *********************************************************/
@@ -133,6 +151,10 @@ void nxmq_notify_receive(FAR struct mqueue_inode_s *msgq);
 int nxmq_wait_send(FAR struct mqueue_inode_s *msgq,
                    FAR const struct timespec *abstime,
                    sclock_t ticks);
+void nxmq_add_queue(FAR struct mqueue_inode_s *msgq,
+                    FAR struct mqueue_msg_s *mqmsg);
+bool nxmq_handoff_send(FAR struct mqueue_inode_s *msgq,
+                       FAR struct mqueue_msg_s *mqmsg);
 void nxmq_notify_send(FAR struct mqueue_inode_s *msgq);
 
 /* mq_recover.c *************************************************************/
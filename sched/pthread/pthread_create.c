@@ -211,7 +211,8 @@ int nx_pthread_create(pthread_trampoline_t trampoline, FAR pthread_t *thread,
 
   /* Allocate a TCB for the new task. */
 
-  ptcb = kmm_zalloc(sizeof(struct pthread_tcb_s));
+  ptcb = (FAR struct pthread_tcb_s *)
+         nxsched_alloc_tcb(TCB_FLAG_TTYPE_PTHREAD);
   if (!ptcb)
     {
       serr("ERROR: Failed to allocate TCB\n");
@@ -257,8 +258,8 @@ int nx_pthread_create(pthread_trampoline_t trampoline, FAR pthread_t *thread,
     {
       /* Allocate the stack for the TCB */
 
-      ret = up_create_stack((FAR struct tcb_s *)ptcb, attr->stacksize,
-                            TCB_FLAG_TTYPE_PTHREAD);
+      ret = nxsched_create_stack((FAR struct tcb_s *)ptcb, attr->stacksize,
+                                 TCB_FLAG_TTYPE_PTHREAD);
     }
 
   if (ret != OK)
@@ -318,6 +318,13 @@ void nxsched_remove_blocked(FAR struct tcb_s *btcb);
 int  nxsched_set_priority(FAR struct tcb_s *tcb, int sched_priority);
 bool nxsched_reprioritize_rtr(FAR struct tcb_s *tcb, int priority);
 
+/* Constant time insertion into the ready-to-run list */
+
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+bool nxsched_add_rtrbitmap(FAR struct tcb_s *tcb);
+void nxsched_remove_rtrbitmap(FAR struct tcb_s *tcb);
+#endif
+
 /* Priority inheritance support */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
@@ -354,6 +361,27 @@ uint32_t nxsched_process_sporadic(FAR struct tcb_s *tcb, uint32_t ticks,
 void nxsched_sporadic_lowpriority(FAR struct tcb_s *tcb);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+int  nxsched_start_deadline(FAR struct tcb_s *tcb, clock_t runtime,
+                            clock_t deadline, clock_t period);
+int  nxsched_stop_deadline(FAR struct tcb_s *tcb);
+int  nxsched_yield_deadline(FAR struct tcb_s *tcb);
+uint32_t nxsched_process_deadline(FAR struct tcb_s *tcb, uint32_t ticks,
+                                  bool noswitches);
+
+/* Earliest deadline first ordering between two deadline threads of the
+ * same priority.
+ */
+
+#  define nxsched_edf_before(tcb, next) \
+     (((tcb)->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE && \
+      ((next)->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE && \
+      (sclock_t)((tcb)->deadline->absdeadline - \
+                 (next)->deadline->absdeadline) < 0)
+#else
+#  define nxsched_edf_before(tcb, next) (false)
+#endif
+
 #ifdef CONFIG_SIG_SIGSTOP_ACTION
 void nxsched_suspend(FAR struct tcb_s *tcb);
 #endif
@@ -389,6 +417,12 @@ static inline_function FAR struct tcb_s *this_task(void)
 
 #ifdef CONFIG_SMP
 void nxsched_process_delivered(int cpu);
+#  ifdef CONFIG_SCHED_PERCPU_RUNQUEUE
+void nxsched_queue_assigned(FAR struct tcb_s *tcb, int cpu);
+FAR struct tcb_s *nxsched_balance_pull(int cpu);
+void nxsched_get_runqueue(int cpu, FAR unsigned int *queued,
+                          FAR uint32_t *migrated);
+#  endif
 #else
 #  define nxsched_select_cpu(a)     (0)
 #endif
@@ -426,6 +460,34 @@ void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state,
 
 bool nxsched_verify_tcb(FAR struct tcb_s *tcb);
 
+#ifndef CONFIG_DISABLE_PTHREAD
+#  define nxsched_tcb_size(ttype) \
+     ((ttype) == TCB_FLAG_TTYPE_KERNEL ? sizeof(struct tcb_s) : \
+      (ttype) == TCB_FLAG_TTYPE_PTHREAD ? sizeof(struct pthread_tcb_s) : \
+      sizeof(struct task_tcb_s))
+#else
+#  define nxsched_tcb_size(ttype) \
+     ((ttype) == TCB_FLAG_TTYPE_KERNEL ? sizeof(struct tcb_s) : \
+      sizeof(struct task_tcb_s))
+#endif
+
+#ifdef CONFIG_SCHED_TCB_CACHE
+FAR struct tcb_s *nxsched_alloc_tcb(uint8_t ttype);
+void nxsched_free_tcb(FAR struct tcb_s *tcb, uint8_t ttype);
+int nxsched_create_stack(FAR struct tcb_s *tcb, size_t stack_size,
+                         uint8_t ttype);
+void nxsched_release_stack(FAR struct tcb_s *tcb, uint8_t ttype);
+void nxsched_exiting_tcb(FAR struct tcb_s *tcb);
+#else
+#  define nxsched_alloc_tcb(ttype) \
+     ((FAR struct tcb_s *)kmm_zalloc(nxsched_tcb_size(ttype)))
+#  define nxsched_free_tcb(tcb, ttype)  kmm_free(tcb)
+#  define nxsched_create_stack(tcb, stack_size, ttype) \
+     up_create_stack(tcb, stack_size, ttype)
+#  define nxsched_release_stack(tcb, ttype) up_release_stack(tcb, ttype)
+#  define nxsched_exiting_tcb(tcb)
+#endif
+
 /* Obtain TLS from kernel */
 
 struct tls_info_s; /* Forward declare */
@@ -453,7 +515,9 @@ static inline_function bool nxsched_add_prioritized(FAR struct tcb_s *tcb,
    */
 
   for (next = (FAR struct tcb_s *)list->head;
-       (next && sched_priority <= next->sched_priority);
+       (next && (sched_priority < next->sched_priority ||
+                 (sched_priority == next->sched_priority &&
+                  !nxsched_edf_before(tcb, next))));
        next = next->flink);
 
   /* Add the tcb to the spot found in the list.  Check if the tcb
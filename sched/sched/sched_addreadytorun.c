@@ -77,7 +77,10 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
    * also disabled.
    */
 
-  if (rtcb->lockcount > 0 && rtcb->sched_priority < btcb->sched_priority)
+  if (rtcb->lockcount > 0 &&
+      (rtcb->sched_priority < btcb->sched_priority ||
+       (rtcb->sched_priority == btcb->sched_priority &&
+        nxsched_edf_before(btcb, rtcb))))
     {
       /* Yes.  Preemption would occur!  Add the new ready-to-run task to the
        * g_pendingtasks task list for now.
@@ -90,7 +93,11 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
 
   /* Otherwise, add the new task to the ready-to-run task list */
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+  else if (nxsched_add_rtrbitmap(btcb))
+#else
   else if (nxsched_add_prioritized(btcb, list_readytorun()))
+#endif
     {
       /* The new btcb was added at the head of the ready-to-run list.  It
        * is now the new active task!
@@ -215,9 +222,15 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
        * Add the task to the ready-to-run (but not running) task list
        */
 
+#ifdef CONFIG_SCHED_PERCPU_RUNQUEUE
+      /* Or rather to the run queue of the selected CPU */
+
+      nxsched_queue_assigned(btcb, cpu);
+#else
       nxsched_add_prioritized(btcb, list_readytorun());
 
       btcb->task_state = TSTATE_TASK_READYTORUN;
+#endif
       doswitch         = false;
     }
   else /* (task_state == TSTATE_TASK_RUNNING) */
@@ -0,0 +1,361 @@
+/****************************************************************************
+ * sched/sched/sched_balance.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sched.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/queue.h>
+#include <nuttx/wdog.h>
+
+#include "sched/queue.h"
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PERCPU_RUNQUEUE
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The periodic balancing is only armed while some task is queued, so that
+ * an idle system is not woken up for nothing.
+ */
+
+static struct wdog_s g_balance_wdog;
+
+/* The number of tasks migrated to each CPU by the load balancer */
+
+static uint32_t g_migrations[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_queue_length
+ *
+ * Description:
+ *   Return the number of tasks waiting in the run queue of a CPU, i.e. the
+ *   tasks of g_assignedtasks[cpu] other than the running and IDLE tasks.
+ *
+ ****************************************************************************/
+
+static unsigned int nxsched_queue_length(int cpu)
+{
+  FAR struct tcb_s *tcb = (FAR struct tcb_s *)g_assignedtasks[cpu].head;
+  unsigned int count = 0;
+
+  for (tcb = tcb->flink; tcb != NULL && !is_idle_task(tcb);
+       tcb = tcb->flink)
+    {
+      count++;
+    }
+
+  return count;
+}
+
+/****************************************************************************
+ * Name: nxsched_queue_candidate
+ *
+ * Description:
+ *   Return the highest priority task waiting in the run queue of 'from'
+ *   that may be migrated to 'to', or NULL if there is none.
+ *
+ ****************************************************************************/
+
+static FAR struct tcb_s *nxsched_queue_candidate(int from, int to)
+{
+  FAR struct tcb_s *tcb = (FAR struct tcb_s *)g_assignedtasks[from].head;
+
+  for (tcb = tcb->flink; tcb != NULL && !is_idle_task(tcb);
+       tcb = tcb->flink)
+    {
+      if ((tcb->flags & TCB_FLAG_CPU_LOCKED) == 0 &&
+          CPU_ISSET(to, &tcb->affinity))
+        {
+          return tcb;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: nxsched_balance
+ *
+ * Description:
+ *   Migrate one task from the longest run queue to the shortest one if
+ *   they are unbalanced, or to a CPU that has nothing to run.
+ *
+ * Returned Value:
+ *   true if tasks are still queued after the balancing.
+ *
+ ****************************************************************************/
+
+static bool nxsched_balance(void)
+{
+  FAR struct tcb_s *rtcb = this_task();
+  FAR struct tcb_s *tcb = NULL;
+  unsigned int length[CONFIG_SMP_NCPUS];
+  unsigned int total = 0;
+  int busiest = 0;
+  int target = -1;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      length[cpu] = nxsched_queue_length(cpu);
+      total      += length[cpu];
+
+      if (length[cpu] > length[busiest])
+        {
+          busiest = cpu;
+        }
+    }
+
+  if (length[busiest] == 0)
+    {
+      return false;
+    }
+
+  /* Prefer a CPU running its IDLE task, then the shortest queue if it is
+   * at least two tasks shorter than the longest one.
+   */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      if (cpu == busiest)
+        {
+          continue;
+        }
+
+      if (is_idle_task(current_task(cpu)) ||
+          length[cpu] + 1 < length[busiest])
+        {
+          tcb = nxsched_queue_candidate(busiest, cpu);
+          if (tcb == NULL)
+            {
+              continue;
+            }
+
+          if (target < 0 || is_idle_task(current_task(cpu)) ||
+              (!is_idle_task(current_task(target)) &&
+               length[cpu] < length[target]))
+            {
+              target = cpu;
+            }
+        }
+    }
+
+  if (target < 0)
+    {
+      return true;
+    }
+
+  tcb = nxsched_queue_candidate(busiest, target);
+  DEBUGASSERT(tcb != NULL);
+
+  dq_rem_mid(tcb);
+  g_migrations[target]++;
+
+  if (tcb->sched_priority > current_task(target)->sched_priority)
+    {
+      /* The task preempts the running task of the target CPU, let the
+       * normal path deliver it.
+       */
+
+      tcb->task_state = TSTATE_TASK_INVALID;
+      if (nxsched_add_readytorun(tcb))
+        {
+          up_switch_context(this_task(), rtcb);
+        }
+    }
+  else
+    {
+      nxsched_queue_assigned(tcb, target);
+    }
+
+  return total > 1;
+}
+
+/****************************************************************************
+ * Name: nxsched_balance_timeout
+ *
+ * Description:
+ *   The periodic load balancing.
+ *
+ ****************************************************************************/
+
+static void nxsched_balance_timeout(wdparm_t arg)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  if (nxsched_balance())
+    {
+      wd_start(&g_balance_wdog, CONFIG_SCHED_BALANCE_INTERVAL,
+               nxsched_balance_timeout, 0);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_queue_assigned
+ *
+ * Description:
+ *   Queue a ready-to-run task that does not preempt the running task of a
+ *   CPU on the g_assignedtasks[] list of that CPU.
+ *
+ * Input Parameters:
+ *   tcb - The TCB to queue, it is not in any list
+ *   cpu - The CPU selected for the task
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_queue_assigned(FAR struct tcb_s *tcb, int cpu)
+{
+  FAR struct tcb_s *next = (FAR struct tcb_s *)g_assignedtasks[cpu].head;
+  FAR struct tcb_s *prev;
+
+  DEBUGASSERT(tcb->sched_priority <= next->sched_priority);
+
+  /* The IDLE task is always last, insert after the tasks of the same or a
+   * higher priority.
+   */
+
+  for (next = next->flink; next->sched_priority >= tcb->sched_priority &&
+       !is_idle_task(next); next = next->flink);
+
+  prev = next->blink;
+  dq_insert_mid(prev, tcb, next);
+
+  tcb->cpu        = cpu;
+  tcb->task_state = TSTATE_TASK_ASSIGNED;
+
+  if (!WDOG_ISACTIVE(&g_balance_wdog))
+    {
+      wd_start(&g_balance_wdog, CONFIG_SCHED_BALANCE_INTERVAL,
+               nxsched_balance_timeout, 0);
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_balance_pull
+ *
+ * Description:
+ *   Called when a CPU has nothing else than its IDLE task to run.  Remove
+ *   the highest priority task that may run on this CPU from the run queues
+ *   of the other CPUs, the longest queue winning between tasks of the same
+ *   priority.
+ *
+ * Input Parameters:
+ *   cpu - The CPU that is about to become idle
+ *
+ * Returned Value:
+ *   The TCB removed from its run queue, or NULL if there is none.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *nxsched_balance_pull(int cpu)
+{
+  FAR struct tcb_s *best = NULL;
+  FAR struct tcb_s *tcb;
+  unsigned int bestlen = 0;
+  unsigned int length;
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (i == cpu)
+        {
+          continue;
+        }
+
+      tcb = nxsched_queue_candidate(i, cpu);
+      if (tcb == NULL)
+        {
+          continue;
+        }
+
+      length = nxsched_queue_length(i);
+      if (best == NULL || tcb->sched_priority > best->sched_priority ||
+          (tcb->sched_priority == best->sched_priority && length > bestlen))
+        {
+          best    = tcb;
+          bestlen = length;
+        }
+    }
+
+  if (best != NULL)
+    {
+      dq_rem_mid(best);
+      g_migrations[cpu]++;
+    }
+
+  return best;
+}
+
+/****************************************************************************
+ * Name: nxsched_get_runqueue
+ *
+ * Description:
+ *   Return the statistics of the run queue of a CPU.
+ *
+ * Input Parameters:
+ *   cpu      - The CPU
+ *   queued   - Receives the number of tasks waiting in the queue
+ *   migrated - Receives the number of tasks migrated to the CPU
+ *
+ ****************************************************************************/
+
+void nxsched_get_runqueue(int cpu, FAR unsigned int *queued,
+                          FAR uint32_t *migrated)
+{
+  irqstate_t flags;
+
+  flags     = enter_critical_section();
+  *queued   = nxsched_queue_length(cpu);
+  *migrated = g_migrations[cpu];
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_SCHED_PERCPU_RUNQUEUE */
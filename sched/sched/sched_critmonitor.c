@@ -100,6 +100,24 @@ clock_t g_premp_max[CONFIG_SMP_NCPUS];
 clock_t g_crit_max[CONFIG_SMP_NCPUS];
 #endif
 
+#if CONFIG_SCHED_CRITMONITOR_CSECTION_SITES > 0
+uint32_t g_crit_sites_dropped;
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The call sites of enter_critical_section(), an open addressing hash
+ * table indexed by the caller address.  It is only accessed within the
+ * critical section.
+ */
+
+#if CONFIG_SCHED_CRITMONITOR_CSECTION_SITES > 0
+static struct critmon_site_s
+g_crit_sites[CONFIG_SCHED_CRITMONITOR_CSECTION_SITES];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -153,6 +171,58 @@ static void nxsched_critmon_cpuload(FAR struct tcb_s *tcb, clock_t current,
 }
 #endif
 
+/****************************************************************************
+ * Name: nxsched_critmon_site
+ *
+ * Description:
+ *   Account the time spent in the critical section to its call site.
+ *
+ * Input Parameters:
+ *   caller  - The caller of enter_critical_section()
+ *   elapsed - The time spent in the critical section
+ *   leave   - true if the critical section is left, false if the thread
+ *             is only suspended within it
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_CRITMONITOR_CSECTION_SITES > 0
+static void nxsched_critmon_site(FAR void *caller, clock_t elapsed,
+                                 bool leave)
+{
+  FAR struct critmon_site_s *site;
+  unsigned int index;
+  unsigned int i;
+
+  index = ((uintptr_t)caller >> 2) %
+          CONFIG_SCHED_CRITMONITOR_CSECTION_SITES;
+
+  for (i = 0; i < CONFIG_SCHED_CRITMONITOR_CSECTION_SITES; i++)
+    {
+      site = &g_crit_sites[index];
+      if (site->caller == caller || site->caller == NULL)
+        {
+          site->caller  = caller;
+          site->total  += elapsed;
+          site->count  += leave;
+
+          if (elapsed > site->max)
+            {
+              site->max = elapsed;
+            }
+
+          return;
+        }
+
+      if (++index >= CONFIG_SCHED_CRITMONITOR_CSECTION_SITES)
+        {
+          index = 0;
+        }
+    }
+
+  g_crit_sites_dropped += leave;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -257,10 +327,132 @@ void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state,
         {
           g_crit_max[cpu] = elapsed;
         }
+
+#if CONFIG_SCHED_CRITMONITOR_CSECTION_SITES > 0
+      nxsched_critmon_site(tcb->crit_caller, elapsed, true);
+#endif
     }
 }
 #endif /* CONFIG_SCHED_CRITMONITOR_MAXTIME_CSECTION >= 0 */
 
+/****************************************************************************
+ * Name: nxsched_critmon_sites
+ *
+ * Description:
+ *   Return the call sites of enter_critical_section() that held the
+ *   critical section the longest in total, in decreasing order.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_CRITMONITOR_CSECTION_SITES > 0
+int nxsched_critmon_sites(FAR struct critmon_site_s *sites, int nsites)
+{
+  FAR struct critmon_site_s *site;
+  irqstate_t flags;
+  int count = 0;
+  int i;
+  int j;
+
+  DEBUGASSERT(sites != NULL && nsites > 0);
+
+  flags = enter_critical_section();
+
+  /* Insertion sort of the busiest sites into the caller's array */
+
+  for (i = 0; i < CONFIG_SCHED_CRITMONITOR_CSECTION_SITES; i++)
+    {
+      site = &g_crit_sites[i];
+      if (site->caller == NULL ||
+          (count == nsites && site->total <= sites[count - 1].total))
+        {
+          continue;
+        }
+
+      j = count < nsites ? count++ : count - 1;
+      for (; j > 0 && sites[j - 1].total < site->total; j--)
+        {
+          sites[j] = sites[j - 1];
+        }
+
+      sites[j] = *site;
+    }
+
+  leave_critical_section(flags);
+  return count;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxsched_critmon_runtime
+ *
+ * Description:
+ *   Return the total time a thread has run, including the time elapsed
+ *   since it was last resumed if it is running.
+ *
+ * Assumptions:
+ *   - Called within a critical section.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_CRITMONITOR_MAXTIME_THREAD >= 0
+clock_t nxsched_critmon_runtime(FAR struct tcb_s *tcb)
+{
+  clock_t runtime = tcb->run_time;
+
+  if (tcb->task_state == TSTATE_TASK_RUNNING)
+    {
+      runtime += perf_gettime() - tcb->run_start;
+    }
+
+  return runtime;
+}
+
+/****************************************************************************
+ * Name: nxsched_critmon_cputime
+ *
+ * Description:
+ *   Take a snapshot of the time run by all the threads, at the same
+ *   instant.
+ *
+ ****************************************************************************/
+
+int nxsched_critmon_cputime(FAR struct critmon_cputime_s *snap, int nsnap,
+                            FAR clock_t *now)
+{
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  int count = 0;
+  int ndx;
+
+  flags = enter_critical_section();
+
+  if (now != NULL)
+    {
+      *now = perf_gettime();
+    }
+
+  for (ndx = 0; ndx < g_npidhash; ndx++)
+    {
+      tcb = g_pidhash[ndx];
+      if (tcb == NULL)
+        {
+          continue;
+        }
+
+      if (count < nsnap)
+        {
+          snap[count].pid     = tcb->pid;
+          snap[count].runtime = nxsched_critmon_runtime(tcb);
+        }
+
+      count++;
+    }
+
+  leave_critical_section(flags);
+  return count;
+}
+#endif
+
 /****************************************************************************
  * Name: nxsched_resume_critmon
  *
@@ -383,6 +575,10 @@ void nxsched_suspend_critmon(FAR struct tcb_s *tcb)
           CHECK_CSECTION(tcb->pid, elapsed);
         }
 
+#if CONFIG_SCHED_CRITMONITOR_CSECTION_SITES > 0
+      nxsched_critmon_site(tcb->crit_caller, elapsed, false);
+#endif
+
       /* Check for the global max elapsed time */
 
       if (elapsed > g_crit_max[cpu])
@@ -0,0 +1,420 @@
+/****************************************************************************
+ * sched/sched/sched_deadline.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/sched.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/signal.h>
+#include <nuttx/wdog.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The admission control limit, in 1/65536 of the CPU */
+
+#define DEADLINE_MAX_BANDWIDTH \
+  (((uint32_t)CONFIG_SCHED_DEADLINE_BANDWIDTH << 16) / 100)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void deadline_expire(wdparm_t arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The bandwidth reserved by all the deadline threads, in 1/65536 */
+
+static uint32_t g_deadline_bandwidth;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: deadline_set_priority
+ *
+ * Description:
+ *   Change the priority of a deadline thread, respecting a priority boost
+ *   from priority inheritance as sporadic_set_hipriority() does.
+ *
+ ****************************************************************************/
+
+static int deadline_set_priority(FAR struct tcb_s *tcb, int priority)
+{
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  if (tcb->sched_priority > tcb->base_priority &&
+      tcb->sched_priority > priority)
+    {
+      /* Boosted above the new priority, just reset the base priority */
+
+      tcb->base_priority = priority;
+      return OK;
+    }
+#endif
+
+  return nxsched_reprioritize(tcb, priority);
+}
+
+/****************************************************************************
+ * Name: deadline_check
+ *
+ * Description:
+ *   Called when the deadline of the current job is reached.  The job is
+ *   late if it did not yield and the thread still has work to do, i.e. it
+ *   is not waiting for some other event.
+ *
+ ****************************************************************************/
+
+static void deadline_check(FAR struct deadline_s *dl)
+{
+  uint8_t task_state = dl->tcb->task_state;
+
+  if ((dl->flags & DEADLINE_FLAG_DONE) == 0 &&
+      (task_state == TSTATE_TASK_RUNNING ||
+       task_state == TSTATE_TASK_READYTORUN ||
+       task_state == TSTATE_TASK_PENDING))
+    {
+      dl->misses++;
+      swarn("WARNING: pid %d missed its deadline\n", dl->tcb->pid);
+    }
+}
+
+/****************************************************************************
+ * Name: deadline_release
+ *
+ * Description:
+ *   Start a new period:  replenish the budget, compute the absolute
+ *   deadline of the new job and start the timer for the deadline or, if
+ *   the deadline is the period, for the next period.
+ *
+ ****************************************************************************/
+
+static void deadline_release(FAR struct deadline_s *dl, clock_t release)
+{
+  dl->release     = release;
+  dl->absdeadline = release + dl->deadline;
+  dl->budget      = dl->runtime;
+  dl->flags      &= ~(DEADLINE_FLAG_DONE | DEADLINE_FLAG_ATDEADLINE);
+
+  if (dl->deadline < dl->period)
+    {
+      dl->flags |= DEADLINE_FLAG_ATDEADLINE;
+      wd_start_abstick(&dl->timer, dl->absdeadline, deadline_expire,
+                       (wdparm_t)dl);
+    }
+  else
+    {
+      wd_start_abstick(&dl->timer, release + dl->period, deadline_expire,
+                       (wdparm_t)dl);
+    }
+}
+
+/****************************************************************************
+ * Name: deadline_expire
+ *
+ * Description:
+ *   The deadline or period timer expired.
+ *
+ * Input Parameters:
+ *   Standard watchdog parameters
+ *
+ ****************************************************************************/
+
+static void deadline_expire(wdparm_t arg)
+{
+  FAR struct deadline_s *dl = (FAR struct deadline_s *)arg;
+  FAR struct tcb_s *tcb = dl->tcb;
+  FAR struct tcb_s *next;
+
+  DEBUGASSERT(tcb != NULL && tcb->deadline == dl);
+
+  if ((dl->flags & DEADLINE_FLAG_ATDEADLINE) != 0)
+    {
+      /* The deadline passed, wait for the end of the period */
+
+      deadline_check(dl);
+
+      dl->flags &= ~DEADLINE_FLAG_ATDEADLINE;
+      wd_start_abstick(&dl->timer, dl->release + dl->period,
+                       deadline_expire, arg);
+      return;
+    }
+
+  if (dl->deadline == dl->period)
+    {
+      deadline_check(dl);
+    }
+
+  deadline_release(dl, dl->release + dl->period);
+
+  /* A throttled thread gets its priority back.  Otherwise the thread has
+   * a later deadline now and is requeued:  if it is ready-to-run, or if it
+   * is running and a deadline thread of the same priority is now due
+   * before it.
+   */
+
+  next = tcb->flink;
+  if ((dl->flags & DEADLINE_FLAG_THROTTLED) != 0)
+    {
+      dl->flags &= ~DEADLINE_FLAG_THROTTLED;
+      DEBUGVERIFY(deadline_set_priority(tcb,
+                                        CONFIG_SCHED_DEADLINE_PRIORITY));
+    }
+  else if (tcb->task_state == TSTATE_TASK_READYTORUN ||
+           (tcb->task_state == TSTATE_TASK_RUNNING &&
+            !nxsched_islocked_tcb(tcb) && next != NULL &&
+            next->sched_priority == tcb->sched_priority &&
+            nxsched_edf_before(next, tcb)))
+    {
+      DEBUGVERIFY(nxsched_set_priority(tcb, tcb->sched_priority));
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_start_deadline
+ *
+ * Description:
+ *   Admit a thread to the deadline scheduling policy, or change its
+ *   parameters, and start its first period now.
+ *
+ * Input Parameters:
+ *   tcb      - The TCB of the thread
+ *   runtime  - The execution budget per period, in ticks
+ *   deadline - The relative deadline in ticks, zero for the period
+ *   period   - The period in ticks
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success or a negated errno value on failure:
+ *   -EINVAL if not 0 < runtime <= deadline <= period, -EBUSY if the
+ *   bandwidth is not available.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+int nxsched_start_deadline(FAR struct tcb_s *tcb, clock_t runtime,
+                           clock_t deadline, clock_t period)
+{
+  FAR struct deadline_s *dl = tcb->deadline;
+  uint32_t bandwidth;
+  uint32_t reserved;
+
+  if (deadline == 0)
+    {
+      deadline = period;
+    }
+
+  if (runtime == 0 || runtime > deadline || deadline > period)
+    {
+      return -EINVAL;
+    }
+
+  /* Admission control */
+
+  bandwidth = (uint32_t)(((uint64_t)runtime << 16) / period);
+  reserved  = g_deadline_bandwidth - (dl != NULL ? dl->bandwidth : 0);
+
+  if (reserved > DEADLINE_MAX_BANDWIDTH ||
+      bandwidth > DEADLINE_MAX_BANDWIDTH - reserved)
+    {
+      return -EBUSY;
+    }
+
+  if (dl == NULL)
+    {
+      dl = kmm_zalloc(sizeof(struct deadline_s));
+      if (dl == NULL)
+        {
+          serr("ERROR: Failed to allocate deadline data structure\n");
+          return -ENOMEM;
+        }
+
+      dl->tcb       = tcb;
+      tcb->deadline = dl;
+    }
+  else
+    {
+      wd_cancel(&dl->timer);
+      dl->flags = 0;
+    }
+
+  g_deadline_bandwidth = reserved + bandwidth;
+
+  dl->runtime   = runtime;
+  dl->deadline  = deadline;
+  dl->period    = period;
+  dl->bandwidth = bandwidth;
+
+  deadline_release(dl, clock_systime_ticks());
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_stop_deadline
+ *
+ * Description:
+ *   Stop the deadline scheduling of a thread and release its bandwidth.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxsched_stop_deadline(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *dl = tcb->deadline;
+
+  DEBUGASSERT(dl != NULL);
+
+  wd_cancel(&dl->timer);
+  g_deadline_bandwidth -= dl->bandwidth;
+
+  kmm_free(dl);
+  tcb->deadline = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_yield_deadline
+ *
+ * Description:
+ *   sched_yield() of a deadline thread:  the current job is complete, the
+ *   thread sleeps until the start of its next period.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the calling thread
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxsched_yield_deadline(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *dl = tcb->deadline;
+  irqstate_t flags;
+  sclock_t delay;
+
+  DEBUGASSERT(dl != NULL);
+
+  flags = enter_critical_section();
+  dl->flags |= DEADLINE_FLAG_DONE;
+  delay = (sclock_t)(dl->release + dl->period - clock_systime_ticks());
+  leave_critical_section(flags);
+
+  if (delay > 0)
+    {
+      int ret = nxsig_usleep(TICK2USEC(delay));
+      return ret == -EINTR ? OK : ret;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_process_deadline
+ *
+ * Description:
+ *   Process the elapsed time of the running deadline thread and throttle it
+ *   if its budget is exhausted.
+ *
+ * Input Parameters:
+ *   tcb        - The TCB of the running deadline thread
+ *   ticks      - The number of ticks that have elapsed
+ *   noswitches - We are running in a context where context switching is
+ *                not permitted.
+ *
+ * Returned Value:
+ *   The number of ticks remaining in the budget, or zero if there is
+ *   nothing to time.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+uint32_t nxsched_process_deadline(FAR struct tcb_s *tcb, uint32_t ticks,
+                                  bool noswitches)
+{
+  FAR struct deadline_s *dl = tcb->deadline;
+
+  DEBUGASSERT(dl != NULL && ticks > 0);
+
+  if ((dl->flags & DEADLINE_FLAG_THROTTLED) != 0)
+    {
+      return 0;
+    }
+
+  if (dl->budget > ticks)
+    {
+      dl->budget -= ticks;
+      return dl->budget;
+    }
+
+  dl->budget = 0;
+
+  /* The budget is exhausted.  The priority cannot be dropped now if
+   * context switches are not permitted or if the thread has locked the
+   * scheduler:  try again on the next tick.
+   */
+
+  if (noswitches || nxsched_islocked_tcb(tcb))
+    {
+      return 1;
+    }
+
+  dl->flags |= DEADLINE_FLAG_THROTTLED;
+  dl->throttled++;
+
+  DEBUGVERIFY(deadline_set_priority(tcb, SCHED_PRIORITY_MIN));
+  return 0;
+}
+
+#endif /* CONFIG_SCHED_DEADLINE */
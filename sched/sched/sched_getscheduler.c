@@ -94,6 +94,14 @@ int nxsched_get_scheduler(pid_t pid)
    */
 
   policy = (tcb->flags & TCB_FLAG_POLICY_MASK) >> TCB_FLAG_POLICY_SHIFT;
+
+#ifdef CONFIG_SCHED_DEADLINE
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      return SCHED_DEADLINE;
+    }
+#endif
+
   return policy + 1;
 }
 
@@ -92,3 +92,34 @@ FAR struct tcb_s *nxsched_get_tcb(pid_t pid)
 
   return ret;
 }
+
+/****************************************************************************
+ * Name: nxsched_is_running
+ *
+ * Description:
+ *   Return true if the thread of a task ID is running on a CPU.  No lock is
+ *   taken, the answer is only a hint that may be stale when it is returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_MUTEX_ADAPTIVE
+bool nxsched_is_running(pid_t pid)
+{
+  int cpu;
+
+  /* The running tasks may change under us and the TCB read may even be
+   * released at once, its pid is only compared:  the worst outcome is a
+   * wrong hint.
+   */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      if (current_task(cpu)->pid == pid)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+#endif
@@ -29,6 +29,7 @@
 #include <fcntl.h>
 #include <stdbool.h>
 #include <poll.h>
+#include <sys/param.h>
 
 #include <nuttx/atomic.h>
 #include <nuttx/kmalloc.h>
@@ -46,6 +47,19 @@
 #define PERF_GET_COUNT(event) ((event)->count + (event)->child_count)
 #define PERF_DEFAULT_PERIOD 1000
 
+/* The sampling period of the cpu_clock event in nanoseconds */
+
+#define PERF_CPUCLOCK_PERIOD(event) \
+  ((event)->attr.freq ? \
+   NSEC_PER_SEC / MAX((event)->attr.sample_freq, 1) : \
+   MAX((event)->attr.sample_period, PERF_DEFAULT_PERIOD))
+
+#ifdef CONFIG_SCHED_PERF_CALLCHAIN_DEPTH
+#  define PERF_CALLCHAIN_DEPTH CONFIG_SCHED_PERF_CALLCHAIN_DEPTH
+#else
+#  define PERF_CALLCHAIN_DEPTH 0
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -101,6 +115,14 @@ static int perf_swevent_match(FAR struct perf_event_s *event);
 
 static struct perf_event_context_s g_perf_cpu_ctx[CONFIG_SMP_NCPUS];
 static struct list_node g_perf_pmus = LIST_INITIAL_VALUE(g_perf_pmus);
+
+#if PERF_CALLCHAIN_DEPTH > 0
+/* The call chain of the sample being recorded on each CPU, a
+ * struct perf_callchain_entry: the number of entries then the entries.
+ */
+
+static uint64_t g_perf_callchain[CONFIG_SMP_NCPUS][PERF_CALLCHAIN_DEPTH + 1];
+#endif
 static mutex_t g_perf_pmus_lock = NXMUTEX_INITIALIZER;
 volatile static uint64_t g_perf_eventid;
 
@@ -178,6 +200,12 @@ static uint16_t perf_prepare_sample(FAR struct perf_sample_data_s *data,
   uint64_t sample_type = event->attr.sample_type;
   uint16_t size = sizeof(struct perf_event_header_s);
 
+  /* The same data may be prepared for several events with different
+   * sample types, only the fields of this one are output.
+   */
+
+  data->sample_flags = PERF_SAMPLE_PERIOD;
+
   if (sample_type & PERF_SAMPLE_IP)
     {
       data->ip = ip;
@@ -220,6 +248,39 @@ static uint16_t perf_prepare_sample(FAR struct perf_sample_data_s *data,
       size += sizeof(data->tid_entry);
     }
 
+#if PERF_CALLCHAIN_DEPTH > 0
+  if (sample_type & PERF_SAMPLE_CALLCHAIN)
+    {
+      FAR void *frames[PERF_CALLCHAIN_DEPTH];
+      FAR uint64_t *chain = g_perf_callchain[this_cpu()];
+      int nr;
+      int i;
+
+      /* The samples are taken in the context of the running thread, from
+       * the overflow interrupt or the sampling timer:  the call chain
+       * starts with the frames of the sampler itself and continues with
+       * those of the interrupted code.
+       */
+
+      nr = sched_backtrace(nxsched_gettid(), frames, PERF_CALLCHAIN_DEPTH,
+                           0);
+      if (nr < 0)
+        {
+          nr = 0;
+        }
+
+      chain[0] = nr;
+      for (i = 0; i < nr; i++)
+        {
+          chain[i + 1] = (uintptr_t)frames[i];
+        }
+
+      data->callchain = (FAR struct perf_callchain_entry *)chain;
+      data->sample_flags |= PERF_SAMPLE_CALLCHAIN;
+      size += (nr + 1) * sizeof(uint64_t);
+    }
+#endif
+
   return size;
 }
 
@@ -227,26 +288,34 @@ static void perf_output_sample(FAR struct perf_event_header_s *header,
                                FAR struct perf_sample_data_s *data,
                                FAR struct perf_event_s *event)
 {
-  uint64_t sample_type = data->sample_flags;
+  /* Only the fields filled in by perf_prepare_sample() are output */
+
+  uint64_t sample_flags = data->sample_flags;
 
   circbuf_overwrite(&(event->buf->rb), header,
                     sizeof(struct perf_event_header_s));
 
-  if (sample_type & PERF_SAMPLE_IP)
+  if (sample_flags & PERF_SAMPLE_IP)
     {
       circbuf_overwrite(&(event->buf->rb), &data->ip, sizeof(data->ip));
     }
 
-  if (sample_type & PERF_SAMPLE_TID)
+  if (sample_flags & PERF_SAMPLE_TID)
     {
       circbuf_overwrite(&(event->buf->rb), &data->tid_entry,
                         sizeof(data->tid_entry));
     }
 
-  if (sample_type & PERF_SAMPLE_ID)
+  if (sample_flags & PERF_SAMPLE_ID)
     {
       circbuf_overwrite(&(event->buf->rb), &data->id, sizeof(data->id));
     }
+
+  if (sample_flags & PERF_SAMPLE_CALLCHAIN)
+    {
+      circbuf_overwrite(&(event->buf->rb), data->callchain,
+                        (data->callchain->nr + 1) * sizeof(uint64_t));
+    }
 }
 
 static int perf_event_data_overflow(FAR struct perf_event_s *event,
@@ -667,8 +736,9 @@ out:
 static void perf_free_pmu_context(FAR struct pmu_event_context_s *pmu_ctx)
 {
   bool free_flag = false;
+  irqstate_t flags;
 
-  spin_lock(&pmu_ctx->ctx->lock);
+  flags = spin_lock_irqsave(&pmu_ctx->ctx->lock);
 
   pmu_ctx->refcount--;
 
@@ -682,7 +752,7 @@ static void perf_free_pmu_context(FAR struct pmu_event_context_s *pmu_ctx)
         }
     }
 
-  spin_unlock(&pmu_ctx->ctx->lock);
+  spin_unlock_irqrestore(&pmu_ctx->ctx->lock, flags);
 
   if (pmu_ctx->refcount == 0)
     {
@@ -1333,7 +1403,7 @@ static int perf_task_function_call(FAR struct tcb_s *tcb,
 #ifdef CONFIG_SMP
   if (tcb->cpu != this_cpu())
     {
-      return nxsched_smp_call_single(tcb->cpu, func, event, true);
+      return nxsched_smp_call_single(tcb->cpu, func, event);
     }
 #endif
 
@@ -1363,7 +1433,7 @@ static int perf_cpu_function_call(int cpu, FAR struct perf_event_s *event,
 #ifdef CONFIG_SMP
   if (cpu != this_cpu())
     {
-      return nxsched_smp_call_single(cpu, func, event, true);
+      return nxsched_smp_call_single(cpu, func, event);
     }
 #endif
 
@@ -2252,14 +2322,23 @@ static void perf_swevent_timer_handle(wdparm_t arg)
   /* TODO: ISR thread cannot get pc */
 
   uintptr_t pc = up_getusrpc(NULL);
-  sclock_t period = NSEC2TICK(event->attr.sample_period);
+  sclock_t period = NSEC2TICK(PERF_CPUCLOCK_PERIOD(event));
   irqstate_t flags;
 
-  perf_sample_data_init(&data, event->attr.sample_period);
+  /* The event is only counted until it is mapped */
 
-  flags = spin_lock_irqsave(&event->buf->lock);
-  perf_event_data_overflow(event, &data, pc);
-  spin_unlock_irqrestore(&event->buf->lock, flags);
+  if (event->buf != NULL)
+    {
+      perf_sample_data_init(&data, event->attr.sample_period);
+
+      flags = spin_lock_irqsave(&event->buf->lock);
+      perf_event_data_overflow(event, &data, pc);
+      spin_unlock_irqrestore(&event->buf->lock, flags);
+    }
+  else
+    {
+      event->count++;
+    }
 
   wd_start(&event->hw.waitdog, period, perf_swevent_timer_handle, arg);
 }
@@ -2346,10 +2425,7 @@ static void perf_cpuclock_event_del(FAR struct perf_event_s *event,
 static int perf_cpuclock_event_start(FAR struct perf_event_s *event,
                                      int flags)
 {
-  sclock_t period = event->attr.sample_period;
-
-  period = (PERF_DEFAULT_PERIOD > event->attr.sample_period) ?
-           PERF_DEFAULT_PERIOD : event->attr.sample_period;
+  sclock_t period = PERF_CPUCLOCK_PERIOD(event);
 
   wd_start(&event->hw.waitdog, NSEC2TICK(period),
            perf_swevent_timer_handle, (wdparm_t)event);
@@ -2473,6 +2549,23 @@ static int perf_swevent_match(FAR struct perf_event_s *event)
 
 int perf_event_overflow(FAR struct perf_event_s *event)
 {
+  struct perf_sample_data_s data;
+  irqstate_t flags;
+
+  /* A counting event, or one that nobody maps, only needs its count */
+
+  if (event->attr.freq || event->attr.sample_period == 0 ||
+      event->buf == NULL)
+    {
+      return 0;
+    }
+
+  perf_sample_data_init(&data, event->attr.sample_period);
+
+  flags = spin_lock_irqsave(&event->buf->lock);
+  perf_event_data_overflow(event, &data, up_getusrpc(NULL));
+  spin_unlock_irqrestore(&event->buf->lock, flags);
+
   return 0;
 }
 
@@ -2576,6 +2669,16 @@ int perf_event_open(FAR struct perf_event_attr_s *attr, pid_t pid,
       return -EINVAL;
     }
 
+#if PERF_CALLCHAIN_DEPTH == 0
+  /* The samples could not carry the call chains the reader expects */
+
+  if (attr->sample_type & PERF_SAMPLE_CALLCHAIN)
+    {
+      serr("perf event call chains are not supported\n");
+      return -EINVAL;
+    }
+#endif
+
   if (group_fd >= 0)
     {
       ret = fs_getfilep(group_fd, &group_file);
@@ -93,7 +93,16 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
-  dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+  if (tasklist == list_readytorun())
+    {
+      nxsched_remove_rtrbitmap(rtcb);
+    }
+  else
+#endif
+    {
+      dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+    }
 
   /* Since the TCB is not in any list, it is now invalid */
 
@@ -184,6 +193,7 @@ void nxsched_remove_running(FAR struct tcb_s *tcb)
 
   dq_rem_head((FAR dq_entry_t *)tcb, tasklist);
 
+#ifndef CONFIG_SCHED_PERCPU_RUNQUEUE
   /* Find the highest priority non-running tasks in the g_assignedtasks
    * list of other CPUs, and also non-idle tasks, place them in the
    * g_readytorun list. so as to find the task with the highest priority,
@@ -224,6 +234,7 @@ void nxsched_remove_running(FAR struct tcb_s *tcb)
             }
         }
     }
+#endif
 
   /* Which task will go at the head of the list?  It will be either the
    * next tcb in the assigned task list (nxttcb) or a TCB in the
@@ -259,6 +270,23 @@ void nxsched_remove_running(FAR struct tcb_s *tcb)
       rtrtcb->cpu = cpu;
       nxttcb = rtrtcb;
     }
+#ifdef CONFIG_SCHED_PERCPU_RUNQUEUE
+  else if (is_idle_task(nxttcb))
+    {
+      /* The run queue of this CPU is empty, pull a task from the run
+       * queue of another CPU rather than going idle.
+       */
+
+      rtrtcb = nxsched_balance_pull(cpu);
+      if (rtrtcb != NULL)
+        {
+          dq_addfirst_nonempty((FAR dq_entry_t *)rtrtcb, tasklist);
+
+          rtrtcb->cpu = cpu;
+          nxttcb = rtrtcb;
+        }
+    }
+#endif
 
   /* NOTE: If the task runs on another CPU(cpu), adjusting global IRQ
    * controls will be done in the pause handler on the new CPU(cpu).
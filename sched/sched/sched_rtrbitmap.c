@@ -0,0 +1,232 @@
+/****************************************************************************
+ * sched/sched/sched_rtrbitmap.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/queue.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define RTR_NWORDS ((SCHED_PRIORITY_MAX + 32) / 32)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The g_readytorun list stays a single list in descending priority order,
+ * so that all the code walking it is unchanged.  The tasks of one priority
+ * are contiguous in the list and form a FIFO; the bitmap records which
+ * priorities are present and g_rtrtail[] the last task of each one, so the
+ * insertion point of a task is found with a find-first-set instead of a
+ * walk of the list.
+ *
+ * The head of the list, the running task, is not part of the index: its
+ * priority may be changed in place (priority protection, reprioritizing
+ * the running task) without it being moved in the list.
+ */
+
+static uint32_t g_rtrmap[RTR_NWORDS];
+static FAR struct tcb_s *g_rtrtail[SCHED_PRIORITY_MAX + 1];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_rtr_lowest
+ *
+ * Description:
+ *   Return the lowest priority present in the index that is greater than
+ *   or equal to 'priority', or -1 if there is none.
+ *
+ ****************************************************************************/
+
+static int nxsched_rtr_lowest(int priority)
+{
+  int word = priority >> 5;
+  uint32_t bits = g_rtrmap[word] & (UINT32_MAX << (priority & 31));
+
+  while (bits == 0)
+    {
+      if (++word >= RTR_NWORDS)
+        {
+          return -1;
+        }
+
+      bits = g_rtrmap[word];
+    }
+
+  return (word << 5) + ffs((int)bits) - 1;
+}
+
+/****************************************************************************
+ * Name: nxsched_rtr_unindex
+ *
+ * Description:
+ *   Remove a task that is not the head of the list from the index.  The
+ *   task must still be linked in the list.
+ *
+ ****************************************************************************/
+
+static void nxsched_rtr_unindex(FAR struct tcb_s *tcb)
+{
+  uint8_t priority = tcb->sched_priority;
+  FAR struct tcb_s *prev;
+
+  if (g_rtrtail[priority] != tcb)
+    {
+      return;
+    }
+
+  /* The previous task is the new tail if it has the same priority and is
+   * not the head of the list.
+   */
+
+  prev = tcb->blink;
+  if (prev != NULL && prev->blink != NULL &&
+      prev->sched_priority == priority)
+    {
+      g_rtrtail[priority] = prev;
+    }
+  else
+    {
+      g_rtrtail[priority] = NULL;
+      g_rtrmap[priority >> 5] &= ~(UINT32_C(1) << (priority & 31));
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_add_rtrbitmap
+ *
+ * Description:
+ *   Insert a TCB in the g_readytorun list after all the tasks of the same
+ *   or a higher priority, in constant time.
+ *
+ * Input Parameters:
+ *   tcb - The TCB to insert, it is not in any list
+ *
+ * Returned Value:
+ *   true if the TCB was added at the head of the list.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+bool nxsched_add_rtrbitmap(FAR struct tcb_s *tcb)
+{
+  FAR dq_queue_t *list = list_readytorun();
+  FAR struct tcb_s *head = (FAR struct tcb_s *)list->head;
+  FAR struct tcb_s *prev;
+  uint8_t priority = tcb->sched_priority;
+  int lowest;
+
+  DEBUGASSERT(priority >= SCHED_PRIORITY_MIN);
+
+  if (head == NULL || priority > head->sched_priority)
+    {
+      dq_addfirst((FAR dq_entry_t *)tcb, list);
+
+      /* The previous head joins the index, in front of the tasks of its
+       * priority.
+       */
+
+      if (head != NULL)
+        {
+          priority = head->sched_priority;
+          if (g_rtrtail[priority] == NULL)
+            {
+              g_rtrtail[priority] = head;
+              g_rtrmap[priority >> 5] |= UINT32_C(1) << (priority & 31);
+            }
+        }
+
+      return true;
+    }
+
+  /* Insert after the last task of the lowest priority that is not below
+   * that of the TCB, or right after the head if there is none.
+   */
+
+  lowest = nxsched_rtr_lowest(priority);
+  prev   = lowest < 0 ? head : g_rtrtail[lowest];
+
+  dq_addafter((FAR dq_entry_t *)prev, (FAR dq_entry_t *)tcb, list);
+
+  g_rtrtail[priority] = tcb;
+  g_rtrmap[priority >> 5] |= UINT32_C(1) << (priority & 31);
+  return false;
+}
+
+/****************************************************************************
+ * Name: nxsched_remove_rtrbitmap
+ *
+ * Description:
+ *   Remove a TCB from the g_readytorun list.
+ *
+ * Input Parameters:
+ *   tcb - The TCB to remove
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_remove_rtrbitmap(FAR struct tcb_s *tcb)
+{
+  if (tcb->blink == NULL)
+    {
+      /* The next task becomes the head, it leaves the index */
+
+      if (tcb->flink != NULL)
+        {
+          nxsched_rtr_unindex(tcb->flink);
+        }
+    }
+  else
+    {
+      nxsched_rtr_unindex(tcb);
+    }
+
+  dq_rem((FAR dq_entry_t *)tcb, list_readytorun());
+}
+
+#endif /* CONFIG_SCHED_READYTORUN_BITMAP */
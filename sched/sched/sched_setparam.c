@@ -205,6 +205,25 @@ int nxsched_set_param(pid_t pid, FAR const struct sched_param *param)
     }
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* The priority of a deadline thread is fixed, only update the parameters
+   * associated with SCHED_DEADLINE.
+   */
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      irqstate_t flags;
+
+      flags = enter_critical_section();
+      ret = nxsched_start_deadline(tcb,
+              clock_time2ticks(&param->sched_dl_runtime),
+              clock_time2ticks(&param->sched_dl_deadline),
+              clock_time2ticks(&param->sched_dl_period));
+      leave_critical_section(flags);
+      goto errout_with_lock;
+    }
+#endif
+
   /* Then perform the reprioritization */
 
   ret = nxsched_reprioritize(tcb, param->sched_priority);
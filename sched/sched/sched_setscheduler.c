@@ -82,6 +82,7 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 {
   FAR struct tcb_s *tcb;
   irqstate_t flags;
+  int priority = param->sched_priority;
   int ret;
 
   /* Check for supported scheduling policy */
@@ -93,16 +94,27 @@ int nxsched_set_scheduler(pid_t pid, int policy,
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
       && policy != SCHED_SPORADIC
+#endif
+#ifdef CONFIG_SCHED_DEADLINE
+      && policy != SCHED_DEADLINE
 #endif
      )
     {
       return -EINVAL;
     }
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Deadline threads all run at the same priority, ordered by deadline */
+
+  if (policy == SCHED_DEADLINE)
+    {
+      priority = CONFIG_SCHED_DEADLINE_PRIORITY;
+    }
+#endif
+
   /* Verify that the requested priority is in the valid range */
 
-  if (param->sched_priority < SCHED_PRIORITY_MIN ||
-      param->sched_priority > SCHED_PRIORITY_MAX)
+  if (priority < SCHED_PRIORITY_MIN || priority > SCHED_PRIORITY_MAX)
     {
       return -EINVAL;
     }
@@ -131,6 +143,17 @@ int nxsched_set_scheduler(pid_t pid, int policy,
   /* Further, disable timer interrupts while we set up scheduling policy. */
 
   flags = enter_critical_section();
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Leaving the deadline policy releases the reserved bandwidth */
+
+  if (policy != SCHED_DEADLINE &&
+      (tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      DEBUGVERIFY(nxsched_stop_deadline(tcb));
+    }
+#endif
+
   tcb->flags &= ~TCB_FLAG_POLICY_MASK;
   switch (policy)
     {
@@ -266,17 +289,45 @@ int nxsched_set_scheduler(pid_t pid, int policy,
         }
         break;
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+      case SCHED_DEADLINE:
+        {
+          /* Admit the thread (or update its parameters) and start its
+           * first period.
+           */
+
+          ret = nxsched_start_deadline(tcb,
+                  clock_time2ticks(&param->sched_dl_runtime),
+                  clock_time2ticks(&param->sched_dl_deadline),
+                  clock_time2ticks(&param->sched_dl_period));
+          if (ret < 0)
+            {
+              /* The thread keeps its previous parameters, if any */
+
+              if (tcb->deadline != NULL)
+                {
+                  tcb->flags |= TCB_FLAG_SCHED_DEADLINE;
+                }
+
+              goto errout_with_irq;
+            }
+
+          tcb->flags |= TCB_FLAG_SCHED_DEADLINE;
+        }
+        break;
+#endif
     }
 
   leave_critical_section(flags);
 
   /* Set the new priority */
 
-  ret = nxsched_reprioritize(tcb, param->sched_priority);
+  ret = nxsched_reprioritize(tcb, priority);
   sched_unlock();
   return ret;
 
-#ifdef CONFIG_SCHED_SPORADIC
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_DEADLINE)
 errout_with_irq:
   leave_critical_section(flags);
   sched_unlock();
@@ -34,6 +34,10 @@
 #include <nuttx/clock.h>
 #include <nuttx/sched_note.h>
 
+#ifdef CONFIG_SCHED_PERF_EVENTS
+#  include <nuttx/perf.h>
+#endif
+
 #include "clock/clock.h"
 #include "sched/sched.h"
 
@@ -85,6 +89,10 @@ void nxsched_suspend_scheduler(FAR struct tcb_s *tcb)
 #ifdef CONFIG_SCHED_INSTRUMENTATION
   sched_note_suspend(tcb);
 #endif
+
+#ifdef CONFIG_SCHED_PERF_EVENTS
+  perf_event_task_sched_out(tcb);
+#endif
 }
 
 #endif /* CONFIG_SCHED_SUSPENDSCHEDULER */
@@ -0,0 +1,506 @@
+/****************************************************************************
+ * sched/sched/sched_tcbcache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/queue.h>
+#include <nuttx/spinlock.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_TCB_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* User stacks are not cached if they belong to an address environment */
+
+#if CONFIG_SCHED_TCB_CACHE_NSTACKS > 0 && \
+    !defined(CONFIG_BUILD_KERNEL) && !defined(CONFIG_ARCH_ADDRENV)
+#  define HAVE_STACK_CACHE 1
+#endif
+
+/* The pattern of the cached blocks with SCHED_TCB_CACHE_POISON */
+
+#define TCB_CACHE_POISON 0xa5
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The free TCBs of one thread type, TCB_FLAG_TTYPE_TASK or _PTHREAD */
+
+struct tcb_cache_s
+{
+  sq_queue_t   free;
+  unsigned int nfree;
+};
+
+/* The header of a cached stack, at the bottom of the stack memory */
+
+struct tcb_cache_stack_s
+{
+  sq_entry_t entry;
+  size_t     size;   /* Usable size of the memory, header included */
+};
+
+/* A thread cannot put its own TCB and stack in the caches when it exits,
+ * it still runs on them until the next context switch.  nxtask_exit()
+ * names it in exiting while it releases its resources:  they are kept per
+ * CPU and cached by the next call on the same CPU, made by another thread.
+ */
+
+struct tcb_cache_deferred_s
+{
+  FAR struct tcb_s *exiting;
+  FAR struct tcb_s *tcb;
+  uint8_t           ttype;
+#ifdef HAVE_STACK_CACHE
+  FAR void         *stack;
+  size_t            size;
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static spinlock_t g_tcb_cache_lock = SP_UNLOCKED;
+static struct tcb_cache_s g_tcb_cache[2];
+static struct tcb_cache_deferred_s g_tcb_cache_deferred[CONFIG_SMP_NCPUS];
+
+#ifdef HAVE_STACK_CACHE
+static sq_queue_t g_stack_cache;
+static unsigned int g_stack_cache_nfree;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TCB_CACHE_POISON
+/****************************************************************************
+ * Name: tcb_cache_check
+ *
+ * Description:
+ *   Verify that a cached block was not written since it was released.
+ *
+ ****************************************************************************/
+
+static void tcb_cache_check(FAR const void *mem, size_t size)
+{
+  FAR const uint8_t *ptr = mem;
+  size_t i;
+
+  for (i = 0; i < size; i++)
+    {
+      if (ptr[i] != TCB_CACHE_POISON)
+        {
+          serr("ERROR: %p written after release, offset %zu\n", mem, i);
+          PANIC();
+        }
+    }
+}
+
+#  define tcb_cache_poison(mem, size) memset(mem, TCB_CACHE_POISON, size)
+#else
+#  define tcb_cache_check(mem, size)
+#  define tcb_cache_poison(mem, size)
+#endif
+
+/****************************************************************************
+ * Name: tcb_cache_put
+ *
+ * Description:
+ *   Put a TCB of a thread that is not running in the cache of its type,
+ *   or free it if the cache is full.
+ *
+ ****************************************************************************/
+
+static void tcb_cache_put(FAR struct tcb_s *tcb, uint8_t ttype)
+{
+  FAR struct tcb_cache_s *cache = &g_tcb_cache[ttype];
+  irqstate_t flags;
+
+  tcb_cache_poison(tcb, nxsched_tcb_size(ttype));
+
+  flags = spin_lock_irqsave(&g_tcb_cache_lock);
+  if (cache->nfree < CONFIG_SCHED_TCB_CACHE_NTCBS)
+    {
+      sq_addfirst((FAR sq_entry_t *)tcb, &cache->free);
+      cache->nfree++;
+      tcb = NULL;
+    }
+
+  spin_unlock_irqrestore(&g_tcb_cache_lock, flags);
+
+  if (tcb != NULL)
+    {
+      kmm_free(tcb);
+    }
+}
+
+#ifdef HAVE_STACK_CACHE
+/****************************************************************************
+ * Name: tcb_cache_put_stack
+ *
+ * Description:
+ *   Put the stack of a thread that is not running in the cache, or free
+ *   it if the cache is full.
+ *
+ ****************************************************************************/
+
+static void tcb_cache_put_stack(FAR void *mem, size_t size)
+{
+  FAR struct tcb_cache_stack_s *stack = mem;
+  irqstate_t flags;
+
+  tcb_cache_poison(stack + 1, size - sizeof(*stack));
+  stack->size = size;
+
+  flags = spin_lock_irqsave(&g_tcb_cache_lock);
+  if (g_stack_cache_nfree < CONFIG_SCHED_TCB_CACHE_NSTACKS)
+    {
+      sq_addfirst(&stack->entry, &g_stack_cache);
+      g_stack_cache_nfree++;
+      stack = NULL;
+    }
+
+  spin_unlock_irqrestore(&g_tcb_cache_lock, flags);
+
+  if (stack != NULL)
+    {
+      kumm_free(stack);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: tcb_cache_flush
+ *
+ * Description:
+ *   Cache the TCB and stack deferred on this CPU by an exiting thread.
+ *   Nothing is done while a thread exits on this CPU:  the deferred blocks
+ *   are its own.  Otherwise the caller is another thread, so the exiting
+ *   one has been switched out.
+ *
+ ****************************************************************************/
+
+static void tcb_cache_flush(void)
+{
+  FAR struct tcb_cache_deferred_s *deferred;
+  FAR struct tcb_s *tcb;
+  uint8_t ttype;
+#ifdef HAVE_STACK_CACHE
+  FAR void *stack;
+  size_t size;
+#endif
+  irqstate_t flags;
+
+  flags    = spin_lock_irqsave(&g_tcb_cache_lock);
+  deferred = &g_tcb_cache_deferred[this_cpu()];
+  if (deferred->exiting != NULL)
+    {
+      spin_unlock_irqrestore(&g_tcb_cache_lock, flags);
+      return;
+    }
+
+  tcb           = deferred->tcb;
+  ttype         = deferred->ttype;
+  deferred->tcb = NULL;
+#ifdef HAVE_STACK_CACHE
+  stack           = deferred->stack;
+  size            = deferred->size;
+  deferred->stack = NULL;
+#endif
+
+  spin_unlock_irqrestore(&g_tcb_cache_lock, flags);
+
+  if (tcb != NULL)
+    {
+      tcb_cache_put(tcb, ttype);
+    }
+
+#ifdef HAVE_STACK_CACHE
+  if (stack != NULL)
+    {
+      tcb_cache_put_stack(stack, size);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_alloc_tcb
+ *
+ * Description:
+ *   Allocate a zeroed TCB of the size of a thread type, recycling the TCB
+ *   of a thread that exited if there is one.
+ *
+ * Input Parameters:
+ *   ttype - The thread type, which selects the TCB structure
+ *
+ * Returned Value:
+ *   The TCB or NULL if it could not be allocated.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *nxsched_alloc_tcb(uint8_t ttype)
+{
+  FAR struct tcb_cache_s *cache;
+  FAR struct tcb_s *tcb;
+  size_t size = nxsched_tcb_size(ttype);
+  irqstate_t flags;
+
+  if (ttype == TCB_FLAG_TTYPE_KERNEL)
+    {
+      return kmm_zalloc(size);
+    }
+
+  tcb_cache_flush();
+
+  cache = &g_tcb_cache[ttype];
+  flags = spin_lock_irqsave(&g_tcb_cache_lock);
+  tcb   = (FAR struct tcb_s *)sq_remfirst(&cache->free);
+  if (tcb != NULL)
+    {
+      cache->nfree--;
+    }
+
+  spin_unlock_irqrestore(&g_tcb_cache_lock, flags);
+
+  if (tcb == NULL)
+    {
+      return kmm_zalloc(size);
+    }
+
+  tcb_cache_check((FAR sq_entry_t *)tcb + 1, size - sizeof(sq_entry_t));
+  memset(tcb, 0, size);
+  return tcb;
+}
+
+/****************************************************************************
+ * Name: nxsched_free_tcb
+ *
+ * Description:
+ *   Release a TCB allocated by nxsched_alloc_tcb() to the cache.
+ *
+ * Input Parameters:
+ *   tcb   - The TCB to release
+ *   ttype - The thread type given to nxsched_alloc_tcb()
+ *
+ ****************************************************************************/
+
+void nxsched_free_tcb(FAR struct tcb_s *tcb, uint8_t ttype)
+{
+  irqstate_t flags;
+
+  if (ttype == TCB_FLAG_TTYPE_KERNEL)
+    {
+      kmm_free(tcb);
+      return;
+    }
+
+  tcb_cache_flush();
+
+  flags = spin_lock_irqsave(&g_tcb_cache_lock);
+  if (tcb == g_tcb_cache_deferred[this_cpu()].exiting)
+    {
+      g_tcb_cache_deferred[this_cpu()].tcb   = tcb;
+      g_tcb_cache_deferred[this_cpu()].ttype = ttype;
+      tcb = NULL;
+    }
+
+  spin_unlock_irqrestore(&g_tcb_cache_lock, flags);
+
+  if (tcb != NULL)
+    {
+      tcb_cache_put(tcb, ttype);
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_create_stack
+ *
+ * Description:
+ *   Allocate the stack of a thread as up_create_stack() does, recycling a
+ *   cached stack within 1/8 of the requested size if there is one.
+ *
+ * Input Parameters:
+ *   tcb        - The TCB of the new thread
+ *   stack_size - The requested stack size
+ *   ttype      - The thread type
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxsched_create_stack(FAR struct tcb_s *tcb, size_t stack_size,
+                         uint8_t ttype)
+{
+#ifdef HAVE_STACK_CACHE
+  FAR struct tcb_cache_stack_s *stack = NULL;
+  FAR sq_entry_t *entry;
+  irqstate_t flags;
+  size_t size;
+
+  if (ttype != TCB_FLAG_TTYPE_KERNEL)
+    {
+      tcb_cache_flush();
+
+      flags = spin_lock_irqsave(&g_tcb_cache_lock);
+      for (entry = sq_peek(&g_stack_cache); entry; entry = sq_next(entry))
+        {
+          size = ((FAR struct tcb_cache_stack_s *)entry)->size;
+          if (size >= stack_size && size - stack_size <= stack_size / 8)
+            {
+              stack = (FAR struct tcb_cache_stack_s *)entry;
+              sq_rem(entry, &g_stack_cache);
+              g_stack_cache_nfree--;
+              break;
+            }
+        }
+
+      spin_unlock_irqrestore(&g_tcb_cache_lock, flags);
+    }
+
+  if (stack != NULL)
+    {
+      size = stack->size;
+      tcb_cache_check(stack + 1, size - sizeof(*stack));
+
+      if (up_use_stack(tcb, stack, size) == OK)
+        {
+          tcb->flags |= TCB_FLAG_FREE_STACK;
+          return OK;
+        }
+
+      kumm_free(stack);
+    }
+#endif
+
+  return up_create_stack(tcb, stack_size, ttype);
+}
+
+/****************************************************************************
+ * Name: nxsched_release_stack
+ *
+ * Description:
+ *   Release the stack of a thread as up_release_stack() does, keeping the
+ *   stack memory in the cache if there is room.
+ *
+ * Input Parameters:
+ *   tcb   - The TCB of the thread
+ *   ttype - The thread type
+ *
+ ****************************************************************************/
+
+void nxsched_release_stack(FAR struct tcb_s *tcb, uint8_t ttype)
+{
+#ifdef HAVE_STACK_CACHE
+  FAR void *stack = tcb->stack_alloc_ptr;
+  irqstate_t flags;
+  size_t size;
+
+  if (ttype != TCB_FLAG_TTYPE_KERNEL && stack != NULL &&
+      (tcb->flags & TCB_FLAG_FREE_STACK) != 0)
+    {
+      size = (uintptr_t)tcb->stack_base_ptr - (uintptr_t)stack +
+             tcb->adj_stack_size;
+
+      tcb_cache_flush();
+
+      flags = spin_lock_irqsave(&g_tcb_cache_lock);
+      if (tcb == g_tcb_cache_deferred[this_cpu()].exiting)
+        {
+          g_tcb_cache_deferred[this_cpu()].stack = stack;
+          g_tcb_cache_deferred[this_cpu()].size  = size;
+          stack = NULL;
+        }
+
+      spin_unlock_irqrestore(&g_tcb_cache_lock, flags);
+
+      if (stack != NULL)
+        {
+          tcb_cache_put_stack(stack, size);
+        }
+
+      /* The memory is owned by the cache now, let the architecture only
+       * forget about the stack.
+       */
+
+      tcb->flags &= ~TCB_FLAG_FREE_STACK;
+    }
+#endif
+
+  up_release_stack(tcb, ttype);
+}
+
+/****************************************************************************
+ * Name: nxsched_exiting_tcb
+ *
+ * Description:
+ *   Name the thread exiting on this CPU, or NULL when it has released its
+ *   resources.  Its TCB and stack are not cached before the next context
+ *   switch, they are deferred to the next call made by another thread.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the exiting thread, or NULL
+ *
+ ****************************************************************************/
+
+void nxsched_exiting_tcb(FAR struct tcb_s *tcb)
+{
+  irqstate_t flags;
+
+  /* The blocks still deferred belong to a thread that exited before on
+   * this CPU, and has been switched out since.
+   */
+
+  if (tcb != NULL)
+    {
+      tcb_cache_flush();
+    }
+
+  flags = spin_lock_irqsave(&g_tcb_cache_lock);
+  g_tcb_cache_deferred[this_cpu()].exiting = tcb;
+  spin_unlock_irqrestore(&g_tcb_cache_lock, flags);
+}
+
+#endif /* CONFIG_SCHED_TCB_CACHE */
@@ -56,6 +56,16 @@ int sched_yield(void)
   FAR struct tcb_s *rtcb = this_task();
   int ret;
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* A deadline thread yields until its next period */
+
+  if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      ret = nxsched_yield_deadline(rtcb);
+      return ret < 0 ? ERROR : OK;
+    }
+#endif
+
   /* This equivalent to just resetting the task priority to its current value
    * since this will cause the task to be rescheduled behind any other tasks
    * at the same priority.
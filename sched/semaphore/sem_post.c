@@ -252,22 +252,14 @@ int nxsem_post(FAR sem_t *sem)
 {
   DEBUGASSERT(sem != NULL);
 
-  /* If this is a mutex, we can try to unlock the mutex in fast mode,
-   * else try to get it in slow mode.
+  /* If no thread waits on a semaphore that has no holder to track, we can
+   * give the count back in fast mode, else post it in slow mode.
    */
 
-#if !defined(CONFIG_PRIORITY_INHERITANCE) && !defined(CONFIG_PRIORITY_PROTECT)
-  if (sem->flags & SEM_TYPE_MUTEX)
+  if (NXSEM_IS_FAST(sem) && nxsem_post_fast(sem))
     {
-      short old = 0;
-      if (atomic_compare_exchange_weak_explicit(NXSEM_COUNT(sem), &old, 1,
-                                                memory_order_release,
-                                                memory_order_relaxed))
-        {
-          return OK;
-        }
+      return OK;
     }
-#endif
 
   return nxsem_post_slow(sem);
 }
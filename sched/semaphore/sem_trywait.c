@@ -146,24 +146,14 @@ int nxsem_trywait(FAR sem_t *sem)
   DEBUGASSERT(!OSINIT_IDLELOOP() || !sched_idletask() ||
               up_interrupt_context());
 
-  /* If this is a mutex, we can try to get the mutex in fast mode,
-   * else try to get it in slow mode.
+  /* If the semaphore has no holder to track, we can try to get it in fast
+   * mode, else try to get it in slow mode.
    */
 
-#if !defined(CONFIG_PRIORITY_INHERITANCE) && !defined(CONFIG_PRIORITY_PROTECT)
-  if (sem->flags & SEM_TYPE_MUTEX)
+  if (NXSEM_IS_FAST(sem))
     {
-      short old = 1;
-      if (atomic_compare_exchange_weak_explicit(NXSEM_COUNT(sem), &old, 0,
-                                                memory_order_acquire,
-                                                memory_order_relaxed))
-        {
-          return OK;
-        }
-
-      return -EAGAIN;
+      return nxsem_trywait_fast(sem) ? OK : -EAGAIN;
     }
-#endif
 
   return nxsem_trywait_slow(sem);
 }
@@ -33,6 +33,7 @@
 #include <nuttx/sched.h>
 #include <nuttx/atomic.h>
 
+#include <limits.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -42,6 +43,79 @@
 
 #define NXSEM_COUNT(s) ((FAR atomic_short *)&(s)->semcount)
 
+/* A semaphore without priority inheritance or protection has no holder to
+ * track:  while no thread waits on it, its count may be taken and given
+ * back with an atomic operation, without the critical section.
+ */
+
+#if defined(CONFIG_PRIORITY_INHERITANCE) || defined(CONFIG_PRIORITY_PROTECT)
+#  define NXSEM_IS_FAST(s) (((s)->flags & SEM_PRIO_MASK) == SEM_PRIO_NONE)
+#else
+#  define NXSEM_IS_FAST(s) true
+#endif
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_trywait_fast
+ *
+ * Description:
+ *   Take a count of the semaphore if one is available.
+ *
+ * Returned Value:
+ *   true if a count was taken, false if the slow path must be used.
+ *
+ ****************************************************************************/
+
+static inline_function bool nxsem_trywait_fast(FAR sem_t *sem)
+{
+  short old = atomic_load(NXSEM_COUNT(sem));
+
+  while (old > 0)
+    {
+      if (atomic_compare_exchange_weak_explicit(NXSEM_COUNT(sem), &old,
+                                                old - 1,
+                                                memory_order_acquire,
+                                                memory_order_relaxed))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: nxsem_post_fast
+ *
+ * Description:
+ *   Give a count back to the semaphore if no thread waits on it.
+ *
+ * Returned Value:
+ *   true if the count was given back, false if the slow path must be used.
+ *
+ ****************************************************************************/
+
+static inline_function bool nxsem_post_fast(FAR sem_t *sem)
+{
+  short old = atomic_load(NXSEM_COUNT(sem));
+
+  while (old >= 0 && old < SEM_VALUE_MAX)
+    {
+      if (atomic_compare_exchange_weak_explicit(NXSEM_COUNT(sem), &old,
+                                                old + 1,
+                                                memory_order_release,
+                                                memory_order_relaxed))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
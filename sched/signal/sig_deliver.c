@@ -62,6 +62,12 @@ void nxsig_deliver(FAR struct tcb_s *stcb)
   int saved_errno = get_errno();
   int16_t saved_errcode = stcb->errcode;
 
+  /* The waitobj may hold a message handed over by mq_send() that the task
+   * did not take yet, the signal handlers may block on other objects.
+   */
+
+  FAR void *saved_waitobj = stcb->waitobj;
+
   FAR sigq_t *sigq;
   sigset_t    savesigprocmask;
   sigset_t    newsigprocmask;
@@ -100,6 +106,7 @@ void nxsig_deliver(FAR struct tcb_s *stcb)
       /* Indicate that a signal is being delivered */
 
       stcb->flags |= TCB_FLAG_SIGNAL_ACTION;
+      stcb->waitobj = NULL;
 
       sinfo("Deliver signal %d to PID %d\n",
             sigq->info.si_signo, stcb->pid);
@@ -213,4 +220,5 @@ void nxsig_deliver(FAR struct tcb_s *stcb)
 
   set_errno(saved_errno);
   stcb->errcode = saved_errcode;
+  stcb->waitobj = saved_waitobj;
 }
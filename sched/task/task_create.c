@@ -84,8 +84,7 @@ int nxthread_create(FAR const char *name, uint8_t ttype, int priority,
 
   /* Allocate a TCB for the new task. */
 
-  tcb = kmm_zalloc(ttype == TCB_FLAG_TTYPE_KERNEL ?
-                   sizeof(struct tcb_s) : sizeof(struct task_tcb_s));
+  tcb = nxsched_alloc_tcb(ttype);
   if (!tcb)
     {
       serr("ERROR: Failed to allocate TCB\n");
@@ -102,7 +101,7 @@ int nxthread_create(FAR const char *name, uint8_t ttype, int priority,
                     stack_addr, stack_size, entry, argv, envp, NULL);
   if (ret < OK)
     {
-      kmm_free(tcb);
+      nxsched_free_tcb(tcb, ttype);
       return ret;
     }
 
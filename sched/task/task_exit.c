@@ -144,7 +144,14 @@ int nxtask_exit(void)
 
   dtcb->task_state = TSTATE_TASK_INACTIVE;
   sched_note_stop(dtcb);
+
+  /* dtcb still runs on its TCB and stack until up_exit() switches to
+   * rtcb:  tell the TCB cache not to recycle them yet.
+   */
+
+  nxsched_exiting_tcb(dtcb);
   ret = nxsched_release_tcb(dtcb, dtcb->flags & TCB_FLAG_TTYPE_MASK);
+  nxsched_exiting_tcb(NULL);
 
 #ifdef CONFIG_SMP
   rtcb->irqcount--;
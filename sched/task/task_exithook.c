@@ -37,6 +37,10 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/mm/mm.h>
 
+#ifdef CONFIG_SCHED_PERF_EVENTS
+#  include <nuttx/perf.h>
+#endif
+
 #include "sched/sched.h"
 #include "group/group.h"
 #include "signal/signal.h"
@@ -444,6 +448,12 @@ void nxtask_exithook(FAR struct tcb_s *tcb, int status)
 
   sched_unlock();
 
+#ifdef CONFIG_SCHED_PERF_EVENTS
+  /* Detach the perf events bound to the task */
+
+  perf_event_task_exit(tcb);
+#endif
+
   /* Leave the task group.  Perhaps discarding any un-reaped child
    * status (no zombies here!)
    */
@@ -137,7 +137,7 @@ FAR struct task_tcb_s *nxtask_setup_fork(start_t retaddr)
 
   /* Allocate a TCB for the child task. */
 
-  child = kmm_zalloc(sizeof(struct task_tcb_s));
+  child = (FAR struct task_tcb_s *)nxsched_alloc_tcb(TCB_FLAG_TTYPE_TASK);
   if (!child)
     {
       serr("ERROR: Failed to allocate TCB\n");
@@ -198,7 +198,7 @@ FAR struct task_tcb_s *nxtask_setup_fork(start_t retaddr)
   stack_size = (uintptr_t)ptcb->stack_base_ptr -
                (uintptr_t)ptcb->stack_alloc_ptr + ptcb->adj_stack_size;
 
-  ret = up_create_stack(&child->cmn, stack_size, ttype);
+  ret = nxsched_create_stack(&child->cmn, stack_size, ttype);
   if (ret < OK)
     {
       goto errout_with_tcb;
@@ -92,7 +92,7 @@ static int nxtask_spawn_create(FAR const char *name, int priority,
 
   /* Allocate a TCB for the new task. */
 
-  tcb = kmm_zalloc(sizeof(struct task_tcb_s));
+  tcb = (FAR struct task_tcb_s *)nxsched_alloc_tcb(TCB_FLAG_TTYPE_TASK);
   if (tcb == NULL)
     {
       serr("ERROR: Failed to allocate TCB\n");
@@ -109,7 +109,7 @@ static int nxtask_spawn_create(FAR const char *name, int priority,
                     entry, argv, envp, actions);
   if (ret < OK)
     {
-      kmm_free(tcb);
+      nxsched_free_tcb((FAR struct tcb_s *)tcb, TCB_FLAG_TTYPE_TASK);
       return ret;
     }
 
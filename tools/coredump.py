@@ -30,6 +30,8 @@ import sys
 
 import lzf
 
+LZ4_FRAME_MAGIC = b"\x04\x22\x4d\x18"
+
 
 def decompress(lzffile, outfile):
     chunk_number = 1
@@ -58,6 +60,20 @@ def decompress(lzffile, outfile):
         chunk_number += 1
 
 
+def decompress_lz4(lz4file, outfile):
+    import lz4.frame
+
+    data = lz4file.read()
+
+    # A frame ends at each flush of the stream, the next output starts a
+    # new one
+
+    while data[:4] == LZ4_FRAME_MAGIC:
+        chunk, nread = lz4.frame.decompress(data, return_bytes_read=True)
+        outfile.write(chunk)
+        data = data[nread:]
+
+
 def unhexlify(infile, outfile):
     for line in infile.readlines():
         line = line.strip()
@@ -124,12 +140,15 @@ def main():
 
     tmpfile.seek(0, 0)
 
-    lzfhdr = tmpfile.read(2)
+    lzfhdr = tmpfile.read(4)
 
-    if lzfhdr == b"ZV":
+    if lzfhdr[:2] == b"ZV" or lzfhdr == LZ4_FRAME_MAGIC:
         outfile = open(args.output, "wb")
         tmpfile.seek(0, 0)
-        decompress(tmpfile, outfile)
+        if lzfhdr == LZ4_FRAME_MAGIC:
+            decompress_lz4(tmpfile, outfile)
+        else:
+            decompress(tmpfile, outfile)
         tmpfile.close()
         outfile.close()
         os.unlink(tmp)
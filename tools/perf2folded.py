@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+############################################################################
+# tools/perf2folded.py
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+############################################################################
+
+import argparse
+import bisect
+import collections
+import struct
+import subprocess
+import sys
+
+PERF_RECORD_SAMPLE = 9
+
+PERF_SAMPLE_IP = 1 << 0
+PERF_SAMPLE_TID = 1 << 1
+PERF_SAMPLE_CALLCHAIN = 1 << 5
+PERF_SAMPLE_ID = 1 << 6
+
+
+def parse_args():
+
+    parser = argparse.ArgumentParser(
+        description="""
+        Convert the perf event samples dumped from the ring buffer of a
+        sampling event (the raw PERF_RECORD_SAMPLE records) to the folded
+        stacks read by flamegraph.pl, one line per distinct stack:
+        "thread;outer;...;inner count".
+        """
+    )
+
+    parser.add_argument("dump", help="binary dump of the sample records")
+    parser.add_argument("elf", help="the nuttx ELF file, for the symbols")
+    parser.add_argument(
+        "-t",
+        "--sample-type",
+        type=lambda x: int(x, 0),
+        default=PERF_SAMPLE_IP | PERF_SAMPLE_TID | PERF_SAMPLE_CALLCHAIN,
+        help="the sample_type of the event (default: IP|TID|CALLCHAIN)",
+    )
+    parser.add_argument(
+        "-n",
+        "--nm",
+        default="nm",
+        help="the nm of the toolchain, e.g. arm-none-eabi-nm",
+    )
+    parser.add_argument(
+        "-b",
+        "--big-endian",
+        action="store_true",
+        help="the target is big endian",
+    )
+    parser.add_argument(
+        "-p",
+        "--no-pid",
+        action="store_true",
+        help="do not start the stacks with the thread id",
+    )
+
+    return parser.parse_args()
+
+
+class Symbols:
+    def __init__(self, nm, elf):
+        output = subprocess.check_output(
+            [nm, "-n", "-C", "--defined-only", elf], universal_newlines=True
+        )
+
+        self.addrs = []
+        self.names = []
+        for line in output.splitlines():
+            fields = line.split(None, 2)
+            if len(fields) == 3 and fields[1] in "tTwW":
+                self.addrs.append(int(fields[0], 16))
+                self.names.append(fields[2])
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.addrs, addr) - 1
+        if i < 0:
+            return "0x%x" % addr
+        return self.names[i]
+
+
+def parse_samples(data, sample_type, endian):
+
+    offset = 0
+    while offset + 8 <= len(data):
+        rtype, misc, size = struct.unpack_from(endian + "IHH", data, offset)
+        if size < 8:
+            break
+
+        record = offset + 8
+        offset += size
+        if rtype != PERF_RECORD_SAMPLE:
+            continue
+
+        ip = None
+        tid = None
+        chain = []
+
+        if sample_type & PERF_SAMPLE_IP:
+            (ip,) = struct.unpack_from(endian + "Q", data, record)
+            record += 8
+
+        if sample_type & PERF_SAMPLE_TID:
+            pid, tid = struct.unpack_from(endian + "ii", data, record)
+            record += 8
+
+        if sample_type & PERF_SAMPLE_ID:
+            record += 8
+
+        if sample_type & PERF_SAMPLE_CALLCHAIN:
+            (nr,) = struct.unpack_from(endian + "Q", data, record)
+            chain = struct.unpack_from(endian + "%dQ" % nr, data, record + 8)
+            chain = list(chain)
+
+        yield ip, tid, chain
+
+
+def fold(ip, chain, symbols):
+
+    # The call chain starts in the sampler, drop its frames up to the
+    # interrupted PC.  The return addresses are looked up one byte before,
+    # in the calling instruction.
+
+    if ip is not None and ip in chain:
+        chain = chain[chain.index(ip) + 1 :]
+
+    frames = []
+    if ip is not None:
+        frames.append(symbols.lookup(ip))
+
+    frames += [symbols.lookup(addr - 1) for addr in chain]
+    frames.reverse()
+    return frames
+
+
+if __name__ == "__main__":
+    args = parse_args()
+    endian = ">" if args.big_endian else "<"
+    symbols = Symbols(args.nm, args.elf)
+
+    with open(args.dump, "rb") as fl:
+        data = fl.read()
+
+    stacks = collections.Counter()
+    for ip, tid, chain in parse_samples(data, args.sample_type, endian):
+        frames = fold(ip, chain, symbols)
+        if tid is not None and not args.no_pid:
+            frames.insert(0, str(tid))
+        stacks[";".join(frames)] += 1
+
+    for stack, count in sorted(stacks.items()):
+        sys.stdout.write("%s %d\n" % (stack, count))
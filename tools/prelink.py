@@ -0,0 +1,245 @@
+#!/usr/bin/env python3
+############################################################################
+# tools/prelink.py
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+############################################################################
+
+import argparse
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+
+SHF_WRITE = 0x1
+SHF_ALLOC = 0x2
+
+# The read-only sections, run in place, and the writable sections, copied
+# to the data area.  The constructors are writable as in gnu-elf.ld.
+
+TEXT_SECTIONS = [
+    (".text", "*(.text .text.* .gnu.warning .stub .glue_7 .glue_7t)"),
+    (".rodata", "*(.rodata .rodata.*)"),
+    (".ARM.extab", "*(.ARM.extab*)"),
+    (".ARM.exidx", "*(.ARM.exidx*)"),
+]
+
+DATA_SECTIONS = [
+    (
+        ".init_array",
+        "KEEP(*(SORT_BY_INIT_PRIORITY(.init_array.*) "
+        "SORT_BY_INIT_PRIORITY(.ctors.*))) KEEP(*(.init_array .ctors))",
+    ),
+    (
+        ".fini_array",
+        "KEEP(*(SORT_BY_INIT_PRIORITY(.fini_array.*) "
+        "SORT_BY_INIT_PRIORITY(.dtors.*))) KEEP(*(.fini_array .dtors))",
+    ),
+    (".data", "*(.data .data.* .gnu.linkonce.d.*)"),
+    (".got", "*(.got .got.*)"),
+    (".bss", "*(.bss .bss.* .gnu.linkonce.b.* COMMON)"),
+]
+
+
+def parse_args():
+
+    parser = argparse.ArgumentParser(
+        description="""
+        Prelink an ELF program (the relocatable object built for the
+        ELF loader) to run in place with CONFIG_MODLIB_PRELINKED:  its
+        read-only sections are linked at the address they will be mapped
+        at, the flash address of the file in the romfs image plus their
+        offset in the file, and its writable sections at a fixed address
+        in the data area reserved for prelinked programs.  The symbols of
+        the kernel are resolved against the nuttx ELF file.
+        """
+    )
+
+    parser.add_argument("input", help="the relocatable ELF program")
+    parser.add_argument("output", help="the prelinked ELF program")
+    parser.add_argument(
+        "-n", "--nuttx", required=True, help="the nuttx ELF file, for the symbols"
+    )
+    parser.add_argument(
+        "-x",
+        "--xipbase",
+        required=True,
+        type=lambda x: int(x, 0),
+        help="the address the file is mapped at (FIOC_XIPBASE)",
+    )
+    parser.add_argument(
+        "-d",
+        "--database",
+        required=True,
+        type=lambda x: int(x, 0),
+        help="the address of the data, in CONFIG_MODLIB_PRELINKED_RAMSTART/SIZE",
+    )
+    parser.add_argument(
+        "-e", "--entry", default="main", help="the entry point (default: main)"
+    )
+    parser.add_argument(
+        "-l",
+        "--ld",
+        default="ld",
+        help="the ld of the toolchain, e.g. arm-none-eabi-ld",
+    )
+    parser.add_argument(
+        "-i",
+        "--iterations",
+        type=int,
+        default=8,
+        help="the maximum number of links to converge (default: 8)",
+    )
+
+    return parser.parse_args()
+
+
+def read_sections(path):
+
+    with open(path, "rb") as fl:
+        data = fl.read()
+
+    if data[:4] != b"\x7fELF":
+        raise ValueError("%s: not an ELF file" % path)
+
+    is64 = data[4] == 2
+    endian = "<" if data[5] == 1 else ">"
+
+    if is64:
+        shoff, = struct.unpack_from(endian + "Q", data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", data, 0x3A)
+        shfmt = endian + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(endian + "I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", data, 0x2E)
+        shfmt = endian + "IIIIIIIIII"
+
+    shdrs = [
+        struct.unpack_from(shfmt, data, shoff + i * shentsize) for i in range(shnum)
+    ]
+
+    strtab = shdrs[shstrndx]
+    strings = data[strtab[4] : strtab[4] + strtab[5]]
+
+    sections = {}
+    for name, stype, flags, addr, offset, size, _, _, _, _ in shdrs:
+        end = strings.index(b"\0", name)
+        sections[strings[name:end].decode()] = (stype, flags, addr, offset, size)
+
+    return sections
+
+
+def write_script(path, textaddrs, database):
+
+    lines = ["SECTIONS", "{"]
+
+    # The other read-only sections (e.g. .eh_frame) are placed by name once
+    # the first link has shown where they are.
+
+    rules = dict(TEXT_SECTIONS)
+    names = [name for name, _ in TEXT_SECTIONS]
+    names += [name for name in textaddrs if name not in rules]
+
+    for name in names:
+        rule = rules.get(name, "KEEP(*(%s))" % name)
+        if name in textaddrs:
+            lines.append("  %s 0x%x : { %s }" % (name, textaddrs[name], rule))
+        else:
+            lines.append("  %s : { %s }" % (name, rule))
+
+    lines.append("  . = 0x%x;" % database)
+    for name, rule in DATA_SECTIONS:
+        lines.append("  %s : { %s }" % (name, rule))
+
+    lines.append("  /DISCARD/ : { *(.note.GNU-stack) *(.comment) }")
+    lines.append("}")
+
+    with open(path, "w") as fl:
+        fl.write("\n".join(lines) + "\n")
+
+
+def link(args, script):
+
+    # -n: no page alignment, the sections follow each other in the file
+
+    subprocess.check_call(
+        [
+            args.ld,
+            "-n",
+            "--no-check-sections",
+            "-e",
+            args.entry,
+            "--just-symbols=%s" % args.nuttx,
+            "-T",
+            script,
+            "-o",
+            args.output,
+            args.input,
+        ]
+    )
+
+
+def prelink(args):
+
+    # Link, then move each read-only section to the mapped address of its
+    # offset in the file, .text first.  Moving a section may change the padding between
+    # the sections, link again until the offsets do not move.
+
+    textaddrs = {TEXT_SECTIONS[0][0]: args.xipbase}
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        script = os.path.join(tmpdir, "prelink.ld")
+
+        for _ in range(args.iterations):
+            write_script(script, textaddrs, args.database)
+            link(args, script)
+
+            sections = read_sections(args.output)
+            converged = True
+
+            for name, (stype, flags, addr, offset, size) in sections.items():
+                if flags & (SHF_ALLOC | SHF_WRITE) != SHF_ALLOC or size == 0:
+                    continue
+
+                if addr != args.xipbase + offset:
+                    textaddrs[name] = args.xipbase + offset
+                    converged = False
+
+            if converged:
+                return sections
+
+    raise ValueError("%s: the section offsets do not converge" % args.input)
+
+
+if __name__ == "__main__":
+    args = parse_args()
+
+    try:
+        sections = prelink(args)
+    except (ValueError, subprocess.CalledProcessError) as e:
+        sys.stderr.write("prelink: %s\n" % e)
+        sys.exit(1)
+
+    for name, (stype, flags, addr, offset, size) in sorted(
+        sections.items(), key=lambda x: x[1][2]
+    ):
+        if flags & SHF_ALLOC and size > 0:
+            kind = "data" if flags & SHF_WRITE else "text"
+            sys.stdout.write("%-12s %s 0x%08x 0x%x\n" % (name, kind, addr, size))